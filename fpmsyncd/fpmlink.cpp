@@ -15,7 +15,8 @@ FpmLink::FpmLink(int port) :
     m_messageBuffer(NULL),
     m_pos(0),
     m_connected(false),
-    m_server_up(false)
+    m_server_up(false),
+    m_routeHandler(NULL)
 {
     struct sockaddr_in addr;
     int true_val = 1;
@@ -117,7 +118,17 @@ void FpmLink::readData()
 
         if (hdr->msg_type == FPM_MSG_TYPE_NETLINK)
         {
-            nl_msg *msg = nlmsg_convert((nlmsghdr *)fpm_msg_data(hdr));
+            nlmsghdr *nl_hdr = (nlmsghdr *)fpm_msg_data(hdr);
+
+            /* Fast path: parse route straight out of the message buffer */
+            if (m_routeHandler && parseRouteMsg(nl_hdr, m_route))
+            {
+                m_routeHandler->onRouteRecord(m_route);
+                start += msg_len;
+                continue;
+            }
+
+            nl_msg *msg = nlmsg_convert(nl_hdr);
             if (msg == NULL)
                 throw system_error(make_error_code(errc::bad_message), "Unable to convert nlmsg");
 
@@ -13,6 +13,7 @@
 
 #include "selectable.h"
 #include "fpm/fpm.h"
+#include "fpmsyncd/routeparser.h"
 
 namespace swss {
 
@@ -25,6 +26,15 @@ public:
     /* Wait for connection (blocking) */
     void accept();
 
+    /*
+     * Route messages are parsed in place and handed to 'handler', skipping
+     * libnl. Messages the parser doesn't handle still go through NetDispatcher.
+     */
+    void setRouteHandler(RouteRecordHandler *handler)
+    {
+        m_routeHandler = handler;
+    }
+
     int getFd() override;
     void readData() override;
     /* readMe throws FpmConnectionClosedException when connection is lost */
@@ -41,6 +51,9 @@ private:
     bool m_server_up;
     int m_server_socket;
     int m_connection_socket;
+
+    RouteRecordHandler *m_routeHandler;
+    RouteRecord m_route;
 };
 
 }
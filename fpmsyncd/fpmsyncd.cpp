@@ -1,8 +1,10 @@
 #include <iostream>
+#include <signal.h>
 #include "logger.h"
 #include "select.h"
 #include "selectabletimer.h"
 #include "netdispatcher.h"
+#include "netlink.h"
 #include "warmRestartHelper.h"
 #include "fpmsyncd/fpmlink.h"
 #include "fpmsyncd/routesync.h"
@@ -22,18 +24,25 @@ const uint32_t DEFAULT_ROUTING_RESTART_INTERVAL = 120;
 int main(int argc, char **argv)
 {
     swss::Logger::linkToDbNative("fpmsyncd");
+
+    /* A route ring whose consumer went away is detected through EPIPE */
+    signal(SIGPIPE, SIG_IGN);
+
     DBConnector db(APPL_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
     RedisPipeline pipeline(&db);
     RouteSync sync(&pipeline);
 
     NetDispatcher::getInstance().registerMessageHandler(RTM_NEWROUTE, &sync);
     NetDispatcher::getInstance().registerMessageHandler(RTM_DELROUTE, &sync);
+    NetDispatcher::getInstance().registerMessageHandler(RTM_NEWLINK, &sync.m_ifNameCache);
+    NetDispatcher::getInstance().registerMessageHandler(RTM_DELLINK, &sync.m_ifNameCache);
 
     while (true)
     {
         try
         {
             FpmLink fpm;
+            NetLink netlink;
             Select s;
             SelectableTimer warmStartTimer(timespec{0, 0});
 
@@ -47,8 +56,15 @@ int main(int argc, char **argv)
             fpm.accept();
             cout << "Connected!" << endl;
 
+            fpm.setRouteHandler(&sync);
+
             s.addSelectable(&fpm);
 
+            /* Seed and keep updating the interface name cache */
+            netlink.registerGroup(RTNLGRP_LINK);
+            netlink.dumpRequest(RTM_GETLINK);
+            s.addSelectable(&netlink);
+
             /* If warm-restart feature is enabled, execute 'restoration' logic */
             bool warmStartEnabled = sync.m_warmStartHelper.checkAndStart();
             if (warmStartEnabled)
@@ -97,6 +113,9 @@ int main(int argc, char **argv)
                 {
                     pipeline.flush();
                     SWSS_LOG_DEBUG("Pipeline flushed");
+
+                    sync.notifyRouteRing();
+                    sync.checkRouteRing();
                 }
             }
         }
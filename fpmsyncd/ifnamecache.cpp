@@ -0,0 +1,104 @@
+#include <string.h>
+#include <netlink/route/link.h>
+#include "logger.h"
+#include "fpmsyncd/ifnamecache.h"
+
+using namespace std;
+using namespace swss;
+
+IfNameCache::IfNameCache()
+{
+    m_nl_sock = nl_socket_alloc();
+    nl_connect(m_nl_sock, NETLINK_ROUTE);
+}
+
+IfNameCache::~IfNameCache()
+{
+    nl_socket_free(m_nl_sock);
+}
+
+void IfNameCache::onMsg(int nlmsg_type, struct nl_object *obj)
+{
+    struct rtnl_link *link = (struct rtnl_link *)obj;
+    int if_index = rtnl_link_get_ifindex(link);
+
+    if (nlmsg_type == RTM_NEWLINK)
+    {
+        const char *if_name = rtnl_link_get_name(link);
+        if (if_name)
+        {
+            setIfName(if_index, if_name);
+        }
+    }
+    else if (nlmsg_type == RTM_DELLINK)
+    {
+        resetIfName(if_index);
+    }
+}
+
+bool IfNameCache::getIfName(int if_index, char *if_name, size_t name_len)
+{
+    if (!if_name || name_len == 0 || if_index <= 0)
+    {
+        return false;
+    }
+
+    /* Cannot get interface name. Possibly the interface was just created. */
+    if ((size_t)if_index >= m_names.size() || m_names[if_index][0] == '\0')
+    {
+        return queryIfName(if_index, if_name, name_len);
+    }
+
+    strncpy(if_name, m_names[if_index].data(), name_len - 1);
+    if_name[name_len - 1] = '\0';
+
+    return true;
+}
+
+void IfNameCache::setIfName(int if_index, const char *if_name)
+{
+    if (if_index <= 0 || if_index >= MAX_CACHED_IFINDEX)
+    {
+        return;
+    }
+
+    if ((size_t)if_index >= m_names.size())
+    {
+        m_names.resize(if_index + 1, IfName{});
+    }
+
+    strncpy(m_names[if_index].data(), if_name, IFNAMSIZ - 1);
+    m_names[if_index][IFNAMSIZ - 1] = '\0';
+}
+
+void IfNameCache::resetIfName(int if_index)
+{
+    if (if_index > 0 && (size_t)if_index < m_names.size())
+    {
+        m_names[if_index][0] = '\0';
+    }
+}
+
+/* Fetch a single link from the kernel and cache its name */
+bool IfNameCache::queryIfName(int if_index, char *if_name, size_t name_len)
+{
+    struct rtnl_link *link = NULL;
+
+    if (rtnl_link_get_kernel(m_nl_sock, if_index, NULL, &link) < 0 || !link)
+    {
+        SWSS_LOG_INFO("Unable to get link for ifindex %d", if_index);
+        return false;
+    }
+
+    const char *name = rtnl_link_get_name(link);
+    if (name)
+    {
+        setIfName(if_index, name);
+
+        strncpy(if_name, name, name_len - 1);
+        if_name[name_len - 1] = '\0';
+    }
+    rtnl_link_put(link);
+
+    return name != NULL;
+}
@@ -0,0 +1,54 @@
+#ifndef __IFNAMECACHE__
+#define __IFNAMECACHE__
+
+#include <net/if.h>
+#include <array>
+#include <vector>
+#include "netmsg.h"
+
+namespace swss {
+
+/*
+ * Interface/VRF index to name table, kept up to date from RTM_NEWLINK and
+ * RTM_DELLINK notifications. Names are stored in a flat vector indexed by
+ * ifindex, so a lookup is a bounds check plus an array access.
+ *
+ * On a miss (e.g. a route referring to a link whose notification hasn't been
+ * processed yet) only that single link is queried from the kernel, never the
+ * whole link table.
+ */
+class IfNameCache : public NetMsg
+{
+public:
+    /* Indexes beyond this are resolved through the kernel, never cached */
+    enum { MAX_CACHED_IFINDEX = 1 << 20 };
+
+    IfNameCache();
+    virtual ~IfNameCache();
+
+    virtual void onMsg(int nlmsg_type, struct nl_object *obj);
+
+    /*
+     * Get interface/VRF name based on interface/VRF index
+     * @arg if_index          Interface/VRF index
+     * @arg if_name           String to store interface name
+     * @arg name_len          Length of destination string, including terminating zero byte
+     *
+     * Return true if we successfully gets the interface/VRF name.
+     */
+    bool getIfName(int if_index, char *if_name, size_t name_len);
+
+private:
+    typedef std::array<char, IFNAMSIZ> IfName;
+
+    void setIfName(int if_index, const char *if_name);
+    void resetIfName(int if_index);
+    bool queryIfName(int if_index, char *if_name, size_t name_len);
+
+    std::vector<IfName> m_names;
+    struct nl_sock     *m_nl_sock;
+};
+
+}
+
+#endif
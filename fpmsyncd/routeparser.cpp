@@ -0,0 +1,191 @@
+#include <string.h>
+#include <stdio.h>
+#include "fpmsyncd/routeparser.h"
+
+using namespace swss;
+
+/*
+ * Format an address the same way nl_addr2str() does: plain address for
+ * full-length prefixes, "address/len" otherwise.
+ */
+static bool formatAddr(uint8_t family, const void *addr, int prefixLen,
+                       char *buf, size_t len)
+{
+    if (!inet_ntop(family, addr, buf, (socklen_t)len))
+    {
+        return false;
+    }
+
+    int maxLen = (family == AF_INET) ? 32 : 128;
+
+    if (prefixLen >= 0 && prefixLen != maxLen)
+    {
+        size_t used = strlen(buf);
+        snprintf(buf + used, len - used, "/%d", prefixLen);
+    }
+
+    return true;
+}
+
+static bool parseGateway(uint8_t family, const struct rtattr *rta, char *buf, size_t len)
+{
+    size_t addrLen = (family == AF_INET) ? 4 : 16;
+
+    if (RTA_PAYLOAD(rta) != addrLen)
+    {
+        return false;
+    }
+
+    return formatAddr(family, RTA_DATA(rta), -1, buf, len);
+}
+
+/* Parse the nexthops carried in an RTA_MULTIPATH attribute */
+static bool parseMultipath(const struct rtattr *mp, RouteRecord &route)
+{
+    struct rtnexthop *rtnh = (struct rtnexthop *)RTA_DATA(mp);
+    int left = (int)RTA_PAYLOAD(mp);
+
+    while (RTNH_OK(rtnh, left))
+    {
+        route.nexthops.emplace_back();
+        RouteRecord::NextHop &nh = route.nexthops.back();
+
+        nh.gateway[0] = '\0';
+        nh.ifindex = (uint32_t)rtnh->rtnh_ifindex;
+
+        struct rtattr *rta = RTNH_DATA(rtnh);
+        int attrLen = rtnh->rtnh_len - (int)RTNH_LENGTH(0);
+
+        for (; RTA_OK(rta, attrLen); rta = RTA_NEXT(rta, attrLen))
+        {
+            if (rta->rta_type == RTA_GATEWAY &&
+                !parseGateway(route.family, rta, nh.gateway, sizeof(nh.gateway)))
+            {
+                return false;
+            }
+        }
+
+        left -= RTNH_ALIGN(rtnh->rtnh_len);
+        rtnh = RTNH_NEXT(rtnh);
+    }
+
+    return true;
+}
+
+bool swss::parseRouteMsg(const struct nlmsghdr *hdr, RouteRecord &route)
+{
+    if (hdr->nlmsg_type != RTM_NEWROUTE && hdr->nlmsg_type != RTM_DELROUTE)
+    {
+        return false;
+    }
+
+    if (hdr->nlmsg_len < NLMSG_LENGTH(sizeof(struct rtmsg)))
+    {
+        return false;
+    }
+
+    const struct rtmsg *rtm = (const struct rtmsg *)NLMSG_DATA(hdr);
+
+    if (rtm->rtm_family != AF_INET && rtm->rtm_family != AF_INET6)
+    {
+        return false;
+    }
+
+    /* Default routes are left to libnl, which owns their textual notation */
+    if (rtm->rtm_dst_len == 0)
+    {
+        return false;
+    }
+
+    route.clear();
+    route.msgType = hdr->nlmsg_type;
+    route.family  = rtm->rtm_family;
+    route.type    = rtm->rtm_type;
+    route.table   = rtm->rtm_table;
+
+    const struct rtattr *dst = NULL;
+    const struct rtattr *gateway = NULL;
+    const struct rtattr *multipath = NULL;
+    bool hasOif = false;
+    uint32_t oif = 0;
+
+    const struct rtattr *rta = (const struct rtattr *)
+        ((const char *)rtm + NLMSG_ALIGN(sizeof(struct rtmsg)));
+    int len = (int)RTM_PAYLOAD(hdr);
+
+    for (; RTA_OK(rta, len); rta = RTA_NEXT(rta, len))
+    {
+        switch (rta->rta_type)
+        {
+            case RTA_DST:
+                dst = rta;
+                break;
+
+            case RTA_GATEWAY:
+                gateway = rta;
+                break;
+
+            case RTA_OIF:
+                if (RTA_PAYLOAD(rta) != sizeof(uint32_t))
+                {
+                    return false;
+                }
+                oif = *(const uint32_t *)RTA_DATA(rta);
+                hasOif = true;
+                break;
+
+            case RTA_TABLE:
+                if (RTA_PAYLOAD(rta) != sizeof(uint32_t))
+                {
+                    return false;
+                }
+                route.table = *(const uint32_t *)RTA_DATA(rta);
+                break;
+
+            case RTA_MULTIPATH:
+                multipath = rta;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (!dst || RTA_PAYLOAD(dst) != ((route.family == AF_INET) ? 4u : 16u))
+    {
+        return false;
+    }
+
+    if (!formatAddr(route.family, RTA_DATA(dst), rtm->rtm_dst_len,
+                    route.dst, sizeof(route.dst)))
+    {
+        return false;
+    }
+
+    /* libnl merges single-path attributes into multipath ones, leave that to it */
+    if (multipath && (gateway || hasOif))
+    {
+        return false;
+    }
+
+    if (multipath)
+    {
+        return parseMultipath(multipath, route);
+    }
+
+    if (gateway || hasOif)
+    {
+        route.nexthops.emplace_back();
+        RouteRecord::NextHop &nh = route.nexthops.back();
+
+        nh.gateway[0] = '\0';
+        nh.ifindex = oif;
+
+        if (gateway && !parseGateway(route.family, gateway, nh.gateway, sizeof(nh.gateway)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,67 @@
+#ifndef __ROUTEPARSER__
+#define __ROUTEPARSER__
+
+#include <arpa/inet.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <stdint.h>
+#include <vector>
+
+namespace swss {
+
+/*
+ * Flat, reusable representation of an rtnetlink route message.
+ *
+ * Addresses are kept already formatted (in the same notation nl_addr2str()
+ * produces) in fixed-size buffers, so once the nexthop vector has grown to
+ * its working size, filling a record doesn't allocate.
+ */
+struct RouteRecord
+{
+    enum { MAX_ADDR_SIZE = 64 };
+
+    struct NextHop
+    {
+        char     gateway[INET6_ADDRSTRLEN]; // empty if nexthop has no gateway
+        uint32_t ifindex;
+    };
+
+    int      msgType;                 // RTM_NEWROUTE or RTM_DELROUTE
+    uint8_t  family;                  // AF_INET or AF_INET6
+    uint8_t  type;                    // RTN_* route type
+    uint32_t table;                   // routing table (RTA_TABLE or rtm_table)
+    char     dst[MAX_ADDR_SIZE + 1];  // destination prefix
+
+    std::vector<NextHop> nexthops;
+
+    void clear()
+    {
+        msgType = 0;
+        family  = 0;
+        type    = 0;
+        table   = 0;
+        dst[0]  = '\0';
+        nexthops.clear();
+    }
+};
+
+class RouteRecordHandler
+{
+public:
+    virtual ~RouteRecordHandler() {}
+
+    virtual void onRouteRecord(const RouteRecord &route) = 0;
+};
+
+/*
+ * Parse a route message straight from its netlink buffer into 'route'.
+ *
+ * Returns false, leaving it to the caller to fall back on libnl, for anything
+ * other than plain IPv4/IPv6 RTM_NEWROUTE/RTM_DELROUTE messages, for default
+ * routes, and for messages whose layout this parser does not fully handle.
+ */
+bool parseRouteMsg(const struct nlmsghdr *hdr, RouteRecord &route);
+
+}
+
+#endif
@@ -0,0 +1,122 @@
+#include "logger.h"
+#include "fpmsyncd/routepersist.h"
+
+using namespace std;
+using namespace swss;
+
+RoutePersister::RoutePersister(DBConnector *db, const string &tableName,
+                               size_t batchSize, chrono::milliseconds interval) :
+    m_db(db->newConnector(0)),
+    m_tableName(tableName),
+    m_batchSize(batchSize),
+    m_interval(interval)
+{
+    m_thread = thread(&RoutePersister::run, this);
+}
+
+RoutePersister::~RoutePersister()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void RoutePersister::set(const string &key, const vector<FieldValueTuple> &fvs)
+{
+    lock_guard<mutex> lock(m_mutex);
+    Update &update = m_updates[key];
+
+    update.del = false;
+    update.fvs = fvs;
+
+    if (m_updates.size() == m_batchSize)
+    {
+        m_wake.notify_one();
+    }
+}
+
+void RoutePersister::del(const string &key)
+{
+    lock_guard<mutex> lock(m_mutex);
+    Update &update = m_updates[key];
+
+    update.del = true;
+    update.fvs.clear();
+
+    if (m_updates.size() == m_batchSize)
+    {
+        m_wake.notify_one();
+    }
+}
+
+void RoutePersister::flush()
+{
+    unique_lock<mutex> lock(m_mutex);
+    uint64_t request = ++m_flushRequested;
+
+    m_wake.notify_one();
+    m_written.wait(lock, [&]() { return m_flushed >= request; });
+}
+
+void RoutePersister::run()
+{
+    RedisPipeline pipeline(m_db.get(), m_batchSize);
+    Table table(&pipeline, m_tableName, true);
+    unordered_map<string, Update> batch;
+
+    unique_lock<mutex> lock(m_mutex);
+
+    while (true)
+    {
+        m_wake.wait_for(lock, m_interval, [this]()
+        {
+            return m_stopping || m_flushRequested != m_flushed || m_updates.size() >= m_batchSize;
+        });
+
+        /* Updates handed over before the flush requests are all in this batch */
+        uint64_t requested = m_flushRequested;
+
+        if (!m_updates.empty())
+        {
+            batch.swap(m_updates);
+            lock.unlock();
+
+            try
+            {
+                for (const auto &it : batch)
+                {
+                    if (it.second.del)
+                    {
+                        table.del(it.first);
+                    }
+                    else
+                    {
+                        table.set(it.first, it.second.fvs);
+                    }
+                }
+                pipeline.flush();
+            }
+            catch (const exception &e)
+            {
+                SWSS_LOG_ERROR("Failed to persist %zu routes to %s: %s", batch.size(), m_tableName.c_str(), e.what());
+            }
+            batch.clear();
+
+            lock.lock();
+        }
+
+        if (m_flushed != requested)
+        {
+            m_flushed = requested;
+            m_written.notify_all();
+        }
+
+        if (m_stopping && m_updates.empty())
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef __ROUTEPERSIST__
+#define __ROUTEPERSIST__
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "dbconnector.h"
+#include "table.h"
+
+namespace swss {
+
+/*
+ * Writes the routes sent over the route ring to their APP_DB table, so they
+ * survive an orchagent restart, on its own thread and redis connection:
+ * persisting them stays off fpmsyncd's event loop and its pipeline flushes.
+ *
+ * Updates are coalesced by key, the latest one winning, and written in
+ * batches once 'batchSize' keys are pending or every 'interval'.
+ */
+class RoutePersister
+{
+public:
+    static const size_t DEFAULT_BATCH_SIZE = 8192;
+    static const int DEFAULT_INTERVAL_MSECS = 100;
+
+    RoutePersister(DBConnector *db, const std::string &tableName,
+                   size_t batchSize = DEFAULT_BATCH_SIZE,
+                   std::chrono::milliseconds interval = std::chrono::milliseconds(DEFAULT_INTERVAL_MSECS));
+    /* Writes whatever is still pending */
+    ~RoutePersister();
+
+    void set(const std::string &key, const std::vector<FieldValueTuple> &fvs);
+    void del(const std::string &key);
+
+    /* Wait until every update handed over so far is written */
+    void flush();
+
+private:
+    struct Update
+    {
+        bool del;
+        std::vector<FieldValueTuple> fvs;
+    };
+
+    std::unique_ptr<DBConnector> m_db;
+    std::string m_tableName;
+    size_t m_batchSize;
+    std::chrono::milliseconds m_interval;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;       // updates to write, or asked to
+    std::condition_variable m_written;
+    std::unordered_map<std::string, Update> m_updates;
+    uint64_t m_flushRequested = 0;
+    uint64_t m_flushed = 0;             // flush requests served so far
+    bool m_stopping = false;
+    std::thread m_thread;
+
+    void run();
+};
+
+}
+
+#endif
@@ -0,0 +1,482 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <chrono>
+#include <new>
+#include <system_error>
+#include "logger.h"
+#include "fpmsyncd/routering.h"
+
+using namespace std;
+using namespace swss;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "ring positions must be lock free to be shared");
+
+#define ROUTE_RING_MAGIC        0x524f55544552494eULL  // "ROUTERIN"
+/* Record length telling the reader to go back to the beginning of the ring */
+#define ROUTE_RING_WRAP         0xffffffffU
+
+static inline uint64_t align8(uint64_t len)
+{
+    return (len + 7) & ~(uint64_t)7;
+}
+
+static inline void putString(uint8_t *&p, const string &s)
+{
+    uint32_t len = (uint32_t)s.size();
+
+    memcpy(p, &len, sizeof(len));
+    memcpy(p + sizeof(len), s.data(), len);
+    p += sizeof(len) + len;
+}
+
+static inline bool getString(const uint8_t *&p, const uint8_t *end, string &s)
+{
+    uint32_t len;
+
+    if ((size_t)(end - p) < sizeof(len))
+    {
+        return false;
+    }
+    memcpy(&len, p, sizeof(len));
+    p += sizeof(len);
+
+    if ((size_t)(end - p) < len)
+    {
+        return false;
+    }
+    s.assign(reinterpret_cast<const char *>(p), len);
+    p += len;
+
+    return true;
+}
+
+/*
+ * Record layout, all lengths and counts being native 32 bits integers:
+ *   record length | key | op | number of fields | field | value | ...
+ * with each string prefixed by its length.
+ */
+size_t RouteRing::encodedSize(const string &key, const string &op,
+                              const vector<FieldValueTuple> &fvs)
+{
+    size_t size = 4 * sizeof(uint32_t) + key.size() + op.size();
+
+    for (const auto &fv : fvs)
+    {
+        size += 2 * sizeof(uint32_t) + fvField(fv).size() + fvValue(fv).size();
+    }
+
+    return size;
+}
+
+size_t RouteRing::encode(uint8_t *buf, size_t len, const string &key, const string &op,
+                         const vector<FieldValueTuple> &fvs)
+{
+    size_t size = encodedSize(key, op, fvs);
+    if (size > len)
+    {
+        return 0;
+    }
+
+    uint8_t *p = buf;
+    uint32_t u32 = (uint32_t)size;
+
+    memcpy(p, &u32, sizeof(u32));
+    p += sizeof(u32);
+    putString(p, key);
+    putString(p, op);
+
+    u32 = (uint32_t)fvs.size();
+    memcpy(p, &u32, sizeof(u32));
+    p += sizeof(u32);
+
+    for (const auto &fv : fvs)
+    {
+        putString(p, fvField(fv));
+        putString(p, fvValue(fv));
+    }
+
+    return size;
+}
+
+bool RouteRing::decode(const uint8_t *buf, size_t len, KeyOpFieldsValuesTuple &kco)
+{
+    const uint8_t *p = buf + sizeof(uint32_t);
+    const uint8_t *end = buf + len;
+    uint32_t count;
+
+    auto &fvs = kfvFieldsValues(kco);
+    fvs.clear();
+
+    if (!getString(p, end, kfvKey(kco)) || !getString(p, end, kfvOp(kco)) ||
+        (size_t)(end - p) < sizeof(count))
+    {
+        return false;
+    }
+    memcpy(&count, p, sizeof(count));
+    p += sizeof(count);
+
+    fvs.resize(count);
+    for (auto &fv : fvs)
+    {
+        if (!getString(p, end, fv.first) || !getString(p, end, fv.second))
+        {
+            return false;
+        }
+    }
+
+    return p == end;
+}
+
+RouteRing::RouteRing(const string &path) :
+    m_path(path),
+    m_fifoPath(path + ROUTE_RING_FIFO_SUFFIX)
+{
+}
+
+RouteRing::~RouteRing()
+{
+    unmap();
+}
+
+void RouteRing::map(int fd, size_t length)
+{
+    void *addr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        throw system_error(errno, system_category(), "Failed to map route ring " + m_path);
+    }
+
+    m_ringFd = fd;
+    m_header = static_cast<Header *>(addr);
+    m_length = length;
+}
+
+void RouteRing::unmap()
+{
+    if (m_header)
+    {
+        munmap(m_header, m_length);
+        m_header = nullptr;
+        m_length = 0;
+    }
+
+    if (m_ringFd != -1)
+    {
+        close(m_ringFd);
+        m_ringFd = -1;
+    }
+}
+
+RouteRingReader::RouteRingReader(const string &path, uint64_t size, int pri) :
+    RouteRing(path),
+    Selectable(pri)
+{
+    if (size < 4096 || (size & (size - 1)) != 0)
+    {
+        throw invalid_argument("Route ring size must be a power of two of at least 4096");
+    }
+
+    removeStale(path);
+
+    if (mkfifo(m_fifoPath.c_str(), 0600) != 0)
+    {
+        throw system_error(errno, system_category(), "Failed to create " + m_fifoPath);
+    }
+
+    m_fifoFd = open(m_fifoPath.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (m_fifoFd == -1)
+    {
+        throw system_error(errno, system_category(), "Failed to open " + m_fifoPath);
+    }
+    m_fifoWriteFd = open(m_fifoPath.c_str(), O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+    if (m_fifoWriteFd == -1)
+    {
+        throw system_error(errno, system_category(), "Failed to open " + m_fifoPath);
+    }
+
+    /* Build the ring aside, fpmsyncd must never attach to a partially initialized one */
+    string tmpPath = path + ".tmp";
+    unlink(tmpPath.c_str());
+
+    int fd = open(tmpPath.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd == -1)
+    {
+        throw system_error(errno, system_category(), "Failed to create " + tmpPath);
+    }
+
+    size_t length = sizeof(Header) + size;
+    if (ftruncate(fd, (off_t)length) != 0)
+    {
+        int err = errno;
+        close(fd);
+        unlink(tmpPath.c_str());
+        throw system_error(err, system_category(), "Failed to size " + tmpPath);
+    }
+
+    map(fd, length);
+
+    new (&m_header->head) atomic<uint64_t>(0);
+    new (&m_header->tail) atomic<uint64_t>(0);
+    m_header->size = size;
+    m_header->magic = ROUTE_RING_MAGIC;
+
+    if (rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        int err = errno;
+        unlink(tmpPath.c_str());
+        throw system_error(err, system_category(), "Failed to publish " + path);
+    }
+
+    SWSS_LOG_NOTICE("Created route ring %s of %lu bytes", path.c_str(), size);
+}
+
+RouteRingReader::~RouteRingReader()
+{
+    removeStale(m_path);
+
+    if (m_fifoFd != -1)
+    {
+        close(m_fifoFd);
+    }
+    if (m_fifoWriteFd != -1)
+    {
+        close(m_fifoWriteFd);
+    }
+}
+
+void RouteRingReader::removeStale(const string &path)
+{
+    unlink(path.c_str());
+    unlink((path + ROUTE_RING_FIFO_SUFFIX).c_str());
+}
+
+bool RouteRingReader::empty() const
+{
+    return m_header->tail.load(memory_order_relaxed) == m_header->head.load(memory_order_acquire);
+}
+
+void RouteRingReader::readData()
+{
+    char buf[512];
+
+    /* Doorbells are only wake ups, the updates themselves are in the ring */
+    while (read(m_fifoFd, buf, sizeof(buf)) > 0)
+    {
+    }
+}
+
+size_t RouteRingReader::pops(deque<KeyOpFieldsValuesTuple> &vkco, size_t count)
+{
+    uint64_t size = m_header->size;
+    uint64_t tail = m_header->tail.load(memory_order_relaxed);
+    uint64_t head = m_header->head.load(memory_order_acquire);
+    size_t popped = 0;
+
+    while (popped < count && tail != head)
+    {
+        uint64_t offset = tail & (size - 1);
+        uint32_t len;
+
+        memcpy(&len, data() + offset, sizeof(len));
+        if (len == ROUTE_RING_WRAP)
+        {
+            tail += size - offset;
+            continue;
+        }
+
+        vkco.emplace_back();
+        if (len < sizeof(len) || len > size - offset ||
+            !decode(data() + offset, len, vkco.back()))
+        {
+            /* Nothing after a corrupted record can be trusted */
+            SWSS_LOG_ERROR("Corrupted record at %lu in route ring, dropping %lu bytes",
+                           tail, head - tail);
+            vkco.pop_back();
+            tail = head;
+            break;
+        }
+
+        tail += align8(len);
+        popped++;
+    }
+
+    m_header->tail.store(tail, memory_order_release);
+
+    return popped;
+}
+
+RouteRingWriter::RouteRingWriter(const string &path) :
+    RouteRing(path)
+{
+}
+
+RouteRingWriter::~RouteRingWriter()
+{
+    detach();
+}
+
+bool RouteRingWriter::attach()
+{
+    if (attached())
+    {
+        return true;
+    }
+
+    int fd = open(m_path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size <= sizeof(Header))
+    {
+        close(fd);
+        return false;
+    }
+
+    map(fd, (size_t)st.st_size);
+
+    if (m_header->magic != ROUTE_RING_MAGIC || m_header->size != m_length - sizeof(Header))
+    {
+        SWSS_LOG_WARN("Ignoring invalid route ring %s", m_path.c_str());
+        unmap();
+        return false;
+    }
+
+    /* Fails with ENXIO if orchagent isn't there to read it */
+    m_fifoFd = open(m_fifoPath.c_str(), O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+    if (m_fifoFd == -1)
+    {
+        unmap();
+        return false;
+    }
+
+    m_consumerGone = false;
+    m_notifyPending = false;
+
+    SWSS_LOG_NOTICE("Attached to route ring %s", m_path.c_str());
+    return true;
+}
+
+void RouteRingWriter::detach()
+{
+    if (m_fifoFd != -1)
+    {
+        close(m_fifoFd);
+        m_fifoFd = -1;
+    }
+
+    unmap();
+}
+
+bool RouteRingWriter::isStale() const
+{
+    struct stat st;
+
+    if (m_consumerGone)
+    {
+        return true;
+    }
+
+    /* orchagent unlinks the ring when it goes away or creates a new one */
+    return fstat(m_ringFd, &st) != 0 || st.st_nlink == 0;
+}
+
+void RouteRingWriter::ring()
+{
+    char c = 0;
+
+    /* A full FIFO already holds wake ups enough */
+    if (write(m_fifoFd, &c, sizeof(c)) == -1 && errno == EPIPE)
+    {
+        m_consumerGone = true;
+    }
+}
+
+void RouteRingWriter::notify()
+{
+    if (m_notifyPending && attached())
+    {
+        ring();
+        m_notifyPending = false;
+    }
+}
+
+bool RouteRingWriter::waitForSpace(uint64_t head, uint64_t needed)
+{
+    auto start = chrono::steady_clock::now();
+    auto lastWarning = start;
+
+    while (m_header->size - (head - m_header->tail.load(memory_order_acquire)) < needed)
+    {
+        /* Make sure the consumer knows there is work, and is still around */
+        ring();
+        m_notifyPending = false;
+
+        if (isStale())
+        {
+            return false;
+        }
+
+        auto now = chrono::steady_clock::now();
+        if (now - lastWarning >= chrono::seconds(1))
+        {
+            SWSS_LOG_WARN("Route ring full for %ld ms",
+                          (long)chrono::duration_cast<chrono::milliseconds>(now - start).count());
+            lastWarning = now;
+        }
+
+        usleep(100);
+    }
+
+    return true;
+}
+
+bool RouteRingWriter::push(const string &key, const string &op,
+                           const vector<FieldValueTuple> &fvs)
+{
+    /* Staleness is otherwise only checked when the ring is full */
+    if (!attached() || m_consumerGone)
+    {
+        return false;
+    }
+
+    uint64_t size = m_header->size;
+    uint64_t head = m_header->head.load(memory_order_relaxed);
+    uint64_t offset = head & (size - 1);
+    uint64_t contiguous = size - offset;
+    uint64_t len = align8(encodedSize(key, op, fvs));
+
+    if (len > size / 2)
+    {
+        SWSS_LOG_ERROR("Route %s doesn't fit in route ring (%lu bytes)", key.c_str(), len);
+        return false;
+    }
+
+    /* Records never wrap, the end of the ring is skipped instead */
+    if (!waitForSpace(head, len <= contiguous ? len : contiguous + len))
+    {
+        SWSS_LOG_WARN("Route ring %s went stale", m_path.c_str());
+        return false;
+    }
+
+    if (len > contiguous)
+    {
+        uint32_t wrap = ROUTE_RING_WRAP;
+
+        memcpy(data() + offset, &wrap, sizeof(wrap));
+        head += contiguous;
+        offset = 0;
+    }
+
+    encode(data() + offset, len, key, op, fvs);
+    m_header->head.store(head + len, memory_order_release);
+    m_notifyPending = true;
+
+    return true;
+}
@@ -0,0 +1,138 @@
+#ifndef __ROUTERING__
+#define __ROUTERING__
+
+#include <atomic>
+#include <deque>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "selectable.h"
+#include "table.h"
+
+namespace swss {
+
+/*
+ * Single producer, single consumer ring carrying ROUTE_TABLE updates from
+ * fpmsyncd straight to orchagent, bypassing the APP_DB round trip.
+ *
+ * The ring lives in a file mapped by both processes. orchagent (the consumer)
+ * creates it, fpmsyncd (the producer) attaches to it when it finds one. The
+ * file sits next to the redis socket, since that directory is the one shared
+ * by the swss and bgp containers. A FIFO alongside it is used as a doorbell,
+ * so the consumer can wait on it in its select loop.
+ *
+ * Records are variable length, 8 bytes aligned, and never wrap: a record
+ * which doesn't fit before the end of the ring is preceded by a padding
+ * marker sending the reader back to its beginning.
+ */
+#define ROUTE_RING_PATH         "/var/run/redis/route_ring"
+#define ROUTE_RING_FIFO_SUFFIX  ".fifo"
+
+class RouteRing
+{
+public:
+    /* Size of the record area; must be a power of two */
+    static const uint64_t DEFAULT_SIZE = 32 << 20;
+
+    struct Header
+    {
+        uint64_t magic;
+        uint64_t size;
+        /* Positions only ever grow; offsets are positions modulo size */
+        alignas(64) std::atomic<uint64_t> head;   // written by the producer
+        alignas(64) std::atomic<uint64_t> tail;   // written by the consumer
+    };
+
+    /* Encode a route update at 'buf', returns its length or 0 if it doesn't fit */
+    static size_t encode(uint8_t *buf, size_t len, const std::string &key, const std::string &op,
+                         const std::vector<FieldValueTuple> &fvs);
+    /* Decode the record at 'buf', of 'len' bytes */
+    static bool decode(const uint8_t *buf, size_t len, KeyOpFieldsValuesTuple &kco);
+
+    static size_t encodedSize(const std::string &key, const std::string &op,
+                              const std::vector<FieldValueTuple> &fvs);
+
+protected:
+    RouteRing(const std::string &path);
+    virtual ~RouteRing();
+
+    void map(int fd, size_t length);
+    void unmap();
+
+    uint8_t *data() const { return reinterpret_cast<uint8_t *>(m_header) + sizeof(Header); }
+
+    std::string m_path;
+    std::string m_fifoPath;
+    Header     *m_header = nullptr;
+    size_t      m_length = 0;
+    int         m_ringFd = -1;
+};
+
+/* orchagent side: creates the ring and pops route updates from it */
+class RouteRingReader : public RouteRing, public Selectable
+{
+public:
+    RouteRingReader(const std::string &path = ROUTE_RING_PATH,
+                    uint64_t size = DEFAULT_SIZE, int pri = 0);
+    ~RouteRingReader();
+
+    /* Pop up to 'count' route updates, returns the number popped */
+    size_t pops(std::deque<KeyOpFieldsValuesTuple> &vkco, size_t count = SIZE_MAX);
+
+    bool empty() const;
+
+    int getFd() override { return m_fifoFd; }
+    void readData() override;
+    /* Keep being selected while updates are left in the ring */
+    bool hasCachedData() override { return !empty(); }
+
+    /* Remove any ring left by a previous run, for fpmsyncd not to attach to it */
+    static void removeStale(const std::string &path = ROUTE_RING_PATH);
+
+private:
+    int m_fifoFd = -1;
+    /* Write end held open, so the FIFO never reports EOF */
+    int m_fifoWriteFd = -1;
+};
+
+/* fpmsyncd side: attaches to the ring created by orchagent and pushes updates to it */
+class RouteRingWriter : public RouteRing
+{
+public:
+    RouteRingWriter(const std::string &path = ROUTE_RING_PATH);
+    ~RouteRingWriter();
+
+    /* Attach to the ring if orchagent created one, returns whether attached */
+    bool attach();
+    void detach();
+    bool attached() const { return m_header != nullptr; }
+
+    /*
+     * orchagent went away, or replaced the ring when it restarted. Updates
+     * pushed to this ring would never be read.
+     */
+    bool isStale() const;
+
+    /*
+     * Push one route update, waiting for the consumer to make room if the
+     * ring is full. Fails only once the ring went stale.
+     */
+    bool push(const std::string &key, const std::string &op,
+              const std::vector<FieldValueTuple> &fvs);
+
+    /* Wake the consumer up if anything was pushed since last time */
+    void notify();
+
+private:
+    bool waitForSpace(uint64_t head, uint64_t needed);
+    /* Ring the doorbell, noting whether the consumer is still there */
+    void ring();
+
+    int      m_fifoFd = -1;
+    bool     m_notifyPending = false;
+    bool     m_consumerGone = false;
+};
+
+}
+
+#endif
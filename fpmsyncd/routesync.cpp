@@ -7,6 +7,8 @@
 #include "ipprefix.h"
 #include "dbconnector.h"
 #include "producerstatetable.h"
+#include "redisreply.h"
+#include "rediscommand.h"
 #include "fpmsyncd/fpmlink.h"
 #include "fpmsyncd/routesync.h"
 #include <string.h>
@@ -16,17 +18,23 @@ using namespace swss;
 
 #define VXLAN_IF_NAME_PREFIX "brvxlan"
 
+/* How often to look for a route ring offered by orchagent */
+#define ROUTE_RING_CHECK_SECS 1
+
 RouteSync::RouteSync(RedisPipeline *pipeline) :
+    m_pipeline(pipeline),
     m_routeTable(pipeline, APP_ROUTE_TABLE_NAME, true),             
+    m_routePersister(pipeline->getDBConnector(), APP_ROUTE_TABLE_NAME),
     m_vnet_routeTable(pipeline, APP_VNET_RT_TABLE_NAME, true),
     m_vnet_tunnelTable(pipeline, APP_VNET_RT_TUNNEL_TABLE_NAME, true),
     m_warmStartHelper(pipeline, &m_routeTable, APP_ROUTE_TABLE_NAME, "bgp", "bgp")
 {
-    m_nl_sock = nl_socket_alloc();
-    nl_connect(m_nl_sock, NETLINK_ROUTE);
-    rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &m_link_cache);
 }
 
+/*
+ * Translate a libnl route object into a RouteRecord, so that routes parsed by
+ * libnl and by the FPM route parser share the same handling.
+ */
 void RouteSync::onMsg(int nlmsg_type, struct nl_object *obj)
 {
     struct rtnl_route *route_obj = (struct rtnl_route *)obj;
@@ -39,30 +47,54 @@ void RouteSync::onMsg(int nlmsg_type, struct nl_object *obj)
         return;
     }
 
-    /* Get the index of routing table */
-    unsigned int table_index = rtnl_route_get_table(route_obj);
-    
+    m_nlRoute.clear();
+    m_nlRoute.msgType = nlmsg_type;
+    m_nlRoute.family = (uint8_t)family;
+    m_nlRoute.type = rtnl_route_get_type(route_obj);
+    m_nlRoute.table = rtnl_route_get_table(route_obj);
+    nl_addr2str(rtnl_route_get_dst(route_obj), m_nlRoute.dst, MAX_ADDR_SIZE);
+
+    for (int i = 0; i < rtnl_route_get_nnexthops(route_obj); i++)
+    {
+        struct rtnl_nexthop *nexthop = rtnl_route_nexthop_n(route_obj, i);
+        struct nl_addr *addr = rtnl_route_nh_get_gateway(nexthop);
+
+        m_nlRoute.nexthops.emplace_back();
+        RouteRecord::NextHop &nh = m_nlRoute.nexthops.back();
+
+        nh.gateway[0] = '\0';
+        nh.ifindex = rtnl_route_nh_get_ifindex(nexthop);
+
+        /* Next hop gateway is not empty */
+        if (addr)
+        {
+            nl_addr2str(addr, nh.gateway, sizeof(nh.gateway));
+        }
+    }
+
+    onRouteRecord(m_nlRoute);
+}
+
+void RouteSync::onRouteRecord(const RouteRecord &route)
+{
     /* Default routing table. This line may have problems. */
-    if (table_index == RT_TABLE_UNSPEC) 
+    if (route.table == RT_TABLE_UNSPEC)
     {
-        onRouteMsg(nlmsg_type, obj);
+        onRouteMsg(route);
     } 
     /* VNET route. We will handle VRF routes in the future. */
     else 
     {
-        onVnetRouteMsg(nlmsg_type, obj);
+        onVnetRouteMsg(route);
     }
 }
 
 /* Handle regular route (without vnet) */
-void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj)
+void RouteSync::onRouteMsg(const RouteRecord &route)
 {
-    struct rtnl_route *route_obj = (struct rtnl_route *)obj;
-    struct nl_addr *dip;
-    char destipprefix[MAX_ADDR_SIZE + 1] = {0};
+    const char *destipprefix = route.dst;
+    int nlmsg_type = route.msgType;
 
-    dip = rtnl_route_get_dst(route_obj);
-    nl_addr2str(dip, destipprefix, MAX_ADDR_SIZE);
     SWSS_LOG_DEBUG("Receive new route message dest ip prefix: %s\n", destipprefix);
 
     /*
@@ -75,7 +107,7 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj)
     {
         if (!warmRestartInProgress)
         {
-            m_routeTable.del(destipprefix);
+            delRoute(destipprefix);
             return;
         }
         else
@@ -97,14 +129,14 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj)
         return;
     }
 
-    switch (rtnl_route_get_type(route_obj))
+    switch (route.type)
     {
         case RTN_BLACKHOLE:
         {
             vector<FieldValueTuple> fvVector;
             FieldValueTuple fv("blackhole", "true");
             fvVector.push_back(fv);
-            m_routeTable.set(destipprefix, fvVector);
+            setRoute(destipprefix, fvVector);
             return;
         }
         case RTN_UNICAST:
@@ -120,29 +152,27 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj)
             return;
     }
 
-    struct nl_list_head *nhs = rtnl_route_get_nexthops(route_obj);
-    if (!nhs)
+    if (route.nexthops.empty())
     {
         SWSS_LOG_INFO("Nexthop list is empty for %s\n", destipprefix);
         return;
     }
 
     /* Get nexthop lists */
-    string nexthops = getNextHopGw(route_obj);
-    string ifnames = getNextHopIf(route_obj);
+    getNextHopLists(route);
 
     vector<FieldValueTuple> fvVector;
-    FieldValueTuple nh("nexthop", nexthops);
-    FieldValueTuple idx("ifname", ifnames);
+    FieldValueTuple nh("nexthop", m_nexthops);
+    FieldValueTuple idx("ifname", m_ifnames);
 
     fvVector.push_back(nh);
     fvVector.push_back(idx);
 
     if (!warmRestartInProgress)
     {
-        m_routeTable.set(destipprefix, fvVector);
+        setRoute(destipprefix, fvVector);
         SWSS_LOG_DEBUG("RouteTable set msg: %s %s %s\n",
-                       destipprefix, nexthops.c_str(), ifnames.c_str());
+                       destipprefix, m_nexthops.c_str(), m_ifnames.c_str());
     }
 
     /*
@@ -152,7 +182,7 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj)
     else
     {
         SWSS_LOG_INFO("Warm-Restart mode: RouteTable set msg: %s %s %s\n",
-                      destipprefix, nexthops.c_str(), ifnames.c_str());
+                      destipprefix, m_nexthops.c_str(), m_ifnames.c_str());
 
         const KeyOpFieldsValuesTuple kfv = std::make_tuple(destipprefix,
                                                            SET_COMMAND,
@@ -161,29 +191,103 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj)
     }
 }
 
-/* Handle vnet route */      
-void RouteSync::onVnetRouteMsg(int nlmsg_type, struct nl_object *obj)
+void RouteSync::setRoute(const string &key, const vector<FieldValueTuple> &fvs)
 {
-    struct rtnl_route *route_obj = (struct rtnl_route *)obj;  
+    if (m_routeRing.attached())
+    {
+        if (m_routeRing.push(key, SET_COMMAND, fvs))
+        {
+            m_routePersister.set(key, fvs);
+            return;
+        }
+        detachRouteRing();
+    }
+
+    m_routeTable.set(key, fvs);
+}
+
+void RouteSync::delRoute(const string &key)
+{
+    if (m_routeRing.attached())
+    {
+        if (m_routeRing.push(key, DEL_COMMAND, vector<FieldValueTuple>()))
+        {
+            m_routePersister.del(key);
+            return;
+        }
+        detachRouteRing();
+    }
+
+    m_routeTable.del(key);
+}
+
+void RouteSync::detachRouteRing()
+{
+    /*
+     * orchagent is gone or restarted. Whatever the ring still held has been
+     * persisted, so it will be picked up from APP_DB with the rest, once
+     * written: it must be before any route is published, which orchagent
+     * could otherwise apply and then see overwritten by an older one.
+     */
+    SWSS_LOG_NOTICE("Route ring went stale, publishing routes to APP_DB");
+    m_routePersister.flush();
+    m_routeRing.detach();
+}
+
+void RouteSync::checkRouteRing()
+{
+    if (m_routeRing.attached())
+    {
+        if (m_routeRing.isStale())
+        {
+            detachRouteRing();
+        }
+        return;
+    }
 
-    /* Get the destination IP prefix */
-    struct nl_addr *dip = rtnl_route_get_dst(route_obj);
-    char destipprefix[MAX_ADDR_SIZE + 1] = {0};
-    nl_addr2str(dip, destipprefix, MAX_ADDR_SIZE);
+    time_t now = time(NULL);
+    if (now - m_lastRingCheck < ROUTE_RING_CHECK_SECS || m_warmStartHelper.inProgress())
+    {
+        return;
+    }
+    m_lastRingCheck = now;
+
+    if (!m_routeRing.attach())
+    {
+        return;
+    }
+
+    /*
+     * Routes still queued in APP_DB must reach orchagent before any update
+     * sent through the ring, which could otherwise overtake them.
+     */
+    RedisCommand scard;
+    scard.format("SCARD %s", m_routeTable.getKeySetName().c_str());
+    RedisReply r(m_pipeline->getDBConnector(), scard, REDIS_REPLY_INTEGER);
+    if (r.getContext()->integer != 0)
+    {
+        m_routeRing.detach();
+    }
+}
+
+/* Handle vnet route */      
+void RouteSync::onVnetRouteMsg(const RouteRecord &route)
+{
+    int nlmsg_type = route.msgType;
 
     /* Get VRF index and VRF name */
-    unsigned int vrf_index = rtnl_route_get_table(route_obj);
+    unsigned int vrf_index = route.table;
     char vrf_name[IFNAMSIZ] = {0};
 
     /* If we cannot get the VRF name */
-    if (!getIfName(vrf_index, vrf_name, IFNAMSIZ))
+    if (!m_ifNameCache.getIfName(vrf_index, vrf_name, IFNAMSIZ))
     {
         SWSS_LOG_INFO("Fail to get the VRF name (table ID %u)\n", vrf_index);
         return;         
     }
 
     /* vrf name = vnet name */
-    string vnet_dip =  vrf_name + string(":") + destipprefix;
+    string vnet_dip =  vrf_name + string(":") + route.dst;
     SWSS_LOG_DEBUG("Receive new vnet route message %s\n", vnet_dip.c_str());
 
     if (nlmsg_type == RTM_DELROUTE)
@@ -199,7 +303,7 @@ void RouteSync::onVnetRouteMsg(int nlmsg_type, struct nl_object *obj)
         return;
     }
 
-    switch (rtnl_route_get_type(route_obj))
+    switch (route.type)
     {
         case RTN_UNICAST:
             break;
@@ -219,147 +323,84 @@ void RouteSync::onVnetRouteMsg(int nlmsg_type, struct nl_object *obj)
             return;
     }
 
-    struct nl_list_head *nhs = rtnl_route_get_nexthops(route_obj);
-    if (!nhs)
+    if (route.nexthops.empty())
     {
         SWSS_LOG_INFO("Nexthop list is empty for %s\n", vnet_dip.c_str());
         return;
     }
 
     /* Get nexthop lists */
-    string nexthops = getNextHopGw(route_obj);
-    string ifnames = getNextHopIf(route_obj);
+    getNextHopLists(route);
 
     /* If the the first interface name starts with VXLAN_IF_NAME_PREFIX,
        the route is a VXLAN tunnel route. */
-    if (ifnames.find(VXLAN_IF_NAME_PREFIX) == 0)
+    if (m_ifnames.find(VXLAN_IF_NAME_PREFIX) == 0)
     {
         vector<FieldValueTuple> fvVector;
-        FieldValueTuple ep("endpoint", nexthops);
+        FieldValueTuple ep("endpoint", m_nexthops);
         fvVector.push_back(ep);
 
         m_vnet_tunnelTable.set(vnet_dip, fvVector);
         SWSS_LOG_DEBUG("%s set msg: %s %s\n", 
-                       APP_VNET_RT_TUNNEL_TABLE_NAME, vnet_dip.c_str(), nexthops.c_str());
+                       APP_VNET_RT_TUNNEL_TABLE_NAME, vnet_dip.c_str(), m_nexthops.c_str());
         return;
     }
     /* Regular VNET route */ 
     else 
     {
         vector<FieldValueTuple> fvVector;
-        FieldValueTuple idx("ifname", ifnames);
+        FieldValueTuple idx("ifname", m_ifnames);
         fvVector.push_back(idx);
 
         /* If the route has at least one next hop gateway, e.g., nexthops does not only have ',' */ 
-        if (nexthops.length() + 1 > (unsigned int)rtnl_route_get_nnexthops(route_obj)) 
+        if (m_nexthops.length() + 1 > route.nexthops.size())
         {
-            FieldValueTuple nh("nexthop", nexthops);
+            FieldValueTuple nh("nexthop", m_nexthops);
             fvVector.push_back(nh);        
             SWSS_LOG_DEBUG("%s set msg: %s %s %s\n", 
-                           APP_VNET_RT_TABLE_NAME, vnet_dip.c_str(), ifnames.c_str(), nexthops.c_str());
+                           APP_VNET_RT_TABLE_NAME, vnet_dip.c_str(), m_ifnames.c_str(), m_nexthops.c_str());
         } 
         else 
         {
             SWSS_LOG_DEBUG("%s set msg: %s %s\n", 
-                           APP_VNET_RT_TABLE_NAME, vnet_dip.c_str(), ifnames.c_str());
+                           APP_VNET_RT_TABLE_NAME, vnet_dip.c_str(), m_ifnames.c_str());
         }
 
         m_vnet_routeTable.set(vnet_dip, fvVector);
     }
 }
 
-/* 
- * Get interface/VRF name based on interface/VRF index 
- * @arg if_index          Interface/VRF index
- * @arg if_name           String to store interface name
- * @arg name_len          Length of destination string, including terminating zero byte
- * 
- * Return true if we successfully gets the interface/VRF name. 
- */ 
-bool RouteSync::getIfName(int if_index, char *if_name, size_t name_len)
-{
-    if (!if_name || name_len == 0) 
-    {
-        return false;
-    }
-
-    memset(if_name, 0, name_len);
-
-    /* Cannot get interface name. Possibly the interface gets re-created. */
-    if (!rtnl_link_i2name(m_link_cache, if_index, if_name, name_len))
-    {
-        rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &m_link_cache);
-        if (!rtnl_link_i2name(m_link_cache, if_index, if_name, name_len))
-        {
-            return false;
-        }
-    }
-
-    return true;    
-}
-
 /*
- * Get next hop gateway IP addresses
- * @arg route_obj     route object         
+ * Build next hop gateway IP addresses and interface names lists
+ * @arg route         route record
  *
- * Return concatenation of IP addresses: gw0 + "," + gw1 + .... + "," + gwN  
+ * Fills m_nexthops with gw0 + "," + gw1 + .... + "," + gwN and m_ifnames with
+ * if0 + "," + if1 + .... + "," + ifN. Both buffers are reused across routes.
  */
-string RouteSync::getNextHopGw(struct rtnl_route *route_obj)
+void RouteSync::getNextHopLists(const RouteRecord &route)
 {
-    string result = "";
+    m_nexthops.clear();
+    m_ifnames.clear();
 
-    for (int i = 0; i < rtnl_route_get_nnexthops(route_obj); i++)
+    for (size_t i = 0; i < route.nexthops.size(); i++)
     {
-        struct rtnl_nexthop *nexthop = rtnl_route_nexthop_n(route_obj, i);
-        struct nl_addr *addr = rtnl_route_nh_get_gateway(nexthop);
-
-        /* Next hop gateway is not empty */  
-        if (addr) 
-        {
-            char gw_ip[MAX_ADDR_SIZE + 1] = {0};
-            nl_addr2str(addr, gw_ip, MAX_ADDR_SIZE);
-            result += gw_ip;
-        }
+        const RouteRecord::NextHop &nexthop = route.nexthops[i];
+        char if_name[IFNAMSIZ] = "0";
 
-        if (i + 1 < rtnl_route_get_nnexthops(route_obj))
+        if (i > 0)
         {
-            result += string(",");
+            m_nexthops += ',';
+            m_ifnames += ',';
         }
-    }
-
-    return result;
-}
-
-/*
- * Get next hop interface names
- * @arg route_obj     route object         
- *
- * Return concatenation of interface names: if0 + "," + if1 + .... + "," + ifN  
- */
-string RouteSync::getNextHopIf(struct rtnl_route *route_obj)
-{
-    string result = "";
 
-    for (int i = 0; i < rtnl_route_get_nnexthops(route_obj); i++)
-    {   
-        struct rtnl_nexthop *nexthop = rtnl_route_nexthop_n(route_obj, i);
-        /* Get the ID of next hop interface */
-        unsigned if_index = rtnl_route_nh_get_ifindex(nexthop);
-        char if_name[IFNAMSIZ] = "0";
+        m_nexthops += nexthop.gateway;
 
         /* If we cannot get the interface name */
-        if (!getIfName(if_index, if_name, IFNAMSIZ))
+        if (!m_ifNameCache.getIfName(nexthop.ifindex, if_name, IFNAMSIZ))
         {
-            strcpy(if_name, "unknown");            
+            strcpy(if_name, "unknown");
         }
 
-        result += if_name;
-        
-        if (i + 1 < rtnl_route_get_nnexthops(route_obj))
-        {
-            result += string(",");
-        }
+        m_ifnames += if_name;
     }
-
-    return result;
 }
@@ -5,47 +5,75 @@
 #include "producerstatetable.h"
 #include "netmsg.h"
 #include "warmRestartHelper.h"
+#include "fpmsyncd/routeparser.h"
+#include "fpmsyncd/ifnamecache.h"
+#include "fpmsyncd/routering.h"
+#include "fpmsyncd/routepersist.h"
 #include <string.h>
 
 using namespace std;
 
 namespace swss {
 
-class RouteSync : public NetMsg
+class RouteSync : public NetMsg, public RouteRecordHandler
 {
 public:
-    enum { MAX_ADDR_SIZE = 64 };
+    enum { MAX_ADDR_SIZE = RouteRecord::MAX_ADDR_SIZE };
 
     RouteSync(RedisPipeline *pipeline);
 
+    /* libnl path, used for messages the FPM route parser doesn't handle */
     virtual void onMsg(int nlmsg_type, struct nl_object *obj);
 
+    virtual void onRouteRecord(const RouteRecord &route);
+
+    /*
+     * Switch regular routes over to the route ring once orchagent offers one,
+     * or back to APP_DB if it went away. To be called with the pipeline flushed.
+     */
+    void checkRouteRing();
+
+    /* Let orchagent know about the routes pushed to the ring */
+    void notifyRouteRing() { m_routeRing.notify(); }
+
     WarmStartHelper  m_warmStartHelper;
 
+    /* Interface/VRF names, fed by RTM_NEWLINK/RTM_DELLINK notifications */
+    IfNameCache      m_ifNameCache;
+
 private:
+    RedisPipeline      *m_pipeline;
     /* regular route table */
     ProducerStateTable  m_routeTable;
+    /*
+     * Regular routes go straight to orchagent through this ring when it's
+     * attached, while ROUTE_TABLE is only written for persistence, in the
+     * background.
+     */
+    RouteRingWriter     m_routeRing;
+    RoutePersister      m_routePersister;
+    time_t              m_lastRingCheck = 0;
     /* vnet route table */       
     ProducerStateTable  m_vnet_routeTable;
     /* vnet vxlan tunnel table */  
     ProducerStateTable  m_vnet_tunnelTable; 
-    struct nl_cache    *m_link_cache;
-    struct nl_sock     *m_nl_sock;
+    /* record reused to translate libnl route objects */
+    RouteRecord         m_nlRoute;
+    /* buffers reused to build nexthop/ifname lists */
+    string              m_nexthops;
+    string              m_ifnames;
 
     /* Handle regular route (without vnet) */
-    void onRouteMsg(int nlmsg_type, struct nl_object *obj);
-
-    /* Handle vnet route */      
-    void onVnetRouteMsg(int nlmsg_type, struct nl_object *obj);
-
-    /* Get interface/VRF name based on interface/VRF index */  
-    bool getIfName(int if_index, char *if_name, size_t name_len);
+    void onRouteMsg(const RouteRecord &route);
+    void setRoute(const string &key, const vector<FieldValueTuple> &fvs);
+    void delRoute(const string &key);
+    void detachRouteRing();
 
-    /* Get next hop gateway IP addresses */
-   string getNextHopGw(struct rtnl_route *route_obj);
+    /* Handle vnet route */
+    void onVnetRouteMsg(const RouteRecord &route);
 
-   /* Get next hop interfaces */
-   string getNextHopIf(struct rtnl_route *route_obj);
+    /* Build nexthop gateway IP address and interface name lists */
+    void getNextHopLists(const RouteRecord &route);
 };
 
 }
@@ -1,4 +1,5 @@
 #include <string>
+#include <string.h>
 #include <netinet/in.h>
 #include <netlink/route/link.h>
 #include <netlink/route/neighbour.h>
@@ -7,11 +8,13 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "ipaddress.h"
+#include "macaddress.h"
 #include "netmsg.h"
 #include "linkcache.h"
 
 #include "neighsync.h"
 #include "warm_restart.h"
+#include "warmRestartLoader.h"
 
 using namespace std;
 using namespace swss;
@@ -19,10 +22,95 @@ using namespace swss;
 NeighSync::NeighSync(RedisPipeline *pipelineAppDB, DBConnector *stateDb) :
     m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME),
     m_stateNeighRestoreTable(stateDb, STATE_NEIGH_RESTORE_TABLE_NAME),
-    m_AppRestartAssist(pipelineAppDB, "neighsyncd", "swss", &m_neighTable, DEFAULT_NEIGHSYNC_WARMSTART_TIMER)
+    m_AppRestartAssist(pipelineAppDB, "neighsyncd", "swss", &m_neighTable, DEFAULT_NEIGHSYNC_WARMSTART_TIMER),
+    m_pipeline(pipelineAppDB),
+    m_statsTable(stateDb, STATE_NEIGH_SYNC_STATS_TABLE_NAME),
+    m_lastStatsPublish(chrono::steady_clock::now())
 {
 }
 
+void NeighSync::loadNeighCache()
+{
+    // loader talks to redis directly, so nothing can be left in the pipeline
+    m_pipeline->flush();
+
+    AppTableLoader loader(m_pipeline->getDBConnector(), APP_NEIGH_TABLE_NAME,
+            m_neighTable.getTableNameSeparator());
+
+    m_neighCache.clear();
+    loader.load([this](const string &key, const vector<FieldValueTuple> &fvs)
+    {
+        string mac;
+        string family;
+
+        for (const auto &fv : fvs)
+        {
+            if (fvField(fv) == "neigh")
+            {
+                mac = fvValue(fv);
+            }
+            else if (fvField(fv) == "family")
+            {
+                family = fvValue(fv);
+            }
+        }
+
+        updateNeighCache(key, mac, family);
+    });
+
+    SWSS_LOG_NOTICE("Loaded %zu neighbors from APP_DB in %lu ms",
+            m_neighCache.size(), loader.getLoadTime());
+}
+
+bool NeighSync::updateNeighCache(const string &key, const string &mac, const string &family)
+{
+    NeighCacheEntry entry;
+
+    entry.valid = MacAddress::parseMacString(mac, entry.mac);
+    entry.ipv6 = family == IPV6_NAME;
+
+    auto it = m_neighCache.find(key);
+    if (it == m_neighCache.end())
+    {
+        m_neighCache.emplace(key, entry);
+        return true;
+    }
+
+    if (entry.valid && it->second.valid && entry.ipv6 == it->second.ipv6 &&
+        !memcmp(entry.mac, it->second.mac, sizeof(entry.mac)))
+    {
+        return false;
+    }
+
+    it->second = entry;
+    return true;
+}
+
+void NeighSync::countEvent(bool forwarded)
+{
+    if (forwarded)
+    {
+        m_forwarded++;
+    }
+    else
+    {
+        m_suppressed++;
+    }
+
+    if (chrono::steady_clock::now() - m_lastStatsPublish < chrono::seconds(NEIGH_SYNC_STATS_PUBLISH_SECS))
+    {
+        return;
+    }
+
+    vector<FieldValueTuple> fvs = {
+        { "forwarded",  to_string(m_forwarded) },
+        { "suppressed", to_string(m_suppressed) }
+    };
+
+    m_statsTable.set("neighsyncd", fvs);
+    m_lastStatsPublish = chrono::steady_clock::now();
+}
+
 // Check if neighbor table is restored in kernel
 bool NeighSync::isNeighRestoreDone()
 {
@@ -88,14 +176,41 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
     if (m_AppRestartAssist.isWarmStartInProgress())
     {
         m_AppRestartAssist.insertToMap(key, fvVector, delete_key);
+
+        /*
+         * Reconciliation leaves in APP_DB exactly the neighbors refreshed
+         * meanwhile, so the neighbor cache starts empty and follows them.
+         */
+        if (delete_key)
+        {
+            m_neighCache.erase(key);
+        }
+        else
+        {
+            updateNeighCache(key, macStr, family);
+        }
     }
     else
     {
+        /* Only write changes, kernel state refreshes keep the same MAC */
         if (delete_key == true)
         {
+            if (m_neighCache.erase(key) == 0)
+            {
+                countEvent(false);
+                return;
+            }
             m_neighTable.del(key);
+            countEvent(true);
+            return;
+        }
+
+        if (!updateNeighCache(key, macStr, family))
+        {
+            countEvent(false);
             return;
         }
         m_neighTable.set(key, fvVector);
+        countEvent(true);
     }
 }
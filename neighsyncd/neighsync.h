@@ -6,6 +6,10 @@
 #include "netmsg.h"
 #include "warmRestartAssist.h"
 
+#include <chrono>
+#include <unordered_map>
+#include <net/ethernet.h>
+
 // The timeout value (in seconds) for neighsyncd reconcilation logic
 #define DEFAULT_NEIGHSYNC_WARMSTART_TIMER 5
 
@@ -16,6 +20,10 @@
  */
 #define RESTORE_NEIGH_WAIT_TIME_OUT 120
 
+// STATE_DB table holding the counts of forwarded and suppressed neighbor events
+#define STATE_NEIGH_SYNC_STATS_TABLE_NAME "NEIGH_SYNC_STATS_TABLE"
+#define NEIGH_SYNC_STATS_PUBLISH_SECS 10
+
 namespace swss {
 
 class NeighSync : public NetMsg
@@ -34,10 +42,33 @@ public:
         return &m_AppRestartAssist;
     }
 
+    /* Seed the neighbor cache with the content of the APP_DB neighbor table */
+    void loadNeighCache();
+
 private:
+    /* MAC and family last written to APP_DB for a neighbor */
+    struct NeighCacheEntry
+    {
+        uint8_t mac[ETHER_ADDR_LEN];
+        bool    valid;      // false if the MAC couldn't be parsed, never matches
+        bool    ipv6;
+    };
+
     Table m_stateNeighRestoreTable;
     ProducerStateTable m_neighTable;
     AppRestartAssist m_AppRestartAssist;
+
+    RedisPipeline *m_pipeline;
+    std::unordered_map<std::string, NeighCacheEntry> m_neighCache;
+
+    Table m_statsTable;
+    uint64_t m_forwarded = 0;
+    uint64_t m_suppressed = 0;
+    std::chrono::steady_clock::time_point m_lastStatsPublish;
+
+    /* Record 'mac' and 'family' for 'key', return false if they were already there */
+    bool updateNeighCache(const std::string &key, const std::string &mac, const std::string &family);
+    void countEvent(bool forwarded);
 };
 
 }
@@ -60,6 +60,10 @@ int main(int argc, char **argv)
                 }
                 sync.getRestartAssist()->startReconcileTimer(s);
             }
+            else
+            {
+                sync.loadNeighCache();
+            }
 
             netlink.registerGroup(RTNLGRP_NEIGH);
             cout << "Listens to neigh messages..." << endl;
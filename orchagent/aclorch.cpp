@@ -1,6 +1,7 @@
 #include <limits.h>
 #include <unordered_map>
 #include <algorithm>
+#include <typeinfo>
 #include "aclorch.h"
 #include "logger.h"
 #include "schema.h"
@@ -30,31 +31,6 @@ extern sai_object_id_t   gSwitchId;
 extern PortsOrch*        gPortsOrch;
 extern CrmOrch *gCrmOrch;
 
-acl_rule_attr_lookup_t aclMatchLookup =
-{
-    { MATCH_IN_PORTS,          SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS },
-    { MATCH_OUT_PORTS,         SAI_ACL_ENTRY_ATTR_FIELD_OUT_PORTS },
-    { MATCH_SRC_IP,            SAI_ACL_ENTRY_ATTR_FIELD_SRC_IP },
-    { MATCH_DST_IP,            SAI_ACL_ENTRY_ATTR_FIELD_DST_IP },
-    { MATCH_SRC_IPV6,          SAI_ACL_ENTRY_ATTR_FIELD_SRC_IPV6 },
-    { MATCH_DST_IPV6,          SAI_ACL_ENTRY_ATTR_FIELD_DST_IPV6 },
-    { MATCH_L4_SRC_PORT,       SAI_ACL_ENTRY_ATTR_FIELD_L4_SRC_PORT },
-    { MATCH_L4_DST_PORT,       SAI_ACL_ENTRY_ATTR_FIELD_L4_DST_PORT },
-    { MATCH_ETHER_TYPE,        SAI_ACL_ENTRY_ATTR_FIELD_ETHER_TYPE },
-    { MATCH_IP_PROTOCOL,       SAI_ACL_ENTRY_ATTR_FIELD_IP_PROTOCOL },
-    { MATCH_TCP_FLAGS,         SAI_ACL_ENTRY_ATTR_FIELD_TCP_FLAGS },
-    { MATCH_IP_TYPE,           SAI_ACL_ENTRY_ATTR_FIELD_ACL_IP_TYPE },
-    { MATCH_DSCP,              SAI_ACL_ENTRY_ATTR_FIELD_DSCP },
-    { MATCH_TC,                SAI_ACL_ENTRY_ATTR_FIELD_TC },
-    { MATCH_L4_SRC_PORT_RANGE, (sai_acl_entry_attr_t)SAI_ACL_RANGE_TYPE_L4_SRC_PORT_RANGE },
-    { MATCH_L4_DST_PORT_RANGE, (sai_acl_entry_attr_t)SAI_ACL_RANGE_TYPE_L4_DST_PORT_RANGE },
-    { MATCH_TUNNEL_VNI,        SAI_ACL_ENTRY_ATTR_FIELD_TUNNEL_VNI },
-    { MATCH_INNER_ETHER_TYPE,  SAI_ACL_ENTRY_ATTR_FIELD_INNER_ETHER_TYPE },
-    { MATCH_INNER_IP_PROTOCOL, SAI_ACL_ENTRY_ATTR_FIELD_INNER_IP_PROTOCOL },
-    { MATCH_INNER_L4_SRC_PORT, SAI_ACL_ENTRY_ATTR_FIELD_INNER_L4_SRC_PORT },
-    { MATCH_INNER_L4_DST_PORT, SAI_ACL_ENTRY_ATTR_FIELD_INNER_L4_DST_PORT }
-};
-
 acl_rule_attr_lookup_t aclL3ActionLookup =
 {
     { PACKET_ACTION_FORWARD,                    SAI_ACL_ENTRY_ATTR_ACTION_PACKET_ACTION },
@@ -62,16 +38,6 @@ acl_rule_attr_lookup_t aclL3ActionLookup =
     { PACKET_ACTION_REDIRECT,                   SAI_ACL_ENTRY_ATTR_ACTION_REDIRECT }
 };
 
-acl_rule_attr_lookup_t aclDTelActionLookup =
-{
-    { ACTION_DTEL_FLOW_OP,                  SAI_ACL_ENTRY_ATTR_ACTION_ACL_DTEL_FLOW_OP },
-    { ACTION_DTEL_INT_SESSION,              SAI_ACL_ENTRY_ATTR_ACTION_DTEL_INT_SESSION },
-    { ACTION_DTEL_DROP_REPORT_ENABLE,       SAI_ACL_ENTRY_ATTR_ACTION_DTEL_DROP_REPORT_ENABLE },
-    { ACTION_DTEL_TAIL_DROP_REPORT_ENABLE,  SAI_ACL_ENTRY_ATTR_ACTION_DTEL_TAIL_DROP_REPORT_ENABLE },
-    { ACTION_DTEL_FLOW_SAMPLE_PERCENT,      SAI_ACL_ENTRY_ATTR_ACTION_DTEL_FLOW_SAMPLE_PERCENT },
-    { ACTION_DTEL_REPORT_ALL_PACKETS,       SAI_ACL_ENTRY_ATTR_ACTION_DTEL_REPORT_ALL_PACKETS }
-};
-
 acl_dtel_flow_op_type_lookup_t aclDTelFlowOpTypeLookup =
 {
     { DTEL_FLOW_OP_NOP,                SAI_ACL_DTEL_FLOW_OP_NOP },
@@ -96,32 +62,6 @@ static acl_stage_type_lookup_t aclStageLookUp =
     {TABLE_EGRESS,  ACL_STAGE_EGRESS }
 };
 
-static acl_ip_type_lookup_t aclIpTypeLookup =
-{
-    { IP_TYPE_ANY,         SAI_ACL_IP_TYPE_ANY },
-    { IP_TYPE_IP,          SAI_ACL_IP_TYPE_IP },
-    { IP_TYPE_NON_IP,      SAI_ACL_IP_TYPE_NON_IP },
-    { IP_TYPE_IPv4ANY,     SAI_ACL_IP_TYPE_IPV4ANY },
-    { IP_TYPE_NON_IPv4,    SAI_ACL_IP_TYPE_NON_IPV4 },
-    { IP_TYPE_IPv6ANY,     SAI_ACL_IP_TYPE_IPV6ANY },
-    { IP_TYPE_NON_IPv6,    SAI_ACL_IP_TYPE_NON_IPV6 },
-    { IP_TYPE_ARP,         SAI_ACL_IP_TYPE_ARP },
-    { IP_TYPE_ARP_REQUEST, SAI_ACL_IP_TYPE_ARP_REQUEST },
-    { IP_TYPE_ARP_REPLY,   SAI_ACL_IP_TYPE_ARP_REPLY }
-};
-
-inline string trim(const std::string& str, const std::string& whitespace = " \t")
-{
-    const auto strBegin = str.find_first_not_of(whitespace);
-    if (strBegin == std::string::npos)
-        return "";
-
-    const auto strEnd = str.find_last_not_of(whitespace);
-    const auto strRange = strEnd - strBegin + 1;
-
-    return str.substr(strBegin, strRange);
-}
-
 AclRule::AclRule(AclOrch *aclOrch, string rule, string table, acl_table_type_t type, bool createCounter) :
         m_pAclOrch(aclOrch),
         m_id(rule),
@@ -156,43 +96,35 @@ bool AclRule::validateAddPriority(string attr_name, string attr_value)
 }
 
 bool AclRule::validateAddMatch(string attr_name, string attr_value)
+{
+    const AclRuleAttr *match = findAclRuleAttr(attr_name);
+
+    if (!match || match->kind != ACL_RULE_ATTR_MATCH)
+    {
+        return false;
+    }
+
+    return validateAddMatch(*match, attr_value);
+}
+
+bool AclRule::validateAddMatch(const AclRuleAttr &match, const string &attr_value)
 {
     SWSS_LOG_ENTER();
 
     sai_attribute_value_t value;
+    /* Values are compared bytewise when a rule is modified */
+    memset(&value, 0, sizeof(value));
 
-    try
+    if (!isMatchSupported(match))
     {
-        if (aclMatchLookup.find(attr_name) == aclMatchLookup.end())
-        {
-            return false;
-        }
-        else if (attr_name == MATCH_IN_PORTS)
-        {
-            auto ports = tokenize(attr_value, ',');
-
-            if (ports.size() == 0)
-            {
-                return false;
-            }
-
-            m_inPorts.clear();
-            for (auto alias : ports)
-            {
-                Port port;
-                if (!gPortsOrch->getPort(alias, port))
-                {
-                    SWSS_LOG_ERROR("Failed to locate port %s", alias.c_str());
-                    return false;
-                }
-                m_inPorts.push_back(port.m_port_id);
-            }
+        return false;
+    }
 
-            value.aclfield.data.objlist.count = static_cast<uint32_t>(m_inPorts.size());
-            value.aclfield.data.objlist.list = m_inPorts.data();
-        }
-        else if (attr_name == MATCH_OUT_PORTS)
+    try
+    {
+        if (match.attr == SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS || match.attr == SAI_ACL_ENTRY_ATTR_FIELD_OUT_PORTS)
         {
+            vector<sai_object_id_t> &portOids = (match.attr == SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS) ? m_inPorts : m_outPorts;
             auto ports = tokenize(attr_value, ',');
 
             if (ports.size() == 0)
@@ -200,7 +132,7 @@ bool AclRule::validateAddMatch(string attr_name, string attr_value)
                 return false;
             }
 
-            m_outPorts.clear();
+            portOids.clear();
             for (auto alias : ports)
             {
                 Port port;
@@ -209,176 +141,35 @@ bool AclRule::validateAddMatch(string attr_name, string attr_value)
                     SWSS_LOG_ERROR("Failed to locate port %s", alias.c_str());
                     return false;
                 }
-                m_outPorts.push_back(port.m_port_id);
-            }
-
-            value.aclfield.data.objlist.count = static_cast<uint32_t>(m_outPorts.size());
-            value.aclfield.data.objlist.list = m_outPorts.data();
-        }
-        else if (attr_name == MATCH_IP_TYPE)
-        {
-            if (!processIpType(attr_value, value.aclfield.data.u32))
-            {
-                SWSS_LOG_ERROR("Invalid IP type %s", attr_value.c_str());
-                return false;
-            }
-
-            value.aclfield.mask.u32 = 0xFFFFFFFF;
-        }
-        else if (attr_name == MATCH_TCP_FLAGS)
-        {
-            vector<string> flagsData;
-            string flags, mask;
-            int val;
-            char *endp = NULL;
-            errno = 0;
-
-            split(attr_value, flagsData, '/');
-
-            if (flagsData.size() != 2) // expect two parts flags and mask separated with '/'
-            {
-                SWSS_LOG_ERROR("Invalid TCP flags format %s", attr_value.c_str());
-                return false;
-            }
-
-            flags = trim(flagsData[0]);
-            mask = trim(flagsData[1]);
-
-            val = (uint32_t)strtol(flags.c_str(), &endp, 0);
-            if (errno || (endp != flags.c_str() + flags.size()) ||
-                (val < 0) || (val > UCHAR_MAX))
-            {
-                SWSS_LOG_ERROR("TCP flags parse error, value: %s(=%d), errno: %d", flags.c_str(), val, errno);
-                return false;
-            }
-            value.aclfield.data.u8 = (uint8_t)val;
-
-            val = (uint32_t)strtol(mask.c_str(), &endp, 0);
-            if (errno || (endp != mask.c_str() + mask.size()) ||
-                (val < 0) || (val > UCHAR_MAX))
-            {
-                SWSS_LOG_ERROR("TCP mask parse error, value: %s(=%d), errno: %d", mask.c_str(), val, errno);
-                return false;
-            }
-            value.aclfield.mask.u8 = (uint8_t)val;
-        }
-        else if (attr_name == MATCH_ETHER_TYPE || attr_name == MATCH_L4_SRC_PORT || attr_name == MATCH_L4_DST_PORT)
-        {
-            value.aclfield.data.u16 = to_uint<uint16_t>(attr_value);
-            value.aclfield.mask.u16 = 0xFFFF;
-        }
-        else if (attr_name == MATCH_DSCP)
-        {
-            /* Support both exact value match and value/mask match */
-            auto dscp_data = tokenize(attr_value, '/');
-
-            value.aclfield.data.u8 = to_uint<uint8_t>(dscp_data[0], 0, 0x3F);
-
-            if (dscp_data.size() == 2)
-            {
-                value.aclfield.mask.u8 = to_uint<uint8_t>(dscp_data[1], 0, 0x3F);
-            }
-            else
-            {
-                value.aclfield.mask.u8 = 0x3F;
-            }
-        }
-        else if (attr_name == MATCH_IP_PROTOCOL)
-        {
-            value.aclfield.data.u8 = to_uint<uint8_t>(attr_value);
-            value.aclfield.mask.u8 = 0xFF;
-        }
-        else if (attr_name == MATCH_SRC_IP || attr_name == MATCH_DST_IP)
-        {
-            IpPrefix ip(attr_value);
-
-            if (!ip.isV4())
-            {
-                SWSS_LOG_ERROR("IP type is not v4 type");
-                return false;
-            }
-            value.aclfield.data.ip4 = ip.getIp().getV4Addr();
-            value.aclfield.mask.ip4 = ip.getMask().getV4Addr();
-        }
-        else if (attr_name == MATCH_SRC_IPV6 || attr_name == MATCH_DST_IPV6)
-        {
-            IpPrefix ip(attr_value);
-            if (ip.isV4())
-            {
-                SWSS_LOG_ERROR("IP type is not v6 type");
-                return false;
-            }
-            memcpy(value.aclfield.data.ip6, ip.getIp().getV6Addr(), 16);
-            memcpy(value.aclfield.mask.ip6, ip.getMask().getV6Addr(), 16);
-        }
-        else if ((attr_name == MATCH_L4_SRC_PORT_RANGE) || (attr_name == MATCH_L4_DST_PORT_RANGE))
-        {
-            if (sscanf(attr_value.c_str(), "%d-%d", &value.u32range.min, &value.u32range.max) != 2)
-            {
-                SWSS_LOG_ERROR("Range parse error. Attribute: %s, value: %s", attr_name.c_str(), attr_value.c_str());
-                return false;
+                portOids.push_back(port.m_port_id);
             }
 
-            // check boundaries
-            if ((value.u32range.min > USHRT_MAX) ||
-                (value.u32range.max > USHRT_MAX) ||
-                (value.u32range.min > value.u32range.max))
-            {
-                SWSS_LOG_ERROR("Range parse error. Invalid range value. Attribute: %s, value: %s", attr_name.c_str(), attr_value.c_str());
-                return false;
-            }
+            value.aclfield.data.objlist.count = static_cast<uint32_t>(portOids.size());
+            value.aclfield.data.objlist.list = portOids.data();
         }
-        else if (attr_name == MATCH_TC)
+        else if (!match.parse(match.name, attr_value, value))
         {
-            value.aclfield.data.u8 = to_uint<uint8_t>(attr_value);
-            value.aclfield.mask.u8 = 0xFF;
-        }
-        else if (attr_name == MATCH_TUNNEL_VNI)
-        {
-            value.aclfield.data.u32 = to_uint<uint32_t>(attr_value);
-            value.aclfield.mask.u32 = 0xFFFFFFFF;
-        }
-        else if (attr_name == MATCH_INNER_ETHER_TYPE || attr_name == MATCH_INNER_L4_SRC_PORT ||
-            attr_name == MATCH_INNER_L4_DST_PORT)
-        {
-            value.aclfield.data.u16 = to_uint<uint16_t>(attr_value);
-            value.aclfield.mask.u16 = 0xFFFF;
-        }
-        else if (attr_name == MATCH_INNER_IP_PROTOCOL)
-        {
-            value.aclfield.data.u8 = to_uint<uint8_t>(attr_value);
-            value.aclfield.mask.u8 = 0xFF;
+            return false;
         }
     }
     catch (exception &e)
     {
-        SWSS_LOG_ERROR("Failed to parse %s attribute %s value. Error: %s", attr_name.c_str(), attr_value.c_str(), e.what());
+        SWSS_LOG_ERROR("Failed to parse %s attribute %s value. Error: %s", match.name, attr_value.c_str(), e.what());
         return false;
     }
     catch (...)
     {
-        SWSS_LOG_ERROR("Failed to parse %s attribute %s value.", attr_name.c_str(), attr_value.c_str());
+        SWSS_LOG_ERROR("Failed to parse %s attribute %s value.", match.name, attr_value.c_str());
         return false;
     }
 
-    m_matches[aclMatchLookup[attr_name]] = value;
+    m_matches[match.attr] = value;
 
     return true;
 }
 
-bool AclRule::processIpType(string type, sai_uint32_t &ip_type)
+bool AclRule::isMatchSupported(const AclRuleAttr &)
 {
-    SWSS_LOG_ENTER();
-
-    auto it = aclIpTypeLookup.find(to_upper(type));
-
-    if (it == aclIpTypeLookup.end())
-    {
-        return false;
-    }
-
-    ip_type = it->second;
-
     return true;
 }
 
@@ -484,6 +275,157 @@ bool AclRule::create()
     return (status == SAI_STATUS_SUCCESS);
 }
 
+/*
+ * Update the installed ACL entry to the configuration of 'updatedRule', a
+ * rule with the same id parsed from a new configuration, by setting only
+ * the attributes that changed. The entry is not removed meanwhile, so
+ * traffic keeps being matched. On success 'updatedRule' takes over the
+ * entry and its counter. False is returned when the change can't be made
+ * in place or a SAI call failed, the rule is then to be recreated.
+ */
+bool AclRule::modify(AclRule &updatedRule)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_ruleOid == SAI_NULL_OBJECT_ID || typeid(*this) != typeid(updatedRule) ||
+        m_tableOid != updatedRule.m_tableOid)
+    {
+        return false;
+    }
+
+    /* Range objects are shared between entries, changing them takes a new entry */
+    for (auto range_type : { SAI_ACL_RANGE_TYPE_L4_SRC_PORT_RANGE, SAI_ACL_RANGE_TYPE_L4_DST_PORT_RANGE })
+    {
+        auto attr = (sai_acl_entry_attr_t)range_type;
+        if (m_matches.count(attr) != updatedRule.m_matches.count(attr) ||
+            (m_matches.count(attr) && isMatchModified(attr, updatedRule)))
+        {
+            return false;
+        }
+    }
+
+    if (m_priority != updatedRule.m_priority)
+    {
+        sai_attribute_value_t value;
+        value.u32 = updatedRule.m_priority;
+
+        if (!setEntryAttribute(SAI_ACL_ENTRY_ATTR_PRIORITY, value))
+        {
+            return false;
+        }
+    }
+
+    for (const auto &match : updatedRule.m_matches)
+    {
+        if ((sai_acl_range_type_t)match.first == SAI_ACL_RANGE_TYPE_L4_SRC_PORT_RANGE ||
+            (sai_acl_range_type_t)match.first == SAI_ACL_RANGE_TYPE_L4_DST_PORT_RANGE)
+        {
+            continue;
+        }
+
+        if (m_matches.count(match.first) && !isMatchModified(match.first, updatedRule))
+        {
+            continue;
+        }
+
+        sai_attribute_value_t value = match.second;
+        value.aclfield.enable = true;
+
+        if (!setEntryAttribute(match.first, value))
+        {
+            return false;
+        }
+    }
+
+    for (const auto &match : m_matches)
+    {
+        if (updatedRule.m_matches.count(match.first))
+        {
+            continue;
+        }
+
+        sai_attribute_value_t value = match.second;
+        value.aclfield.enable = false;
+
+        if (!setEntryAttribute(match.first, value))
+        {
+            return false;
+        }
+    }
+
+    for (const auto &action : updatedRule.m_actions)
+    {
+        auto installed = m_actions.find(action.first);
+        if (installed != m_actions.end() &&
+            !memcmp(&installed->second, &action.second, sizeof(action.second)))
+        {
+            continue;
+        }
+
+        if (!setEntryAttribute(action.first, action.second))
+        {
+            return false;
+        }
+    }
+
+    for (const auto &action : m_actions)
+    {
+        if (updatedRule.m_actions.count(action.first))
+        {
+            continue;
+        }
+
+        sai_attribute_value_t value = action.second;
+        value.aclaction.enable = false;
+
+        if (!setEntryAttribute(action.first, value))
+        {
+            return false;
+        }
+    }
+
+    updatedRule.m_ruleOid = m_ruleOid;
+    updatedRule.m_counterOid = m_counterOid;
+    m_ruleOid = SAI_NULL_OBJECT_ID;
+    m_counterOid = SAI_NULL_OBJECT_ID;
+
+    /* Redirect targets of the updated rule were referenced when it was parsed */
+    decreaseNextHopRefCount();
+
+    return true;
+}
+
+bool AclRule::isMatchModified(sai_acl_entry_attr_t attr, const AclRule &updatedRule) const
+{
+    if (attr == SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS)
+    {
+        return m_inPorts != updatedRule.m_inPorts;
+    }
+
+    if (attr == SAI_ACL_ENTRY_ATTR_FIELD_OUT_PORTS)
+    {
+        return m_outPorts != updatedRule.m_outPorts;
+    }
+
+    return memcmp(&m_matches.at(attr), &updatedRule.m_matches.at(attr), sizeof(sai_attribute_value_t)) != 0;
+}
+
+bool AclRule::setEntryAttribute(sai_acl_entry_attr_t attr, const sai_attribute_value_t &value)
+{
+    sai_attribute_t rule_attr;
+    rule_attr.id = attr;
+    rule_attr.value = value;
+
+    sai_status_t status = sai_acl_api->set_acl_entry_attribute(m_ruleOid, &rule_attr);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to set attribute %d of ACL rule %s, rv:%d", attr, m_id.c_str(), status);
+        return false;
+    }
+
+    return true;
+}
+
 void AclRule::decreaseNextHopRefCount()
 {
     if (!m_redirect_target_next_hop.empty())
@@ -569,17 +511,11 @@ shared_ptr<AclRule> AclRule::makeShared(acl_table_type_t type, AclOrch *acl, Mir
     /* Find action configured by user. Based on action type create rule. */
     for (const auto& itr : kfvFieldsValues(data))
     {
-        string attr_name = to_upper(fvField(itr));
-        string attr_value = fvValue(itr);
-        if (attr_name == ACTION_PACKET_ACTION || attr_name == ACTION_MIRROR_ACTION ||
-            attr_name == ACTION_DTEL_FLOW_OP || attr_name == ACTION_DTEL_INT_SESSION ||
-            attr_name == ACTION_DTEL_DROP_REPORT_ENABLE ||
-            attr_name == ACTION_DTEL_TAIL_DROP_REPORT_ENABLE ||
-            attr_name == ACTION_DTEL_FLOW_SAMPLE_PERCENT ||
-            attr_name == ACTION_DTEL_REPORT_ALL_PACKETS)
+        const AclRuleAttr *attr = findAclRuleAttr(fvField(itr));
+        if (attr && attr->kind == ACL_RULE_ATTR_ACTION)
         {
             action_found = true;
-            action = attr_name;
+            action = attr->name;
             break;
         }
     }
@@ -716,6 +652,7 @@ bool AclRuleL3::validateAddAction(string attr_name, string _attr_value)
 
     string attr_value = to_upper(_attr_value);
     sai_attribute_value_t value;
+    memset(&value, 0, sizeof(value));
 
     if (attr_name != ACTION_PACKET_ACTION)
     {
@@ -840,20 +777,20 @@ sai_object_id_t AclRuleL3::getRedirectObjectId(const string& redirect_value)
     return SAI_NULL_OBJECT_ID;
 }
 
-bool AclRuleL3::validateAddMatch(string attr_name, string attr_value)
+bool AclRuleL3::isMatchSupported(const AclRuleAttr &match)
 {
-    if (attr_name == MATCH_DSCP)
+    if (match.attr == SAI_ACL_ENTRY_ATTR_FIELD_DSCP)
     {
         SWSS_LOG_ERROR("DSCP match is not supported for the tables of type L3");
         return false;
     }
-    if (attr_name == MATCH_SRC_IPV6 || attr_name == MATCH_DST_IPV6)
+    if (match.attr == SAI_ACL_ENTRY_ATTR_FIELD_SRC_IPV6 || match.attr == SAI_ACL_ENTRY_ATTR_FIELD_DST_IPV6)
     {
         SWSS_LOG_ERROR("IPv6 address match is not supported for the tables of type L3");
         return false;
     }
 
-    return AclRule::validateAddMatch(attr_name, attr_value);
+    return true;
 }
 
 bool AclRuleL3::validate()
@@ -879,15 +816,15 @@ AclRulePfcwd::AclRulePfcwd(AclOrch *aclOrch, string rule, string table, acl_tabl
 {
 }
 
-bool AclRulePfcwd::validateAddMatch(string attr_name, string attr_value)
+bool AclRulePfcwd::isMatchSupported(const AclRuleAttr &match)
 {
-    if (attr_name != MATCH_TC)
+    if (match.attr != SAI_ACL_ENTRY_ATTR_FIELD_TC)
     {
-        SWSS_LOG_ERROR("%s is not supported for the tables of type Pfcwd", attr_name.c_str());
+        SWSS_LOG_ERROR("%s is not supported for the tables of type Pfcwd", match.name);
         return false;
     }
 
-    return AclRule::validateAddMatch(attr_name, attr_value);
+    return true;
 }
 
 AclRuleL3V6::AclRuleL3V6(AclOrch *aclOrch, string rule, string table, acl_table_type_t type) :
@@ -896,20 +833,20 @@ AclRuleL3V6::AclRuleL3V6(AclOrch *aclOrch, string rule, string table, acl_table_
 }
 
 
-bool AclRuleL3V6::validateAddMatch(string attr_name, string attr_value)
+bool AclRuleL3V6::isMatchSupported(const AclRuleAttr &match)
 {
-    if (attr_name == MATCH_DSCP)
+    if (match.attr == SAI_ACL_ENTRY_ATTR_FIELD_DSCP)
     {
         SWSS_LOG_ERROR("DSCP match is not supported for the tables of type L3V6");
         return false;
     }
-    if (attr_name == MATCH_SRC_IP || attr_name == MATCH_DST_IP)
+    if (match.attr == SAI_ACL_ENTRY_ATTR_FIELD_SRC_IP || match.attr == SAI_ACL_ENTRY_ATTR_FIELD_DST_IP)
     {
         SWSS_LOG_ERROR("IPv4 address match is not supported for the tables of type L3V6");
         return false;
     }
 
-    return AclRule::validateAddMatch(attr_name, attr_value);
+    return true;
 }
 
 
@@ -939,16 +876,16 @@ bool AclRuleMirror::validateAddAction(string attr_name, string attr_value)
     return true;
 }
 
-bool AclRuleMirror::validateAddMatch(string attr_name, string attr_value)
+bool AclRuleMirror::isMatchSupported(const AclRuleAttr &match)
 {
     if ((m_tableType == ACL_TABLE_L3 || m_tableType == ACL_TABLE_L3V6)
-	&& attr_name == MATCH_DSCP)
+	&& match.attr == SAI_ACL_ENTRY_ATTR_FIELD_DSCP)
     {
         SWSS_LOG_ERROR("DSCP match is not supported for the tables of type L3");
         return false;
     }
 
-    return AclRule::validateAddMatch(attr_name, attr_value);
+    return true;
 }
 
 bool AclRuleMirror::validate()
@@ -1010,6 +947,39 @@ bool AclRuleMirror::create()
     return true;
 }
 
+bool AclRuleMirror::modify(AclRule &updatedRule)
+{
+    SWSS_LOG_ENTER();
+
+    if (typeid(updatedRule) != typeid(*this))
+    {
+        return false;
+    }
+
+    AclRuleMirror &rule = static_cast<AclRuleMirror &>(updatedRule);
+
+    /* Only an active rule staying on the same session keeps its mirror action */
+    if (!m_state || rule.m_sessionName != m_sessionName)
+    {
+        return false;
+    }
+
+    rule.m_actions = m_actions;
+
+    if (!AclRule::modify(updatedRule))
+    {
+        rule.m_actions.clear();
+        return false;
+    }
+
+    /* The session reference count is carried over along with the entry */
+    rule.m_state = true;
+    rule.counters = counters;
+    m_state = false;
+
+    return true;
+}
+
 bool AclRuleMirror::remove()
 {
     if (!m_state)
@@ -1308,7 +1278,15 @@ bool AclTable::add(shared_ptr<AclRule> newRule)
     auto ruleIter = rules.find(rule_id);
     if (ruleIter != rules.end())
     {
-        // If ACL rule already exists, delete it first
+        // If ACL rule already exists, update it in place when possible
+        if (ruleIter->second->modify(*newRule))
+        {
+            ruleIter->second = newRule;
+            SWSS_LOG_NOTICE("Successfully updated ACL rule %s in table %s", rule_id.c_str(), id.c_str());
+            return true;
+        }
+
+        // Otherwise delete it first
         if (ruleIter->second->remove())
         {
             rules.erase(ruleIter);
@@ -1466,11 +1444,17 @@ bool AclRuleDTelFlowWatchListEntry::validateAddAction(string attr_name, string a
         value.aclaction.enable = (attr_value == DTEL_ENABLED) ? true : false;
     }
 
-    m_actions[aclDTelActionLookup[attr_name]] = value;
+    m_actions[findAclRuleAttr(attr_name)->attr] = value;
 
     return true;
 }
 
+bool AclRuleDTelFlowWatchListEntry::modify(AclRule &)
+{
+    /* INT session references are tied to the entry, always recreate it */
+    return false;
+}
+
 bool AclRuleDTelFlowWatchListEntry::validate()
 {
     SWSS_LOG_ENTER();
@@ -1624,7 +1608,7 @@ bool AclRuleDTelDropWatchListEntry::validateAddAction(string attr_name, string a
     value.aclaction.parameter.booldata = (attr_value == DTEL_ENABLED) ? true : false;
     value.aclaction.enable = (attr_value == DTEL_ENABLED) ? true : false;
 
-    m_actions[aclDTelActionLookup[attr_name]] = value;
+    m_actions[findAclRuleAttr(attr_name)->attr] = value;
 
     return true;
 }
@@ -1646,6 +1630,11 @@ bool AclRuleDTelDropWatchListEntry::validate()
     return true;
 }
 
+bool AclRuleDTelDropWatchListEntry::modify(AclRule &)
+{
+    return false;
+}
+
 void AclRuleDTelDropWatchListEntry::update(SubjectType, void *)
 {
     // Do nothing
@@ -2156,26 +2145,29 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
 
             for (const auto& itr : kfvFieldsValues(t))
             {
-                string attr_name = to_upper(fvField(itr));
-                string attr_value = fvValue(itr);
+                const string &attr_value = fvValue(itr);
+                const AclRuleAttr *attr = findAclRuleAttr(fvField(itr));
 
-                SWSS_LOG_INFO("ATTRIBUTE: %s %s", attr_name.c_str(), attr_value.c_str());
+                SWSS_LOG_INFO("ATTRIBUTE: %s %s", fvField(itr).c_str(), attr_value.c_str());
 
-                if (newRule->validateAddPriority(attr_name, attr_value))
+                if (attr && attr->kind == ACL_RULE_ATTR_PRIORITY &&
+                    newRule->validateAddPriority(attr->name, attr_value))
                 {
                     SWSS_LOG_INFO("Added priority attribute");
                 }
-                else if (newRule->validateAddMatch(attr_name, attr_value))
+                else if (attr && attr->kind == ACL_RULE_ATTR_MATCH &&
+                         newRule->validateAddMatch(*attr, attr_value))
                 {
-                    SWSS_LOG_INFO("Added match attribute '%s'", attr_name.c_str());
+                    SWSS_LOG_INFO("Added match attribute '%s'", attr->name);
                 }
-                else if (newRule->validateAddAction(attr_name, attr_value))
+                else if (attr && attr->kind == ACL_RULE_ATTR_ACTION &&
+                         newRule->validateAddAction(attr->name, attr_value))
                 {
-                    SWSS_LOG_INFO("Added action attribute '%s'", attr_name.c_str());
+                    SWSS_LOG_INFO("Added action attribute '%s'", attr->name);
                 }
                 else
                 {
-                    SWSS_LOG_ERROR("Unknown or invalid rule attribute '%s : %s'", attr_name.c_str(), attr_value.c_str());
+                    SWSS_LOG_ERROR("Unknown or invalid rule attribute '%s : %s'", fvField(itr).c_str(), attr_value.c_str());
                     bAllAttributesOk = false;
                     break;
                 }
@@ -13,6 +13,7 @@
 #include "mirrororch.h"
 #include "dtelorch.h"
 #include "observer.h"
+#include "aclruleattr.h"
 
 // ACL counters update interval in the DB
 // Value is in seconds. Should not be less than 5 seconds
@@ -32,61 +33,6 @@
 #define TABLE_TYPE_DTEL_FLOW_WATCHLIST "DTEL_FLOW_WATCHLIST"
 #define TABLE_TYPE_DTEL_DROP_WATCHLIST "DTEL_DROP_WATCHLIST"
 
-#define RULE_PRIORITY           "PRIORITY"
-#define MATCH_IN_PORTS          "IN_PORTS"
-#define MATCH_OUT_PORTS         "OUT_PORTS"
-#define MATCH_SRC_IP            "SRC_IP"
-#define MATCH_DST_IP            "DST_IP"
-#define MATCH_SRC_IPV6          "SRC_IPV6"
-#define MATCH_DST_IPV6          "DST_IPV6"
-#define MATCH_L4_SRC_PORT       "L4_SRC_PORT"
-#define MATCH_L4_DST_PORT       "L4_DST_PORT"
-#define MATCH_ETHER_TYPE        "ETHER_TYPE"
-#define MATCH_IP_PROTOCOL       "IP_PROTOCOL"
-#define MATCH_TCP_FLAGS         "TCP_FLAGS"
-#define MATCH_IP_TYPE           "IP_TYPE"
-#define MATCH_DSCP              "DSCP"
-#define MATCH_L4_SRC_PORT_RANGE "L4_SRC_PORT_RANGE"
-#define MATCH_L4_DST_PORT_RANGE "L4_DST_PORT_RANGE"
-#define MATCH_TC                "TC"
-#define MATCH_TUNNEL_VNI        "TUNNEL_VNI"
-#define MATCH_INNER_ETHER_TYPE  "INNER_ETHER_TYPE"
-#define MATCH_INNER_IP_PROTOCOL "INNER_IP_PROTOCOL"
-#define MATCH_INNER_L4_SRC_PORT "INNER_L4_SRC_PORT"
-#define MATCH_INNER_L4_DST_PORT "INNER_L4_DST_PORT"
-
-#define ACTION_PACKET_ACTION    "PACKET_ACTION"
-#define ACTION_MIRROR_ACTION    "MIRROR_ACTION"
-#define ACTION_DTEL_FLOW_OP                 "FLOW_OP"
-#define ACTION_DTEL_INT_SESSION             "INT_SESSION"
-#define ACTION_DTEL_DROP_REPORT_ENABLE      "DROP_REPORT_ENABLE"
-#define ACTION_DTEL_TAIL_DROP_REPORT_ENABLE "TAIL_DROP_REPORT_ENABLE"
-#define ACTION_DTEL_FLOW_SAMPLE_PERCENT     "FLOW_SAMPLE_PERCENT"
-#define ACTION_DTEL_REPORT_ALL_PACKETS      "REPORT_ALL_PACKETS"
-
-#define PACKET_ACTION_FORWARD   "FORWARD"
-#define PACKET_ACTION_DROP      "DROP"
-#define PACKET_ACTION_REDIRECT  "REDIRECT"
-
-#define DTEL_FLOW_OP_NOP        "NOP"
-#define DTEL_FLOW_OP_POSTCARD   "POSTCARD"
-#define DTEL_FLOW_OP_INT        "INT"
-#define DTEL_FLOW_OP_IOAM       "IOAM"
-
-#define DTEL_ENABLED             "TRUE"
-#define DTEL_DISABLED            "FALSE"
-
-#define IP_TYPE_ANY             "ANY"
-#define IP_TYPE_IP              "IP"
-#define IP_TYPE_NON_IP          "NON_IP"
-#define IP_TYPE_IPv4ANY         "IPV4ANY"
-#define IP_TYPE_NON_IPv4        "NON_IPv4"
-#define IP_TYPE_IPv6ANY         "IPV6ANY"
-#define IP_TYPE_NON_IPv6        "NON_IPv6"
-#define IP_TYPE_ARP             "ARP"
-#define IP_TYPE_ARP_REQUEST     "ARP_REQUEST"
-#define IP_TYPE_ARP_REPLY       "ARP_REPLY"
-
 #define MLNX_MAX_RANGES_COUNT   16
 
 typedef enum
@@ -103,7 +49,6 @@ typedef enum
 
 typedef map<string, acl_table_type_t> acl_table_type_lookup_t;
 typedef map<string, sai_acl_entry_attr_t> acl_rule_attr_lookup_t;
-typedef map<string, sai_acl_ip_type_t> acl_ip_type_lookup_t;
 typedef map<string, sai_acl_dtel_flow_op_t> acl_dtel_flow_op_type_lookup_t;
 typedef tuple<sai_acl_range_type_t, int, int> acl_range_properties_t;
 
@@ -162,9 +107,9 @@ public:
     AclRule(AclOrch *m_pAclOrch, string rule, string table, acl_table_type_t type, bool createCounter = true);
     virtual bool validateAddPriority(string attr_name, string attr_value);
     virtual bool validateAddMatch(string attr_name, string attr_value);
+    bool validateAddMatch(const AclRuleAttr &match, const string &attr_value);
     virtual bool validateAddAction(string attr_name, string attr_value) = 0;
     virtual bool validate() = 0;
-    bool processIpType(string type, sai_uint32_t &ip_type);
     inline static void setRulePriorities(sai_uint32_t min, sai_uint32_t max)
     {
         m_minPriority = min;
@@ -173,6 +118,7 @@ public:
 
     virtual bool create();
     virtual bool remove();
+    virtual bool modify(AclRule &updatedRule);
     virtual void update(SubjectType, void *) = 0;
     virtual AclRuleCounters getCounters();
 
@@ -198,6 +144,10 @@ protected:
     virtual bool createCounter();
     virtual bool removeCounter();
     virtual bool removeRanges();
+    virtual bool isMatchSupported(const AclRuleAttr &match);
+
+    bool isMatchModified(sai_acl_entry_attr_t attr, const AclRule &updatedRule) const;
+    bool setEntryAttribute(sai_acl_entry_attr_t attr, const sai_attribute_value_t &value);
 
     void decreaseNextHopRefCount();
 
@@ -229,10 +179,10 @@ public:
     AclRuleL3(AclOrch *m_pAclOrch, string rule, string table, acl_table_type_t type, bool createCounter = true);
 
     bool validateAddAction(string attr_name, string attr_value);
-    bool validateAddMatch(string attr_name, string attr_value);
     bool validate();
     void update(SubjectType, void *);
 protected:
+    bool isMatchSupported(const AclRuleAttr &match);
     sai_object_id_t getRedirectObjectId(const string& redirect_param);
 };
 
@@ -240,14 +190,18 @@ class AclRuleL3V6: public AclRuleL3
 {
 public:
     AclRuleL3V6(AclOrch *m_pAclOrch, string rule, string table, acl_table_type_t type);
-    bool validateAddMatch(string attr_name, string attr_value);
+
+protected:
+    bool isMatchSupported(const AclRuleAttr &match);
 };
 
 class AclRulePfcwd: public AclRuleL3
 {
 public:
     AclRulePfcwd(AclOrch *m_pAclOrch, string rule, string table, acl_table_type_t type, bool createCounter = false);
-    bool validateAddMatch(string attr_name, string attr_value);
+
+protected:
+    bool isMatchSupported(const AclRuleAttr &match);
 };
 
 
@@ -256,14 +210,16 @@ class AclRuleMirror: public AclRule
 public:
     AclRuleMirror(AclOrch *m_pAclOrch, MirrorOrch *m_pMirrorOrch, string rule, string table, acl_table_type_t type);
     bool validateAddAction(string attr_name, string attr_value);
-    bool validateAddMatch(string attr_name, string attr_value);
     bool validate();
     bool create();
     bool remove();
+    bool modify(AclRule &updatedRule);
     void update(SubjectType, void *);
     AclRuleCounters getCounters();
 
 protected:
+    bool isMatchSupported(const AclRuleAttr &match);
+
     bool m_state;
     string m_sessionName;
     AclRuleCounters counters;
@@ -278,6 +234,7 @@ public:
     bool validate();
     bool create();
     bool remove();
+    bool modify(AclRule &updatedRule);
     void update(SubjectType, void *);
 
 protected:
@@ -293,6 +250,7 @@ public:
     AclRuleDTelDropWatchListEntry(AclOrch *m_pAclOrch, DTelOrch *m_pDTelOrch, string rule, string table, acl_table_type_t type);
     bool validateAddAction(string attr_name, string attr_value);
     bool validate();
+    bool modify(AclRule &updatedRule);
     void update(SubjectType, void *);
 
 protected:
@@ -337,7 +295,7 @@ public:
     bool unbind();
     // Link the ACL table with a port, for future bind or unbind
     void link(sai_object_id_t portOid);
-    // Add or overwrite a rule into the ACL table
+    // Add or overwrite a rule into the ACL table, modifying an existing rule in place when possible
     bool add(shared_ptr<AclRule> newRule);
     // Remove a rule from the ACL table
     bool remove(string rule_id);
@@ -0,0 +1,296 @@
+#include <limits.h>
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <vector>
+#include "aclruleattr.h"
+#include "logger.h"
+#include "ipprefix.h"
+#include "converter.h"
+#include "tokenize.h"
+
+using namespace swss;
+
+static string trim(const std::string& str, const std::string& whitespace = " \t")
+{
+    const auto strBegin = str.find_first_not_of(whitespace);
+    if (strBegin == std::string::npos)
+        return "";
+
+    const auto strEnd = str.find_last_not_of(whitespace);
+    const auto strRange = strEnd - strBegin + 1;
+
+    return str.substr(strBegin, strRange);
+}
+
+static const struct
+{
+    const char *name;
+    sai_acl_ip_type_t type;
+} aclIpTypes[] =
+{
+    { IP_TYPE_ANY,         SAI_ACL_IP_TYPE_ANY },
+    { IP_TYPE_IP,          SAI_ACL_IP_TYPE_IP },
+    { IP_TYPE_NON_IP,      SAI_ACL_IP_TYPE_NON_IP },
+    { IP_TYPE_IPv4ANY,     SAI_ACL_IP_TYPE_IPV4ANY },
+    { IP_TYPE_NON_IPv4,    SAI_ACL_IP_TYPE_NON_IPV4 },
+    { IP_TYPE_IPv6ANY,     SAI_ACL_IP_TYPE_IPV6ANY },
+    { IP_TYPE_NON_IPv6,    SAI_ACL_IP_TYPE_NON_IPV6 },
+    { IP_TYPE_ARP,         SAI_ACL_IP_TYPE_ARP },
+    { IP_TYPE_ARP_REQUEST, SAI_ACL_IP_TYPE_ARP_REQUEST },
+    { IP_TYPE_ARP_REPLY,   SAI_ACL_IP_TYPE_ARP_REPLY }
+};
+
+bool parseAclIpType(const string &type, sai_uint32_t &ip_type)
+{
+    for (const auto &t : aclIpTypes)
+    {
+        if (strcasecmp(type.c_str(), t.name) == 0)
+        {
+            ip_type = t.type;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool parseIpType(const char *, const string &value, sai_attribute_value_t &out)
+{
+    if (!parseAclIpType(value, out.aclfield.data.u32))
+    {
+        SWSS_LOG_ERROR("Invalid IP type %s", value.c_str());
+        return false;
+    }
+
+    out.aclfield.mask.u32 = 0xFFFFFFFF;
+    return true;
+}
+
+static bool parseTcpFlags(const char *, const string &value, sai_attribute_value_t &out)
+{
+    string flags, mask;
+    int val;
+    char *endp = NULL;
+    errno = 0;
+
+    auto flagsData = tokenize(value, '/');
+
+    if (flagsData.size() != 2) // expect two parts flags and mask separated with '/'
+    {
+        SWSS_LOG_ERROR("Invalid TCP flags format %s", value.c_str());
+        return false;
+    }
+
+    flags = trim(flagsData[0]);
+    mask = trim(flagsData[1]);
+
+    val = (uint32_t)strtol(flags.c_str(), &endp, 0);
+    if (errno || (endp != flags.c_str() + flags.size()) ||
+        (val < 0) || (val > UCHAR_MAX))
+    {
+        SWSS_LOG_ERROR("TCP flags parse error, value: %s(=%d), errno: %d", flags.c_str(), val, errno);
+        return false;
+    }
+    out.aclfield.data.u8 = (uint8_t)val;
+
+    val = (uint32_t)strtol(mask.c_str(), &endp, 0);
+    if (errno || (endp != mask.c_str() + mask.size()) ||
+        (val < 0) || (val > UCHAR_MAX))
+    {
+        SWSS_LOG_ERROR("TCP mask parse error, value: %s(=%d), errno: %d", mask.c_str(), val, errno);
+        return false;
+    }
+    out.aclfield.mask.u8 = (uint8_t)val;
+
+    return true;
+}
+
+static bool parseU8(const char *, const string &value, sai_attribute_value_t &out)
+{
+    out.aclfield.data.u8 = to_uint<uint8_t>(value);
+    out.aclfield.mask.u8 = 0xFF;
+    return true;
+}
+
+static bool parseU16(const char *, const string &value, sai_attribute_value_t &out)
+{
+    out.aclfield.data.u16 = to_uint<uint16_t>(value);
+    out.aclfield.mask.u16 = 0xFFFF;
+    return true;
+}
+
+static bool parseU32(const char *, const string &value, sai_attribute_value_t &out)
+{
+    out.aclfield.data.u32 = to_uint<uint32_t>(value);
+    out.aclfield.mask.u32 = 0xFFFFFFFF;
+    return true;
+}
+
+static bool parseDscp(const char *, const string &value, sai_attribute_value_t &out)
+{
+    /* Support both exact value match and value/mask match */
+    auto dscp_data = tokenize(value, '/');
+
+    out.aclfield.data.u8 = to_uint<uint8_t>(dscp_data[0], 0, 0x3F);
+
+    if (dscp_data.size() == 2)
+    {
+        out.aclfield.mask.u8 = to_uint<uint8_t>(dscp_data[1], 0, 0x3F);
+    }
+    else
+    {
+        out.aclfield.mask.u8 = 0x3F;
+    }
+
+    return true;
+}
+
+static bool parseIpv4Prefix(const char *, const string &value, sai_attribute_value_t &out)
+{
+    IpPrefix ip(value);
+
+    if (!ip.isV4())
+    {
+        SWSS_LOG_ERROR("IP type is not v4 type");
+        return false;
+    }
+    out.aclfield.data.ip4 = ip.getIp().getV4Addr();
+    out.aclfield.mask.ip4 = ip.getMask().getV4Addr();
+
+    return true;
+}
+
+static bool parseIpv6Prefix(const char *, const string &value, sai_attribute_value_t &out)
+{
+    IpPrefix ip(value);
+
+    if (ip.isV4())
+    {
+        SWSS_LOG_ERROR("IP type is not v6 type");
+        return false;
+    }
+    memcpy(out.aclfield.data.ip6, ip.getIp().getV6Addr(), 16);
+    memcpy(out.aclfield.mask.ip6, ip.getMask().getV6Addr(), 16);
+
+    return true;
+}
+
+static bool parseRange(const char *name, const string &value, sai_attribute_value_t &out)
+{
+    if (sscanf(value.c_str(), "%d-%d", &out.u32range.min, &out.u32range.max) != 2)
+    {
+        SWSS_LOG_ERROR("Range parse error. Attribute: %s, value: %s", name, value.c_str());
+        return false;
+    }
+
+    // check boundaries
+    if ((out.u32range.min > USHRT_MAX) ||
+        (out.u32range.max > USHRT_MAX) ||
+        (out.u32range.min > out.u32range.max))
+    {
+        SWSS_LOG_ERROR("Range parse error. Invalid range value. Attribute: %s, value: %s", name, value.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Rule attributes of every rule type, sorted by name for binary search. The
+ * actions only carry their kind here, their values are resolved by the rule
+ * type handling them.
+ */
+static constexpr AclRuleAttr aclRuleAttrs[] =
+{
+    { ACTION_DTEL_DROP_REPORT_ENABLE,      ACL_RULE_ATTR_ACTION,   SAI_ACL_ENTRY_ATTR_ACTION_DTEL_DROP_REPORT_ENABLE,      NULL },
+    { MATCH_DSCP,                          ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_DSCP,                          parseDscp },
+    { MATCH_DST_IP,                        ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_DST_IP,                        parseIpv4Prefix },
+    { MATCH_DST_IPV6,                      ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_DST_IPV6,                      parseIpv6Prefix },
+    { MATCH_ETHER_TYPE,                    ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_ETHER_TYPE,                    parseU16 },
+    { ACTION_DTEL_FLOW_OP,                 ACL_RULE_ATTR_ACTION,   SAI_ACL_ENTRY_ATTR_ACTION_ACL_DTEL_FLOW_OP,             NULL },
+    { ACTION_DTEL_FLOW_SAMPLE_PERCENT,     ACL_RULE_ATTR_ACTION,   SAI_ACL_ENTRY_ATTR_ACTION_DTEL_FLOW_SAMPLE_PERCENT,     NULL },
+    { MATCH_INNER_ETHER_TYPE,              ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_INNER_ETHER_TYPE,              parseU16 },
+    { MATCH_INNER_IP_PROTOCOL,             ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_INNER_IP_PROTOCOL,             parseU8 },
+    { MATCH_INNER_L4_DST_PORT,             ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_INNER_L4_DST_PORT,             parseU16 },
+    { MATCH_INNER_L4_SRC_PORT,             ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_INNER_L4_SRC_PORT,             parseU16 },
+    { ACTION_DTEL_INT_SESSION,             ACL_RULE_ATTR_ACTION,   SAI_ACL_ENTRY_ATTR_ACTION_DTEL_INT_SESSION,             NULL },
+    { MATCH_IN_PORTS,                      ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS,                      NULL },
+    { MATCH_IP_PROTOCOL,                   ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_IP_PROTOCOL,                   parseU8 },
+    { MATCH_IP_TYPE,                       ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_ACL_IP_TYPE,                   parseIpType },
+    { MATCH_L4_DST_PORT,                   ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_L4_DST_PORT,                   parseU16 },
+    { MATCH_L4_DST_PORT_RANGE,             ACL_RULE_ATTR_MATCH,    (sai_acl_entry_attr_t)SAI_ACL_RANGE_TYPE_L4_DST_PORT_RANGE, parseRange },
+    { MATCH_L4_SRC_PORT,                   ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_L4_SRC_PORT,                   parseU16 },
+    { MATCH_L4_SRC_PORT_RANGE,             ACL_RULE_ATTR_MATCH,    (sai_acl_entry_attr_t)SAI_ACL_RANGE_TYPE_L4_SRC_PORT_RANGE, parseRange },
+    { ACTION_MIRROR_ACTION,                ACL_RULE_ATTR_ACTION,   SAI_ACL_ENTRY_ATTR_ACTION_MIRROR_INGRESS,               NULL },
+    { MATCH_OUT_PORTS,                     ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_OUT_PORTS,                     NULL },
+    { ACTION_PACKET_ACTION,                ACL_RULE_ATTR_ACTION,   SAI_ACL_ENTRY_ATTR_ACTION_PACKET_ACTION,                NULL },
+    { RULE_PRIORITY,                       ACL_RULE_ATTR_PRIORITY, SAI_ACL_ENTRY_ATTR_PRIORITY,                            NULL },
+    { ACTION_DTEL_REPORT_ALL_PACKETS,      ACL_RULE_ATTR_ACTION,   SAI_ACL_ENTRY_ATTR_ACTION_DTEL_REPORT_ALL_PACKETS,      NULL },
+    { MATCH_SRC_IP,                        ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_SRC_IP,                        parseIpv4Prefix },
+    { MATCH_SRC_IPV6,                      ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_SRC_IPV6,                      parseIpv6Prefix },
+    { ACTION_DTEL_TAIL_DROP_REPORT_ENABLE, ACL_RULE_ATTR_ACTION,   SAI_ACL_ENTRY_ATTR_ACTION_DTEL_TAIL_DROP_REPORT_ENABLE, NULL },
+    { MATCH_TC,                            ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_TC,                            parseU8 },
+    { MATCH_TCP_FLAGS,                     ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_TCP_FLAGS,                     parseTcpFlags },
+    { MATCH_TUNNEL_VNI,                    ACL_RULE_ATTR_MATCH,    SAI_ACL_ENTRY_ATTR_FIELD_TUNNEL_VNI,                    parseU32 }
+};
+
+static const size_t aclRuleAttrCount = sizeof(aclRuleAttrs) / sizeof(aclRuleAttrs[0]);
+
+static constexpr bool nameLess(const char *a, const char *b)
+{
+    return (*a == *b) ? (*a != '\0' && nameLess(a + 1, b + 1)) : (*a < *b);
+}
+
+static constexpr bool namesSorted(const AclRuleAttr *attrs, size_t count)
+{
+    return count < 2 || (nameLess(attrs[0].name, attrs[1].name) && namesSorted(attrs + 1, count - 1));
+}
+
+static_assert(namesSorted(aclRuleAttrs, aclRuleAttrCount), "ACL rule attributes must be sorted by name");
+
+/* Compare 'name' folded to upper case with an upper case table name */
+static int compareName(const char *name, const char *attr)
+{
+    for (; *attr; name++, attr++)
+    {
+        int c = toupper((unsigned char)*name);
+        if (c != *attr)
+        {
+            return c - *attr;
+        }
+    }
+
+    return (unsigned char)*name;
+}
+
+const AclRuleAttr *findAclRuleAttr(const string &name)
+{
+    size_t lo = 0;
+    size_t hi = aclRuleAttrCount;
+
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2;
+        int cmp = compareName(name.c_str(), aclRuleAttrs[mid].name);
+
+        if (cmp == 0)
+        {
+            return &aclRuleAttrs[mid];
+        }
+
+        if (cmp < 0)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+
+    return NULL;
+}
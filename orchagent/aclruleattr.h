@@ -0,0 +1,98 @@
+#ifndef SWSS_ACLRULEATTR_H
+#define SWSS_ACLRULEATTR_H
+
+extern "C" {
+#include "sai.h"
+}
+
+#include <string>
+
+using namespace std;
+
+#define RULE_PRIORITY           "PRIORITY"
+#define MATCH_IN_PORTS          "IN_PORTS"
+#define MATCH_OUT_PORTS         "OUT_PORTS"
+#define MATCH_SRC_IP            "SRC_IP"
+#define MATCH_DST_IP            "DST_IP"
+#define MATCH_SRC_IPV6          "SRC_IPV6"
+#define MATCH_DST_IPV6          "DST_IPV6"
+#define MATCH_L4_SRC_PORT       "L4_SRC_PORT"
+#define MATCH_L4_DST_PORT       "L4_DST_PORT"
+#define MATCH_ETHER_TYPE        "ETHER_TYPE"
+#define MATCH_IP_PROTOCOL       "IP_PROTOCOL"
+#define MATCH_TCP_FLAGS         "TCP_FLAGS"
+#define MATCH_IP_TYPE           "IP_TYPE"
+#define MATCH_DSCP              "DSCP"
+#define MATCH_L4_SRC_PORT_RANGE "L4_SRC_PORT_RANGE"
+#define MATCH_L4_DST_PORT_RANGE "L4_DST_PORT_RANGE"
+#define MATCH_TC                "TC"
+#define MATCH_TUNNEL_VNI        "TUNNEL_VNI"
+#define MATCH_INNER_ETHER_TYPE  "INNER_ETHER_TYPE"
+#define MATCH_INNER_IP_PROTOCOL "INNER_IP_PROTOCOL"
+#define MATCH_INNER_L4_SRC_PORT "INNER_L4_SRC_PORT"
+#define MATCH_INNER_L4_DST_PORT "INNER_L4_DST_PORT"
+
+#define ACTION_PACKET_ACTION    "PACKET_ACTION"
+#define ACTION_MIRROR_ACTION    "MIRROR_ACTION"
+#define ACTION_DTEL_FLOW_OP                 "FLOW_OP"
+#define ACTION_DTEL_INT_SESSION             "INT_SESSION"
+#define ACTION_DTEL_DROP_REPORT_ENABLE      "DROP_REPORT_ENABLE"
+#define ACTION_DTEL_TAIL_DROP_REPORT_ENABLE "TAIL_DROP_REPORT_ENABLE"
+#define ACTION_DTEL_FLOW_SAMPLE_PERCENT     "FLOW_SAMPLE_PERCENT"
+#define ACTION_DTEL_REPORT_ALL_PACKETS      "REPORT_ALL_PACKETS"
+
+#define PACKET_ACTION_FORWARD   "FORWARD"
+#define PACKET_ACTION_DROP      "DROP"
+#define PACKET_ACTION_REDIRECT  "REDIRECT"
+
+#define DTEL_FLOW_OP_NOP        "NOP"
+#define DTEL_FLOW_OP_POSTCARD   "POSTCARD"
+#define DTEL_FLOW_OP_INT        "INT"
+#define DTEL_FLOW_OP_IOAM       "IOAM"
+
+#define DTEL_ENABLED             "TRUE"
+#define DTEL_DISABLED            "FALSE"
+
+#define IP_TYPE_ANY             "ANY"
+#define IP_TYPE_IP              "IP"
+#define IP_TYPE_NON_IP          "NON_IP"
+#define IP_TYPE_IPv4ANY         "IPV4ANY"
+#define IP_TYPE_NON_IPv4        "NON_IPv4"
+#define IP_TYPE_IPv6ANY         "IPV6ANY"
+#define IP_TYPE_NON_IPv6        "NON_IPv6"
+#define IP_TYPE_ARP             "ARP"
+#define IP_TYPE_ARP_REQUEST     "ARP_REQUEST"
+#define IP_TYPE_ARP_REPLY       "ARP_REPLY"
+
+typedef enum
+{
+    ACL_RULE_ATTR_PRIORITY,
+    ACL_RULE_ATTR_MATCH,
+    ACL_RULE_ATTR_ACTION
+} acl_rule_attr_kind_t;
+
+/*
+ * Parse a rule attribute value into its SAI representation. Returns false
+ * when the value is invalid, conversion errors may also be thrown.
+ */
+typedef bool (*acl_rule_attr_parse_fn_t)(const char *name, const string &value, sai_attribute_value_t &out);
+
+struct AclRuleAttr
+{
+    const char *name;
+    acl_rule_attr_kind_t kind;
+    /* Range matches carry their sai_acl_range_type_t */
+    sai_acl_entry_attr_t attr;
+    /* NULL when the value depends on the rule, e.g. port or session lookups */
+    acl_rule_attr_parse_fn_t parse;
+};
+
+/*
+ * Find a rule attribute by its case insensitive name in the attribute table
+ * shared by all rule types, NULL if the attribute is unknown.
+ */
+const AclRuleAttr *findAclRuleAttr(const string &name);
+
+bool parseAclIpType(const string &type, sai_uint32_t &ip_type);
+
+#endif /* SWSS_ACLRULEATTR_H */
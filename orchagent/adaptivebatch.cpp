@@ -0,0 +1,79 @@
+#include "adaptivebatch.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <stdint.h>
+
+using namespace std;
+using namespace swss;
+
+bool parseConsumerBatchConfig(const vector<FieldValueTuple> &fvs, ConsumerBatchConfig &config)
+{
+    ConsumerBatchConfig parsed = config;
+
+    try
+    {
+        for (const auto &fv : fvs)
+        {
+            const string &field = fvField(fv);
+            const string &value = fvValue(fv);
+
+            if (field == "min_batch_size")
+            {
+                parsed.minSize = stoul(value);
+            }
+            else if (field == "max_batch_size")
+            {
+                parsed.maxSize = stoul(value);
+            }
+            else if (field == "latency_target_ms")
+            {
+                parsed.latencyTarget = chrono::milliseconds(stoul(value));
+            }
+        }
+    }
+    catch (const logic_error &)
+    {
+        return false;
+    }
+
+    if (parsed.minSize == 0 || parsed.maxSize < parsed.minSize ||
+        parsed.minSize > INT32_MAX || parsed.latencyTarget.count() == 0)
+    {
+        return false;
+    }
+
+    config = parsed;
+    return true;
+}
+
+AdaptiveBatch::AdaptiveBatch(const ConsumerBatchConfig &config) :
+    m_config(config),
+    m_size(config.minSize),
+    m_maxLatency(0)
+{
+}
+
+void AdaptiveBatch::update(size_t popped, chrono::steady_clock::duration elapsed)
+{
+    m_maxLatency = max(m_maxLatency, elapsed);
+
+    if (elapsed > m_config.latencyTarget)
+    {
+        m_size = max(m_config.minSize, m_size / 2);
+    }
+    /* A full batch means more is waiting */
+    else if (popped >= m_size)
+    {
+        m_size = min(m_config.maxSize, m_size * 2);
+    }
+}
+
+chrono::microseconds AdaptiveBatch::takeMaxLatency()
+{
+    auto latency = chrono::duration_cast<chrono::microseconds>(m_maxLatency);
+
+    m_maxLatency = chrono::steady_clock::duration(0);
+    return latency;
+}
@@ -0,0 +1,61 @@
+#ifndef SWSS_ADAPTIVEBATCH_H
+#define SWSS_ADAPTIVEBATCH_H
+
+#include "table.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/*
+ * CONFIG_DB table bounding the pop batch of APPL_DB table consumers, keyed by
+ * APPL_DB table name, with fields 'min_batch_size', 'max_batch_size' and
+ * 'latency_target_ms'. Read when orchagent starts.
+ */
+#define CFG_CONSUMER_BATCH_TABLE_NAME           "CONSUMER_BATCH"
+/* STATE_DB table the current pop batch of every consumer is published to */
+#define STATE_CONSUMER_BATCH_TABLE_NAME         "CONSUMER_BATCH_TABLE"
+
+/* Bounds of tables left out of CONFIG_DB: orchagent -b, up to this many times more */
+#define DEFAULT_CONSUMER_BATCH_GROWTH           32
+#define DEFAULT_CONSUMER_BATCH_LATENCY_MSECS    100
+
+struct ConsumerBatchConfig
+{
+    size_t                      minSize;        // entries popped from redis at once
+    size_t                      maxSize;        // most entries popped on one select event
+    std::chrono::milliseconds   latencyTarget;  // longest a batch should take to pop and process
+};
+
+/*
+ * Override 'config' with the fields found in 'fvs'. Returns false, leaving
+ * 'config' untouched, if any of them is invalid.
+ */
+bool parseConsumerBatchConfig(const std::vector<swss::FieldValueTuple> &fvs, ConsumerBatchConfig &config);
+
+/*
+ * Pop batch size of a table consumer, following its backlog: doubled while
+ * full batches keep being processed within the latency target, halved as
+ * soon as one isn't.
+ */
+class AdaptiveBatch
+{
+public:
+    AdaptiveBatch(const ConsumerBatchConfig &config);
+
+    size_t size() const { return m_size; }
+    const ConsumerBatchConfig &config() const { return m_config; }
+
+    /* Account for a batch of 'popped' entries which took 'elapsed' to pop and process */
+    void update(size_t popped, std::chrono::steady_clock::duration elapsed);
+
+    /* Slowest batch since the previous call */
+    std::chrono::microseconds takeMaxLatency();
+
+private:
+    ConsumerBatchConfig m_config;
+    size_t m_size;
+    std::chrono::steady_clock::duration m_maxLatency;
+};
+
+#endif /* SWSS_ADAPTIVEBATCH_H */
@@ -207,7 +207,7 @@ task_process_status BufferOrch::processBufferPool(Consumer &consumer)
                 SWSS_LOG_ERROR("Failed to create buffer pool %s with type %s, rv:%d", object_name.c_str(), map_type_name.c_str(), sai_status);
                 return task_process_status::task_failed;
             }
-            (*(m_buffer_type_maps[map_type_name]))[object_name] = sai_object;
+            setReferencedObject(m_buffer_type_maps, map_type_name, object_name, sai_object);
             SWSS_LOG_NOTICE("Created buffer pool %s with type %s", object_name.c_str(), map_type_name.c_str());
         }
     }
@@ -220,8 +220,7 @@ task_process_status BufferOrch::processBufferPool(Consumer &consumer)
             return task_process_status::task_failed;
         }
         SWSS_LOG_NOTICE("Removed buffer pool %s with type %s", object_name.c_str(), map_type_name.c_str());
-        auto it_to_delete = (m_buffer_type_maps[map_type_name])->find(object_name);
-        (m_buffer_type_maps[map_type_name])->erase(it_to_delete);
+        removeReferencedObject(m_buffer_type_maps, map_type_name, object_name);
     }
     else
     {
@@ -345,7 +344,7 @@ task_process_status BufferOrch::processBufferProfile(Consumer &consumer)
                 SWSS_LOG_ERROR("Failed to create buffer profile %s with type %s, rv:%d", object_name.c_str(), map_type_name.c_str(), sai_status);
                 return task_process_status::task_failed;
             }
-            (*(m_buffer_type_maps[map_type_name]))[object_name] = sai_object;
+            setReferencedObject(m_buffer_type_maps, map_type_name, object_name, sai_object);
             SWSS_LOG_NOTICE("Created buffer profile %s with type %s", object_name.c_str(), map_type_name.c_str());
         }
     }
@@ -358,8 +357,7 @@ task_process_status BufferOrch::processBufferProfile(Consumer &consumer)
             return task_process_status::task_failed;
         }
         SWSS_LOG_NOTICE("Remove buffer profile %s with type %s", object_name.c_str(), map_type_name.c_str());
-        auto it_to_delete = (m_buffer_type_maps[map_type_name])->find(object_name);
-        (m_buffer_type_maps[map_type_name])->erase(it_to_delete);
+        removeReferencedObject(m_buffer_type_maps, map_type_name, object_name);
     }
     else
     {
@@ -635,7 +633,7 @@ task_process_status BufferOrch::processEgressBufferProfileList(Consumer &consume
     return task_process_status::task_success;
 }
 
-void BufferOrch::doTask()
+size_t BufferOrch::doTask()
 {
     // The hidden dependency tree:
     // ref: https://github.com/opencomputeproject/SAI/blob/master/doc/QOS/SAI-Proposal-buffers-Ver4.docx
@@ -651,10 +649,10 @@ void BufferOrch::doTask()
     //     └── buffer pq table
 
     auto pool_consumer = getExecutor((CFG_BUFFER_POOL_TABLE_NAME));
-    pool_consumer->drain();
+    size_t done = pool_consumer->drain();
 
     auto profile_consumer = getExecutor(CFG_BUFFER_PROFILE_TABLE_NAME);
-    profile_consumer->drain();
+    done += profile_consumer->drain();
 
     for(auto &it : m_consumerMap)
     {
@@ -663,8 +661,9 @@ void BufferOrch::doTask()
             continue;
         if (consumer == pool_consumer)
             continue;
-        consumer->drain();
+        done += consumer->drain();
     }
+    return done;
 }
 
 void BufferOrch::doTask(Consumer &consumer)
@@ -688,10 +687,20 @@ void BufferOrch::doTask(Consumer &consumer)
             continue;
         }
 
+        /* Updating an object re-applies the entries referencing it */
+        auto objects = m_buffer_type_maps.find(map_type_name);
+        bool update = kfvOp(it->second) == SET_COMMAND && objects != m_buffer_type_maps.end() &&
+                      objects->second->find(kfvKey(it->second)) != objects->second->end();
+
         auto task_status = (this->*(m_bufferHandlerMap[map_type_name]))(consumer);
         switch(task_status)
         {
             case task_process_status::task_success :
+                if (update)
+                {
+                    reapplyObjectDependents(object_reference(map_type_name, kfvKey(it->second)));
+                }
+                updateObjectDependents(m_buffer_type_maps, map_type_name, it->second);
                 it = consumer.m_toSync.erase(it);
                 break;
             case task_process_status::task_invalid_entry:
@@ -24,7 +24,9 @@ CounterCheckOrch& CounterCheckOrch::getInstance(DBConnector *db)
 CounterCheckOrch::CounterCheckOrch(DBConnector *db, vector<string> &tableNames):
     Orch(db, tableNames),
     m_countersDb(new DBConnector(COUNTERS_DB, DBConnector::DEFAULT_UNIXSOCKET, 0)),
-    m_countersTable(new Table(m_countersDb.get(), COUNTERS_TABLE))
+    m_countersTable(new Table(m_countersDb.get(), COUNTERS_TABLE)),
+    m_pollCountersDb(new DBConnector(COUNTERS_DB, DBConnector::DEFAULT_UNIXSOCKET, 0)),
+    m_pollCountersTable(new Table(m_pollCountersDb.get(), COUNTERS_TABLE))
 {
     SWSS_LOG_ENTER();
 
@@ -44,38 +46,71 @@ void CounterCheckOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
-    mcCounterCheck();
-    pfcFrameCounterCheck();
+    PortCounterSamples samples;
+
+    {
+        lock_guard<recursive_mutex> lock(gOrchStateMutex);
+        getPortSamples(samples);
+    }
+
+    /* Reading COUNTERS_DB is the slow part and doesn't touch any orch state */
+    for (auto& i : samples)
+    {
+        i.second.mcCounters = getQueueMcCounters(i.second.port, m_pollCountersDb.get(), *m_pollCountersTable);
+        i.second.pfcFrameCounters = getPfcFrameCounters(i.first, *m_pollCountersTable);
+    }
+
+    lock_guard<recursive_mutex> lock(gOrchStateMutex);
+
+    mcCounterCheck(samples);
+    pfcFrameCounterCheck(samples);
 }
 
-void CounterCheckOrch::mcCounterCheck()
+void CounterCheckOrch::getPortSamples(PortCounterSamples &samples)
 {
     SWSS_LOG_ENTER();
 
-    for (auto& i : m_mcCountersMap)
+    for (const auto& i : m_mcCountersMap)
     {
         auto oid = i.first;
-        auto mcCounters = i.second;
-        uint8_t pfcMask = 0;
+        PortCounterSample sample;
 
-        Port port;
-        if (!gPortsOrch->getPort(oid, port))
+        if (!gPortsOrch->getPort(oid, sample.port))
         {
             SWSS_LOG_ERROR("Invalid port oid 0x%lx", oid);
             continue;
         }
 
-        auto newMcCounters = getQueueMcCounters(port);
+        if (!gPortsOrch->getPortPfc(sample.port.m_port_id, &sample.pfcMask))
+        {
+            SWSS_LOG_ERROR("Failed to get PFC mask on port %s", sample.port.m_alias.c_str());
+            continue;
+        }
 
-        if (!gPortsOrch->getPortPfc(port.m_port_id, &pfcMask))
+        samples.emplace(oid, move(sample));
+    }
+}
+
+void CounterCheckOrch::mcCounterCheck(const PortCounterSamples &samples)
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto& s : samples)
+    {
+        /* Port may have been removed while its counters were being read */
+        auto i = m_mcCountersMap.find(s.first);
+        if (i == m_mcCountersMap.end())
         {
-            SWSS_LOG_ERROR("Failed to get PFC mask on port %s", port.m_alias.c_str());
             continue;
         }
 
-        for (size_t prio = 0; prio != mcCounters.size(); prio++)
+        const auto& mcCounters = i->second;
+        const auto& newMcCounters = s.second.mcCounters;
+        const auto& port = s.second.port;
+
+        for (size_t prio = 0; prio != mcCounters.size() && prio != newMcCounters.size(); prio++)
         {
-            bool isLossy = ((1 << prio) & pfcMask) == 0;
+            bool isLossy = ((1 << prio) & s.second.pfcMask) == 0;
             if (newMcCounters[prio] == numeric_limits<uint64_t>::max())
             {
                 SWSS_LOG_WARN("Could not retreive MC counters on queue %lu port %s",
@@ -91,37 +126,29 @@ void CounterCheckOrch::mcCounterCheck()
             }
         }
 
-        i.second= newMcCounters;
+        i->second = newMcCounters;
     }
 }
 
-void CounterCheckOrch::pfcFrameCounterCheck()
+void CounterCheckOrch::pfcFrameCounterCheck(const PortCounterSamples &samples)
 {
     SWSS_LOG_ENTER();
 
-    for (auto& i : m_pfcFrameCountersMap)
+    for (const auto& s : samples)
     {
-        auto oid = i.first;
-        auto counters = i.second;
-        auto newCounters = getPfcFrameCounters(oid);
-        uint8_t pfcMask = 0;
-
-        Port port;
-        if (!gPortsOrch->getPort(oid, port))
+        auto i = m_pfcFrameCountersMap.find(s.first);
+        if (i == m_pfcFrameCountersMap.end())
         {
-            SWSS_LOG_ERROR("Invalid port oid 0x%lx", oid);
             continue;
         }
 
-        if (!gPortsOrch->getPortPfc(port.m_port_id, &pfcMask))
-        {
-            SWSS_LOG_ERROR("Failed to get PFC mask on port %s", port.m_alias.c_str());
-            continue;
-        }
+        const auto& counters = i->second;
+        const auto& newCounters = s.second.pfcFrameCounters;
+        const auto& port = s.second.port;
 
         for (size_t prio = 0; prio != counters.size(); prio++)
         {
-            bool isLossy = ((1 << prio) & pfcMask) == 0;
+            bool isLossy = ((1 << prio) & s.second.pfcMask) == 0;
             if (newCounters[prio] == numeric_limits<uint64_t>::max())
             {
                 SWSS_LOG_WARN("Could not retreive PFC frame count on queue %lu port %s",
@@ -137,12 +164,12 @@ void CounterCheckOrch::pfcFrameCounterCheck()
             }
         }
 
-        i.second = newCounters;
+        i->second = newCounters;
     }
 }
 
 
-PfcFrameCounters CounterCheckOrch::getPfcFrameCounters(sai_object_id_t portId)
+PfcFrameCounters CounterCheckOrch::getPfcFrameCounters(sai_object_id_t portId, Table &countersTable)
 {
     SWSS_LOG_ENTER();
 
@@ -162,7 +189,7 @@ PfcFrameCounters CounterCheckOrch::getPfcFrameCounters(sai_object_id_t portId)
         "SAI_PORT_STAT_PFC_7_RX_PKTS"
     };
 
-    if (!m_countersTable->get(sai_serialize_object_id(portId), fieldValues))
+    if (!countersTable.get(sai_serialize_object_id(portId), fieldValues))
     {
         return move(counters);
     }
@@ -186,13 +213,13 @@ PfcFrameCounters CounterCheckOrch::getPfcFrameCounters(sai_object_id_t portId)
 }
 
 QueueMcCounters CounterCheckOrch::getQueueMcCounters(
-        const Port& port)
+        const Port& port, DBConnector *db, Table &countersTable)
 {
     SWSS_LOG_ENTER();
 
     vector<FieldValueTuple> fieldValues;
     QueueMcCounters counters;
-    RedisClient redisClient(m_countersDb.get());
+    RedisClient redisClient(db);
 
     for (uint8_t prio = 0; prio < port.m_queue_ids.size(); prio++)
     {
@@ -200,7 +227,7 @@ QueueMcCounters CounterCheckOrch::getQueueMcCounters(
         auto queueIdStr = sai_serialize_object_id(queueId);
         auto queueType = redisClient.hget(COUNTERS_QUEUE_TYPE_MAP, queueIdStr);
 
-        if (queueType.get() == nullptr || *queueType != "SAI_QUEUE_TYPE_MULTICAST" || !m_countersTable->get(queueIdStr, fieldValues))
+        if (queueType.get() == nullptr || *queueType != "SAI_QUEUE_TYPE_MULTICAST" || !countersTable.get(queueIdStr, fieldValues))
         {
             continue;
         }
@@ -225,8 +252,8 @@ QueueMcCounters CounterCheckOrch::getQueueMcCounters(
 
 void CounterCheckOrch::addPort(const Port& port)
 {
-    m_mcCountersMap.emplace(port.m_port_id, getQueueMcCounters(port));
-    m_pfcFrameCountersMap.emplace(port.m_port_id, getPfcFrameCounters(port.m_port_id));
+    m_mcCountersMap.emplace(port.m_port_id, getQueueMcCounters(port, m_countersDb.get(), *m_countersTable));
+    m_pfcFrameCountersMap.emplace(port.m_port_id, getPfcFrameCounters(port.m_port_id, *m_countersTable));
 }
 
 void CounterCheckOrch::removePort(const Port& port)
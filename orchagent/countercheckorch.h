@@ -25,18 +25,33 @@ public:
     void removePort(const Port& port);
 
 private:
+    /* Port state and counters read in one poll, compared against the previous poll */
+    struct PortCounterSample
+    {
+        Port port;
+        uint8_t pfcMask = 0;
+        QueueMcCounters mcCounters;
+        PfcFrameCounters pfcFrameCounters;
+    };
+
+    typedef map<sai_object_id_t, PortCounterSample> PortCounterSamples;
+
     CounterCheckOrch(DBConnector *db, vector<string> &tableNames);
     virtual ~CounterCheckOrch(void);
-    QueueMcCounters getQueueMcCounters(const Port& port);
-    PfcFrameCounters getPfcFrameCounters(sai_object_id_t portId);
-    void mcCounterCheck();
-    void pfcFrameCounterCheck();
+    QueueMcCounters getQueueMcCounters(const Port& port, DBConnector *db, Table &countersTable);
+    PfcFrameCounters getPfcFrameCounters(sai_object_id_t portId, Table &countersTable);
+    void getPortSamples(PortCounterSamples &samples);
+    void mcCounterCheck(const PortCounterSamples &samples);
+    void pfcFrameCounterCheck(const PortCounterSamples &samples);
 
     map<sai_object_id_t, QueueMcCounters> m_mcCountersMap;
     map<sai_object_id_t, PfcFrameCounters> m_pfcFrameCountersMap;
 
     shared_ptr<DBConnector> m_countersDb = nullptr;
     shared_ptr<Table> m_countersTable = nullptr;
+    /* Used by the poll timer only, so that polling never shares a connection with addPort() */
+    shared_ptr<DBConnector> m_pollCountersDb = nullptr;
+    shared_ptr<Table> m_pollCountersTable = nullptr;
 };
 
 #endif
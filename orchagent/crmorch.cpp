@@ -284,13 +284,13 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
     }
 }
 
-void CrmOrch::incCrmResUsedCounter(CrmResourceType resource)
+void CrmOrch::incCrmResUsedCounter(CrmResourceType resource, uint32_t count)
 {
     SWSS_LOG_ENTER();
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter++;
+        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter += count;
     }
     catch (...)
     {
@@ -299,13 +299,13 @@ void CrmOrch::incCrmResUsedCounter(CrmResourceType resource)
     }
 }
 
-void CrmOrch::decCrmResUsedCounter(CrmResourceType resource)
+void CrmOrch::decCrmResUsedCounter(CrmResourceType resource, uint32_t count)
 {
     SWSS_LOG_ENTER();
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter--;
+        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter -= count;
     }
     catch (...)
     {
@@ -396,25 +396,50 @@ void CrmOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
-    getResAvailableCounters();
-    updateCrmCountersTable();
-    checkCrmThresholds();
+    /*
+     * The timer may run on the telemetry worker, while other orchs keep
+     * updating the "used" counters from the main loop. Only the SAI queries
+     * and the COUNTERS_DB writes, which are the slow part, run unlocked.
+     */
+    vector<CrmAvailQuery> queries;
+    CrmCountersSnapshot snapshot;
+    timespec interv;
+
+    {
+        lock_guard<recursive_mutex> lock(gOrchStateMutex);
+        if (!getResAvailableQueries(queries))
+        {
+            queries.clear();
+        }
+    }
+
+    getResAvailableCounters(queries);
+
+    {
+        lock_guard<recursive_mutex> lock(gOrchStateMutex);
+        setResAvailableCounters(queries);
+        getCrmCountersSnapshot(snapshot);
+        checkCrmThresholds();
+        interv = timespec { .tv_sec = m_pollingInterval.count(), .tv_nsec = 0 };
+    }
+
+    updateCrmCountersTable(snapshot);
 
-    auto interv = timespec { .tv_sec = m_pollingInterval.count(), .tv_nsec = 0 };
     timer.setInterval(interv);
     timer.reset();
 }
 
-void CrmOrch::getResAvailableCounters()
+bool CrmOrch::getResAvailableQueries(vector<CrmAvailQuery> &queries)
 {
     SWSS_LOG_ENTER();
 
-    for (auto &res : m_resourcesMap)
+    for (const auto &res : m_resourcesMap)
     {
-        sai_attribute_t attr;
-        attr.id = crmResSaiAvailAttrMap.at(res.first);
+        CrmAvailQuery query;
+        query.resource = res.first;
+        query.attrId = crmResSaiAvailAttrMap.at(res.first);
 
-        switch (attr.id)
+        switch (query.attrId)
         {
             case SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY:
             case SAI_SWITCH_ATTR_AVAILABLE_IPV6_ROUTE_ENTRY:
@@ -425,19 +450,41 @@ void CrmOrch::getResAvailableCounters()
             case SAI_SWITCH_ATTR_AVAILABLE_NEXT_HOP_GROUP_MEMBER_ENTRY:
             case SAI_SWITCH_ATTR_AVAILABLE_NEXT_HOP_GROUP_ENTRY:
             case SAI_SWITCH_ATTR_AVAILABLE_FDB_ENTRY:
-            {
-                sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
-                if (status != SAI_STATUS_SUCCESS)
+            case SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE:
+            case SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE_GROUP:
+                queries.push_back(query);
+                break;
+
+            case SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_ENTRY:
+            case SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER:
+                for (const auto &cnt : res.second.countersMap)
                 {
-                    SWSS_LOG_ERROR("Failed to get switch attribute %u , rv:%d", attr.id, status);
-                    break;
+                    query.tableId = cnt.second.id;
+                    query.key = cnt.first;
+                    queries.push_back(query);
                 }
+                break;
 
-                res.second.countersMap[CRM_COUNTERS_TABLE_KEY].availableCounter = attr.value.u32;
+            default:
+                SWSS_LOG_ERROR("Failed to get CRM attribute %u. Unknown attribute.\n", query.attrId);
+                return false;
+        }
+    }
 
-                break;
-            }
+    return true;
+}
 
+void CrmOrch::getResAvailableCounters(vector<CrmAvailQuery> &queries)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &query : queries)
+    {
+        sai_attribute_t attr;
+        attr.id = query.attrId;
+
+        switch (attr.id)
+        {
             case SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE:
             case SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE_GROUP:
             {
@@ -462,7 +509,7 @@ void CrmOrch::getResAvailableCounters()
                 for (uint32_t i = 0; i < attr.value.aclresource.count; i++)
                 {
                     string key = getCrmAclKey(attr.value.aclresource.list[i].stage, attr.value.aclresource.list[i].bind_point);
-                    res.second.countersMap[key].availableCounter = attr.value.aclresource.list[i].avail_num;
+                    query.results.emplace_back(key, attr.value.aclresource.list[i].avail_num);
                 }
 
                 break;
@@ -471,55 +518,96 @@ void CrmOrch::getResAvailableCounters()
             case SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_ENTRY:
             case SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER:
             {
-                for (auto &cnt : res.second.countersMap)
+                sai_status_t status = sai_acl_api->get_acl_table_attribute(query.tableId, 1, &attr);
+                if (status != SAI_STATUS_SUCCESS)
                 {
-                    sai_status_t status = sai_acl_api->get_acl_table_attribute(cnt.second.id, 1, &attr);
-                    if (status != SAI_STATUS_SUCCESS)
-                    {
-                        SWSS_LOG_ERROR("Failed to get ACL table attribute %u , rv:%d", attr.id, status);
-                        break;
-                    }
-
-                    cnt.second.availableCounter = attr.value.u32;
+                    SWSS_LOG_ERROR("Failed to get ACL table attribute %u , rv:%d", attr.id, status);
+                    break;
                 }
 
+                query.results.emplace_back(query.key, attr.value.u32);
+
                 break;
             }
 
             default:
-                SWSS_LOG_ERROR("Failed to get CRM attribute %u. Unknown attribute.\n", attr.id);
-                return;
+            {
+                sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+                if (status != SAI_STATUS_SUCCESS)
+                {
+                    SWSS_LOG_ERROR("Failed to get switch attribute %u , rv:%d", attr.id, status);
+                    break;
+                }
+
+                query.results.emplace_back(CRM_COUNTERS_TABLE_KEY, attr.value.u32);
+
+                break;
+            }
         }
     }
 }
 
-void CrmOrch::updateCrmCountersTable()
+void CrmOrch::setResAvailableCounters(const vector<CrmAvailQuery> &queries)
 {
     SWSS_LOG_ENTER();
 
-    // Update CRM used counters in COUNTERS_DB
+    for (const auto &query : queries)
+    {
+        auto &countersMap = m_resourcesMap.at(query.resource).countersMap;
+
+        for (const auto &result : query.results)
+        {
+            if (query.tableId == SAI_NULL_OBJECT_ID)
+            {
+                countersMap[result.first].availableCounter = result.second;
+                continue;
+            }
+
+            // ACL table may have been removed while its counters were being queried
+            auto it = countersMap.find(result.first);
+            if (it != countersMap.end() && it->second.id == query.tableId)
+            {
+                it->second.availableCounter = result.second;
+            }
+        }
+    }
+}
+
+void CrmOrch::getCrmCountersSnapshot(CrmCountersSnapshot &snapshot)
+{
+    SWSS_LOG_ENTER();
+
+    // CRM used counters
     for (const auto &i : crmUsedCntsTableMap)
     {
         for (const auto &cnt : m_resourcesMap.at(i.second).countersMap)
         {
-            FieldValueTuple attr(i.first, to_string(cnt.second.usedCounter));
-            vector<FieldValueTuple> attrs = { attr };
-            m_countersCrmTable->set(cnt.first, attrs);
+            snapshot.emplace_back(cnt.first, FieldValueTuple(i.first, to_string(cnt.second.usedCounter)));
         }
     }
 
-    // Update CRM available counters in COUNTERS_DB
+    // CRM available counters
     for (const auto &i : crmAvailCntsTableMap)
     {
         for (const auto &cnt : m_resourcesMap.at(i.second).countersMap)
         {
-            FieldValueTuple attr(i.first, to_string(cnt.second.availableCounter));
-            vector<FieldValueTuple> attrs = { attr };
-            m_countersCrmTable->set(cnt.first, attrs);
+            snapshot.emplace_back(cnt.first, FieldValueTuple(i.first, to_string(cnt.second.availableCounter)));
         }
     }
 }
 
+void CrmOrch::updateCrmCountersTable(const CrmCountersSnapshot &snapshot)
+{
+    SWSS_LOG_ENTER();
+
+    // Update CRM used and available counters in COUNTERS_DB
+    for (const auto &cnt : snapshot)
+    {
+        vector<FieldValueTuple> attrs = { cnt.second };
+        m_countersCrmTable->set(cnt.first, attrs);
+    }
+}
+
 void CrmOrch::checkCrmThresholds()
 {
     SWSS_LOG_ENTER();
@@ -38,8 +38,8 @@ class CrmOrch : public Orch
 {
 public:
     CrmOrch(DBConnector *db, string tableName);
-    void incCrmResUsedCounter(CrmResourceType resource);
-    void decCrmResUsedCounter(CrmResourceType resource);
+    void incCrmResUsedCounter(CrmResourceType resource, uint32_t count = 1);
+    void decCrmResUsedCounter(CrmResourceType resource, uint32_t count = 1);
     // Increment "used" counter for the ACL table/group CRM resources
     void incCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t stage, sai_acl_bind_point_type_t point);
     // Decrement "used" counter for the ACL table/group CRM resources
@@ -80,11 +80,28 @@ private:
 
     map<CrmResourceType, CrmResourceEntry> m_resourcesMap;
 
+    /* A single "available" counter query, built under the orch state lock and run without it */
+    struct CrmAvailQuery
+    {
+        CrmResourceType resource;
+        sai_attr_id_t attrId;
+        // ACL table and its counters map key, for the per ACL table resources
+        sai_object_id_t tableId = SAI_NULL_OBJECT_ID;
+        string key;
+        // Counters map key and available counter pairs returned by SAI
+        vector<pair<string, uint32_t>> results;
+    };
+
+    typedef vector<pair<string, FieldValueTuple>> CrmCountersSnapshot;
+
     void doTask(Consumer &consumer);
     void handleSetCommand(const string& key, const vector<FieldValueTuple>& data);
     void doTask(SelectableTimer &timer);
-    void getResAvailableCounters();
-    void updateCrmCountersTable();
+    bool getResAvailableQueries(vector<CrmAvailQuery> &queries);
+    void getResAvailableCounters(vector<CrmAvailQuery> &queries);
+    void setResAvailableCounters(const vector<CrmAvailQuery> &queries);
+    void getCrmCountersSnapshot(CrmCountersSnapshot &snapshot);
+    void updateCrmCountersTable(const CrmCountersSnapshot &snapshot);
     void checkCrmThresholds();
     string getCrmAclKey(sai_acl_stage_t stage, sai_acl_bind_point_type_t bindPoint);
     string getCrmAclTableKey(sai_object_id_t id);
@@ -0,0 +1,42 @@
+#include "flexcounterbatch.h"
+
+#include "logger.h"
+#include "schema.h"
+
+using namespace std;
+using namespace swss;
+
+FlexCounterBatch::FlexCounterBatch(DBConnector *db) :
+    m_pipeline(db),
+    m_table(&m_pipeline, FLEX_COUNTER_TABLE, true)
+{
+}
+
+void FlexCounterBatch::add(const string &group, const string &object,
+                           const string &field, const string &counterIds)
+{
+    vector<FieldValueTuple> fieldValues;
+    fieldValues.emplace_back(field, counterIds);
+
+    m_table.set(group + ":" + object, fieldValues);
+    m_pending++;
+}
+
+void FlexCounterBatch::remove(const string &group, const string &object)
+{
+    m_table.del(group + ":" + object);
+    m_pending++;
+}
+
+void FlexCounterBatch::flush()
+{
+    if (m_pending == 0)
+    {
+        return;
+    }
+
+    m_pipeline.flush();
+
+    SWSS_LOG_INFO("Flushed %zu flex counter updates", m_pending);
+    m_pending = 0;
+}
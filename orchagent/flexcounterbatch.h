@@ -0,0 +1,58 @@
+#ifndef SWSS_FLEXCOUNTERBATCH_H
+#define SWSS_FLEXCOUNTERBATCH_H
+
+#include <string>
+#include <vector>
+
+#include "dbconnector.h"
+#include "producertable.h"
+
+/*
+ * Comma joined list of serialized counter ids, as expected in the
+ * *_COUNTER_ID_LIST fields of FLEX_COUNTER_TABLE entries. Meant to be built
+ * once per list rather than once per registered object.
+ */
+template <typename StatId, typename Serialize>
+std::string serializeCounterIds(const std::vector<StatId> &ids, Serialize serialize)
+{
+    std::string list;
+
+    for (const auto &id : ids)
+    {
+        if (!list.empty())
+        {
+            list += ',';
+        }
+        list += serialize(id);
+    }
+
+    return list;
+}
+
+/*
+ * Registrations and removals of objects in FLEX_COUNTER_TABLE, accumulated
+ * on a Redis pipeline and written to FLEX_COUNTER_DB when flush() is called.
+ */
+class FlexCounterBatch
+{
+public:
+    FlexCounterBatch(swss::DBConnector *db);
+
+    /* Poll counters 'counterIds' of 'object' in counter 'group' */
+    void add(const std::string &group, const std::string &object,
+             const std::string &field, const std::string &counterIds);
+    /* Stop polling the counters of 'object' in counter 'group' */
+    void remove(const std::string &group, const std::string &object);
+
+    /* Write all pending registrations and removals */
+    void flush();
+
+    size_t pending() const { return m_pending; }
+
+private:
+    swss::RedisPipeline m_pipeline;
+    swss::ProducerTable m_table;
+    size_t m_pending = 0;
+};
+
+#endif /* SWSS_FLEXCOUNTERBATCH_H */
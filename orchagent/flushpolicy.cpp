@@ -0,0 +1,60 @@
+#include "flushpolicy.h"
+
+#include <algorithm>
+
+using namespace std;
+
+FlushPolicy::FlushPolicy(size_t maxOps, chrono::milliseconds maxDelay) :
+    m_maxOps(maxOps),
+    m_maxDelay(maxDelay)
+{
+}
+
+void FlushPolicy::add(size_t ops, chrono::steady_clock::time_point now)
+{
+    if (ops == 0)
+    {
+        return;
+    }
+
+    if (m_pending == 0)
+    {
+        m_oldest = now;
+    }
+    m_pending += ops;
+}
+
+bool FlushPolicy::due(bool idle, chrono::steady_clock::time_point now) const
+{
+    if (m_pending == 0)
+    {
+        return false;
+    }
+
+    return idle || m_pending >= m_maxOps || now - m_oldest >= m_maxDelay;
+}
+
+void FlushPolicy::flushed(chrono::steady_clock::time_point now)
+{
+    if (m_pending == 0)
+    {
+        return;
+    }
+
+    uint64_t usec = chrono::duration_cast<chrono::microseconds>(now - m_oldest).count();
+
+    m_stats.flushes++;
+    m_stats.ops += m_pending;
+    m_stats.totalDelayUsec += usec;
+    m_stats.maxDelayUsec = max(m_stats.maxDelayUsec, usec);
+
+    m_pending = 0;
+}
+
+FlushPolicy::Stats FlushPolicy::takeStats()
+{
+    Stats stats = m_stats;
+
+    m_stats = { 0, 0, 0, 0 };
+    return stats;
+}
@@ -0,0 +1,51 @@
+#ifndef SWSS_FLUSHPOLICY_H
+#define SWSS_FLUSHPOLICY_H
+
+#include <chrono>
+#include <stdint.h>
+
+/* Defaults of orchagent -f and -l */
+#define DEFAULT_FLUSH_MAX_OPS           1024
+#define DEFAULT_FLUSH_MAX_DELAY_MSECS   10
+
+/*
+ * When to flush the sairedis pipeline. Operations are flushed as soon as the
+ * event loop goes idle; while events keep coming, they are held until
+ * 'maxOps' of them are pending or the oldest has waited for 'maxDelay'.
+ */
+class FlushPolicy
+{
+public:
+    FlushPolicy(size_t maxOps, std::chrono::milliseconds maxDelay);
+
+    /* Account for 'ops' operations issued since the last flush */
+    void add(size_t ops, std::chrono::steady_clock::time_point now);
+
+    /* Whether to flush now, given the event loop has nothing more to do or not */
+    bool due(bool idle, std::chrono::steady_clock::time_point now) const;
+
+    /* Account for a flush of all pending operations */
+    void flushed(std::chrono::steady_clock::time_point now);
+
+    size_t pending() const { return m_pending; }
+
+    struct Stats
+    {
+        uint64_t flushes;
+        uint64_t ops;
+        uint64_t totalDelayUsec;    // time the oldest operation of each flush was held
+        uint64_t maxDelayUsec;
+    };
+
+    /* Flushes since the previous call */
+    Stats takeStats();
+
+private:
+    size_t m_maxOps;
+    std::chrono::milliseconds m_maxDelay;
+    size_t m_pending = 0;
+    std::chrono::steady_clock::time_point m_oldest;
+    Stats m_stats = { 0, 0, 0, 0 };
+};
+
+#endif /* SWSS_FLUSHPOLICY_H */
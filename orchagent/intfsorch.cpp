@@ -56,8 +56,9 @@ IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch) :
     m_flex_db = shared_ptr<DBConnector>(new DBConnector(FLEX_COUNTER_DB, DBConnector::DEFAULT_UNIXSOCKET, 0));
     m_asic_db = shared_ptr<DBConnector>(new DBConnector(ASIC_DB, DBConnector::DEFAULT_UNIXSOCKET, 0));
     /* Initialize COUNTER_DB tables */
-    m_rifNameTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_RIF_NAME_MAP));
-    m_rifTypeTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_RIF_TYPE_MAP));
+    m_counterPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_counter_db.get()));
+    m_rifNameTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_RIF_NAME_MAP, true));
+    m_rifTypeTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_RIF_TYPE_MAP, true));
 
     m_vidToRidTable = unique_ptr<Table>(new Table(m_asic_db.get(), "VIDTORID"));
     auto intervT = timespec { .tv_sec = UPDATE_MAPS_SEC , .tv_nsec = 0 };
@@ -65,7 +66,7 @@ IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch) :
     auto executorT = new ExecutableTimer(m_updateMapsTimer, this, "UPDATE_MAPS_TIMER");
     Orch::addExecutor(executorT);
     /* Initialize FLEX_COUNTER_DB tables */
-    m_flexCounterTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_TABLE));
+    m_flexCounters = unique_ptr<FlexCounterBatch>(new FlexCounterBatch(m_flex_db.get()));
     m_flexCounterGroupTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_GROUP_TABLE));
 
     vector<FieldValueTuple> fieldValues;
@@ -738,9 +739,13 @@ void IntfsOrch::removeDirectedBroadcast(const Port &port, const IpPrefix &ip_pre
     SWSS_LOG_NOTICE("Remove broadcast route ip:%s", ip_addr.to_string().c_str());
 }
 
+/* Registrations are written out by the caller with flushRifCounters() */
 void IntfsOrch::addRifToFlexCounter(const string &id, const string &name, const string &type)
 {
     SWSS_LOG_ENTER();
+
+    static const string rifCounterIds = serializeCounterIds(rifStatIds, sai_serialize_router_interface_stat);
+
     /* update RIF maps in COUNTERS_DB */
     vector<FieldValueTuple> rifNameVector;
     vector<FieldValueTuple> rifTypeVector;
@@ -752,21 +757,7 @@ void IntfsOrch::addRifToFlexCounter(const string &id, const string &name, const
     m_rifTypeTable->set("", rifTypeVector);
 
     /* update RIF in FLEX_COUNTER_DB */
-    string key = getRifFlexCounterTableKey(id);
-
-
-    std::ostringstream counters_stream;
-    for (const auto& it: rifStatIds)
-    {
-        counters_stream << sai_serialize_router_interface_stat(it) << comma;
-    }
-
-    /* check the state of intf, if registering the intf to FC will result in runtime error */
-    vector<FieldValueTuple> fvt;
-    vector<FieldValueTuple> fieldValues;
-    fieldValues.emplace_back(RIF_COUNTER_ID_LIST, counters_stream.str());
-
-    m_flexCounterTable->set(key, fieldValues);
+    m_flexCounters->add(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP, id, RIF_COUNTER_ID_LIST, rifCounterIds);
     SWSS_LOG_DEBUG("Registered interface %s to Flex counter", name.c_str());
 }
 
@@ -778,18 +769,16 @@ void IntfsOrch::removeRifFromFlexCounter(const string &id, const string &name)
     m_rifTypeTable->hdel("", id);
 
     /* remove it from FLEX_COUNTER_DB */
-    string key = getRifFlexCounterTableKey(id);
+    m_flexCounters->remove(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP, id);
 
-    vector<FieldValueTuple> fieldValues;
-    fieldValues.emplace_back(RIF_COUNTER_ID_LIST, "");
-
-    m_flexCounterTable->set(key, fieldValues);
+    flushRifCounters();
     SWSS_LOG_DEBUG("Unregistered interface %s from Flex counter", name.c_str());
 }
 
-string IntfsOrch::getRifFlexCounterTableKey(string key)
+void IntfsOrch::flushRifCounters()
 {
-    return string(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP) + ":" + key;
+    m_counterPipeline->flush();
+    m_flexCounters->flush();
 }
 
 void IntfsOrch::generateInterfaceMap()
@@ -833,4 +822,6 @@ void IntfsOrch::doTask(SelectableTimer &timer)
             ++it;
         }
     }
+
+    flushRifCounters();
 }
\ No newline at end of file
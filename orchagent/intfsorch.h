@@ -5,6 +5,7 @@
 #include "portsorch.h"
 #include "vrforch.h"
 #include "timer.h"
+#include "flexcounterbatch.h"
 
 #include "ipaddresses.h"
 #include "ipprefix.h"
@@ -42,6 +43,7 @@ public:
     void generateInterfaceMap();
     void addRifToFlexCounter(const string&, const string&, const string&);
     void removeRifFromFlexCounter(const string&, const string&);
+    void flushRifCounters();
 
     bool setIntf(const string& alias, sai_object_id_t vrf_id = gVirtualRouterId, const IpPrefix *ip_prefix = nullptr);
 
@@ -70,11 +72,10 @@ private:
     unique_ptr<Table> m_rifNameTable;
     unique_ptr<Table> m_rifTypeTable;
     unique_ptr<Table> m_vidToRidTable;
-    unique_ptr<ProducerTable> m_flexCounterTable;
+    unique_ptr<RedisPipeline> m_counterPipeline;
+    unique_ptr<FlexCounterBatch> m_flexCounters;
     unique_ptr<ProducerTable> m_flexCounterGroupTable;
 
-    std::string getRifFlexCounterTableKey(std::string s);
-
     int getRouterIntfsRefCount(const string&);
 
     bool addRouterIntfs(sai_object_id_t vrf_id, Port &port);
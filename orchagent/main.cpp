@@ -46,12 +46,16 @@ int gBatchSize = DEFAULT_BATCH_SIZE;
 bool gSairedisRecord = true;
 bool gSwssRecord = true;
 bool gLogRotate = false;
+bool gTelemetryWorker = false;
+bool gRouteRing = false;
+size_t gFlushMaxOps = DEFAULT_FLUSH_MAX_OPS;
+int gFlushMaxDelay = DEFAULT_FLUSH_MAX_DELAY_MSECS;
 ofstream gRecordOfs;
 string gRecordFile;
 
 void usage()
 {
-    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-b batch_size] [-m MAC]" << endl;
+    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-b batch_size] [-m MAC] [-w] [-R] [-f flush_ops] [-l flush_latency]" << endl;
     cout << "    -h: display this message" << endl;
     cout << "    -r record_type: record orchagent logs with type (default 3)" << endl;
     cout << "                    0: do not record logs" << endl;
@@ -61,6 +65,10 @@ void usage()
     cout << "    -d record_location: set record logs folder location (default .)" << endl;
     cout << "    -b batch_size: set consumer table pop operation batch size (default 128)" << endl;
     cout << "    -m MAC: set switch MAC address" << endl;
+    cout << "    -w: run telemetry orchs (CRM, watermark, counter check) on a worker thread" << endl;
+    cout << "    -R: let fpmsyncd send routes through a shared memory ring, bypassing APP_DB" << endl;
+    cout << "    -f flush_ops: while busy, flush sairedis pipeline once this many operations, retries included, are pending (default " << DEFAULT_FLUSH_MAX_OPS << ")" << endl;
+    cout << "    -l flush_latency: while busy, flush sairedis pipeline once an operation is pending for this many ms (default " << DEFAULT_FLUSH_MAX_DELAY_MSECS << ")" << endl;
 }
 
 void sighup_handler(int signo)
@@ -117,7 +125,7 @@ int main(int argc, char **argv)
 
     string record_location = ".";
 
-    while ((opt = getopt(argc, argv, "b:m:r:d:h")) != -1)
+    while ((opt = getopt(argc, argv, "b:m:r:d:hwRf:l:")) != -1)
     {
         switch (opt)
         {
@@ -159,6 +167,18 @@ int main(int argc, char **argv)
                 exit(EXIT_FAILURE);
             }
             break;
+        case 'w':
+            gTelemetryWorker = true;
+            break;
+        case 'R':
+            gRouteRing = true;
+            break;
+        case 'f':
+            gFlushMaxOps = (size_t)atoi(optarg);
+            break;
+        case 'l':
+            gFlushMaxDelay = atoi(optarg);
+            break;
         case 'h':
             usage();
             exit(EXIT_SUCCESS);
@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <chrono>
 #include "neighorch.h"
 #include "logger.h"
 #include "swssnet.h"
@@ -19,6 +20,9 @@ NeighOrch::NeighOrch(DBConnector *db, string tableName, IntfsOrch *intfsOrch) :
         Orch(db, tableName, neighorch_pri), m_intfsOrch(intfsOrch)
 {
     SWSS_LOG_ENTER();
+
+    m_stateDb = make_shared<DBConnector>(STATE_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
+    m_statePortNextHopTable = unique_ptr<Table>(new Table(m_stateDb.get(), STATE_PORT_NEXTHOP_TABLE_NAME));
 }
 
 bool NeighOrch::hasNextHop(IpAddress ipAddress)
@@ -68,14 +72,7 @@ bool NeighOrch::addNextHop(IpAddress ipAddress, string alias)
     SWSS_LOG_NOTICE("Created next hop %s on %s",
                     ipAddress.to_string().c_str(), alias.c_str());
 
-    NextHopEntry next_hop_entry;
-    next_hop_entry.next_hop_id = next_hop_id;
-    next_hop_entry.ref_count = 0;
-    next_hop_entry.nh_flags = 0;
-    next_hop_entry.if_alias = alias;
-    m_syncdNextHops[ipAddress] = next_hop_entry;
-
-    m_intfsOrch->increaseRouterIntfsRefCount(alias);
+    syncNextHop(ipAddress, alias, next_hop_id);
 
     if (ipAddress.isV4())
     {
@@ -101,6 +98,20 @@ bool NeighOrch::addNextHop(IpAddress ipAddress, string alias)
     return true;
 }
 
+/* Record a next hop created in SAI, CRM accounting is left to the caller */
+void NeighOrch::syncNextHop(const IpAddress &ipAddress, const string &alias, sai_object_id_t next_hop_id)
+{
+    NextHopEntry next_hop_entry;
+    next_hop_entry.next_hop_id = next_hop_id;
+    next_hop_entry.ref_count = 0;
+    next_hop_entry.nh_flags = 0;
+    next_hop_entry.if_alias = alias;
+    m_syncdNextHops[ipAddress] = next_hop_entry;
+    m_portNextHops[alias].insert(ipAddress);
+
+    m_intfsOrch->increaseRouterIntfsRefCount(alias);
+}
+
 bool NeighOrch::setNextHopFlag(const IpAddress &ipaddr, const uint32_t nh_flag)
 {
     SWSS_LOG_ENTER();
@@ -175,37 +186,68 @@ bool NeighOrch::isNextHopFlagSet(const IpAddress &ipaddr, const uint32_t nh_flag
     return false;
 }
 
+/*
+ * Propagate an i/f oper status change to the next hops on it. On i/f down,
+ * the next hop group members of all its next hops are removed in one batch.
+ * The time spent is published to STATE_DB PORT_NEXTHOP_TABLE.
+ */
 bool NeighOrch::ifChangeInformNextHop(const string &alias, bool if_up)
 {
     SWSS_LOG_ENTER();
     bool rc = true;
 
-    for (auto nhop = m_syncdNextHops.begin(); nhop != m_syncdNextHops.end(); ++nhop)
+    auto port = m_portNextHops.find(alias);
+    if (port == m_portNextHops.end())
     {
-        if (nhop->second.if_alias != alias)
-        {
-            continue;
-        }
+        return rc;
+    }
 
-        if (if_up)
-        {
-            rc = clearNextHopFlag(nhop->first, NHFLAGS_IFDOWN);
-        }
-        else
-        {
-            rc = setNextHopFlag(nhop->first, NHFLAGS_IFDOWN);
-        }
+    auto start = chrono::steady_clock::now();
+    size_t members = 0;
 
-        if (rc == true)
+    if (if_up)
+    {
+        for (const auto &ip : port->second)
         {
-            continue;
+            rc = clearNextHopFlag(ip, NHFLAGS_IFDOWN);
+            if (!rc)
+            {
+                break;
+            }
         }
-        else
+    }
+    else
+    {
+        vector<IpAddress> nhops;
+
+        for (const auto &ip : port->second)
         {
-            break;
+            auto &nhop = m_syncdNextHops.at(ip);
+            if (nhop.nh_flags & NHFLAGS_IFDOWN)
+            {
+                continue;
+            }
+
+            nhop.nh_flags |= NHFLAGS_IFDOWN;
+            nhops.push_back(ip);
         }
+
+        rc = gRouteOrch->invalidnexthopsinNextHopGroups(nhops, members);
     }
 
+    auto usec = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    SWSS_LOG_NOTICE("Informed %zu next hop(s) on %s %s in %ld usec",
+                    port->second.size(), alias.c_str(), if_up ? "up" : "down", (long)usec);
+
+    vector<FieldValueTuple> fvs = {
+        { "oper_status",    if_up ? "up" : "down" },
+        { "next_hops",      to_string(port->second.size()) },
+        { "pruned_members", to_string(members) },
+        { "latency_usec",   to_string(usec) }
+    };
+    m_statePortNextHopTable->set(alias, fvs);
+
     return rc;
 }
 
@@ -223,6 +265,17 @@ bool NeighOrch::removeNextHop(IpAddress ipAddress, string alias)
     }
 
     m_syncdNextHops.erase(ipAddress);
+
+    auto port = m_portNextHops.find(alias);
+    if (port != m_portNextHops.end())
+    {
+        port->second.erase(ipAddress);
+        if (port->second.empty())
+        {
+            m_portNextHops.erase(port);
+        }
+    }
+
     m_intfsOrch->decreaseRouterIntfsRefCount(alias);
     return true;
 }
@@ -280,6 +333,18 @@ void NeighOrch::doTask(Consumer &consumer)
         return;
     }
 
+    /*
+     * New neighbors and neighbor removals are collected and synced together
+     * once all tasks have been looked at. Later tasks on an IP that is part
+     * of the batch are kept for the next pass so that ordering is preserved.
+     */
+    vector<NeighborTask> add_tasks;
+    vector<NeighborTask> remove_tasks;
+    set<IpAddress> batched_ips;
+
+    /* Port lookups are done once per alias and pass */
+    map<string, Port> ports;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -304,14 +369,22 @@ void NeighOrch::doTask(Consumer &consumer)
             continue;
         }
 
-        Port p;
-        if (!gPortsOrch->getPort(alias, p))
+        auto port = ports.find(alias);
+        if (port == ports.end())
         {
-            SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
-            it++;
-            continue;
+            Port p;
+            if (!gPortsOrch->getPort(alias, p))
+            {
+                SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
+                it++;
+                continue;
+            }
+
+            port = ports.emplace(alias, p).first;
         }
 
+        const Port &p = port->second;
+
         if (!p.m_rif_id)
         {
             SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
@@ -323,6 +396,12 @@ void NeighOrch::doTask(Consumer &consumer)
 
         NeighborEntry neighbor_entry = { ip_address, alias };
 
+        if (batched_ips.find(ip_address) != batched_ips.end())
+        {
+            it++;
+            continue;
+        }
+
         if (op == SET_COMMAND)
         {
             MacAddress mac_address;
@@ -333,7 +412,13 @@ void NeighOrch::doTask(Consumer &consumer)
                     mac_address = MacAddress(fvValue(*i));
             }
 
-            if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end() || m_syncdNeighbors[neighbor_entry] != mac_address)
+            if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end()
+                && !hasNextHop(ip_address))
+            {
+                batched_ips.insert(ip_address);
+                add_tasks.push_back({ neighbor_entry, mac_address, p, it++ });
+            }
+            else if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end() || m_syncdNeighbors[neighbor_entry] != mac_address)
             {
                 if (addNeighbor(neighbor_entry, mac_address))
                     it = consumer.m_toSync.erase(it);
@@ -348,14 +433,8 @@ void NeighOrch::doTask(Consumer &consumer)
         {
             if (m_syncdNeighbors.find(neighbor_entry) != m_syncdNeighbors.end())
             {
-                if (removeNeighbor(neighbor_entry))
-                {
-                    it = consumer.m_toSync.erase(it);
-                }
-                else
-                {
-                    it++;
-                }
+                batched_ips.insert(ip_address);
+                remove_tasks.push_back({ neighbor_entry, MacAddress(), p, it++ });
             }
             else
                 /* Cannot locate the neighbor */
@@ -367,6 +446,271 @@ void NeighOrch::doTask(Consumer &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    removeNeighbors(consumer, remove_tasks);
+    addNeighbors(consumer, add_tasks);
+}
+
+/*
+ * Create the neighbor entries and next hops of 'tasks', issuing all SAI
+ * calls of a kind back to back. Tasks are erased from m_toSync on success
+ * and left for retry otherwise. CRM counters are updated and observers
+ * notified once all SAI calls are done.
+ */
+void NeighOrch::addNeighbors(Consumer &consumer, vector<NeighborTask> &tasks)
+{
+    SWSS_LOG_ENTER();
+
+    if (tasks.empty())
+    {
+        return;
+    }
+
+    size_t count = tasks.size();
+    vector<sai_neighbor_entry_t> neighbor_entries(count);
+    vector<sai_status_t> neighbor_statuses(count);
+    vector<sai_object_id_t> next_hop_ids(count, SAI_NULL_OBJECT_ID);
+    vector<sai_status_t> next_hop_statuses(count, SAI_STATUS_NOT_EXECUTED);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        sai_neighbor_entry_t &neighbor_entry = neighbor_entries[i];
+        neighbor_entry.rif_id = m_intfsOrch->getRouterIntfsId(tasks[i].entry.alias);
+        neighbor_entry.switch_id = gSwitchId;
+        copy(neighbor_entry.ip_address, tasks[i].entry.ip_address);
+
+        sai_attribute_t neighbor_attr;
+        neighbor_attr.id = SAI_NEIGHBOR_ENTRY_ATTR_DST_MAC_ADDRESS;
+        memcpy(neighbor_attr.value.mac, tasks[i].mac.getMac(), 6);
+
+        neighbor_statuses[i] = sai_neighbor_api->create_neighbor_entry(&neighbor_entry, 1, &neighbor_attr);
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (neighbor_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        vector<sai_attribute_t> next_hop_attrs;
+
+        sai_attribute_t next_hop_attr;
+        next_hop_attr.id = SAI_NEXT_HOP_ATTR_TYPE;
+        next_hop_attr.value.s32 = SAI_NEXT_HOP_TYPE_IP;
+        next_hop_attrs.push_back(next_hop_attr);
+
+        next_hop_attr.id = SAI_NEXT_HOP_ATTR_IP;
+        copy(next_hop_attr.value.ipaddr, tasks[i].entry.ip_address);
+        next_hop_attrs.push_back(next_hop_attr);
+
+        next_hop_attr.id = SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID;
+        next_hop_attr.value.oid = neighbor_entries[i].rif_id;
+        next_hop_attrs.push_back(next_hop_attr);
+
+        next_hop_statuses[i] = sai_next_hop_api->create_next_hop(&next_hop_ids[i], gSwitchId,
+                                                                 (uint32_t)next_hop_attrs.size(),
+                                                                 next_hop_attrs.data());
+    }
+
+    uint32_t v4_next_hops = 0, v6_next_hops = 0;
+    uint32_t v4_neighbors = 0, v6_neighbors = 0;
+    vector<NeighborUpdate> updates;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const NeighborEntry &entry = tasks[i].entry;
+        const string &alias = entry.alias;
+        bool v4 = entry.ip_address.isV4();
+
+        if (neighbor_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create neighbor %s on %s, rv:%d",
+                           tasks[i].mac.to_string().c_str(), alias.c_str(), neighbor_statuses[i]);
+            continue;
+        }
+
+        if (next_hop_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create next hop %s on %s, rv:%d",
+                           entry.ip_address.to_string().c_str(), alias.c_str(), next_hop_statuses[i]);
+
+            sai_status_t status = sai_neighbor_api->remove_neighbor_entry(&neighbor_entries[i]);
+            if (status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to remove neighbor %s on %s, rv:%d",
+                               tasks[i].mac.to_string().c_str(), alias.c_str(), status);
+
+                /* The neighbor entry stays, account for it as the one by one path does */
+                m_intfsOrch->increaseRouterIntfsRefCount(alias);
+                v4 ? v4_neighbors++ : v6_neighbors++;
+            }
+            continue;
+        }
+
+        SWSS_LOG_NOTICE("Created neighbor %s on %s", tasks[i].mac.to_string().c_str(), alias.c_str());
+        SWSS_LOG_NOTICE("Created next hop %s on %s",
+                        entry.ip_address.to_string().c_str(), alias.c_str());
+
+        m_intfsOrch->increaseRouterIntfsRefCount(alias);
+        syncNextHop(entry.ip_address, alias, next_hop_ids[i]);
+        v4 ? v4_neighbors++ : v6_neighbors++;
+        v4 ? v4_next_hops++ : v6_next_hops++;
+
+        // For nexthop with incoming port which has down oper status, NHFLAGS_IFDOWN
+        // flag Should be set on it.
+        if (tasks[i].port.m_oper_status == SAI_PORT_OPER_STATUS_DOWN)
+        {
+            if (setNextHopFlag(entry.ip_address, NHFLAGS_IFDOWN) == false)
+            {
+                SWSS_LOG_WARN("Failed to set NHFLAGS_IFDOWN on nexthop %s for interface %s",
+                    entry.ip_address.to_string().c_str(), alias.c_str());
+            }
+        }
+
+        m_syncdNeighbors[entry] = tasks[i].mac;
+        updates.push_back({ entry, tasks[i].mac, true });
+
+        consumer.m_toSync.erase(tasks[i].task);
+    }
+
+    if (v4_neighbors)
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR, v4_neighbors);
+    if (v6_neighbors)
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR, v6_neighbors);
+    if (v4_next_hops)
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP, v4_next_hops);
+    if (v6_next_hops)
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEXTHOP, v6_next_hops);
+
+    for (auto &update : updates)
+    {
+        notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+    }
+}
+
+/*
+ * Remove the next hops and neighbor entries of 'tasks', issuing all SAI
+ * calls of a kind back to back. Still referenced neighbors are left in
+ * m_toSync, as are the ones whose removal failed.
+ */
+void NeighOrch::removeNeighbors(Consumer &consumer, vector<NeighborTask> &tasks)
+{
+    SWSS_LOG_ENTER();
+
+    if (tasks.empty())
+    {
+        return;
+    }
+
+    size_t count = tasks.size();
+    vector<sai_neighbor_entry_t> neighbor_entries(count);
+    vector<sai_status_t> next_hop_statuses(count, SAI_STATUS_NOT_EXECUTED);
+    vector<sai_status_t> neighbor_statuses(count, SAI_STATUS_NOT_EXECUTED);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const IpAddress &ip_address = tasks[i].entry.ip_address;
+
+        if (m_syncdNextHops[ip_address].ref_count > 0)
+        {
+            SWSS_LOG_INFO("Failed to remove still referenced neighbor %s on %s",
+                          m_syncdNeighbors[tasks[i].entry].to_string().c_str(), tasks[i].entry.alias.c_str());
+            continue;
+        }
+
+        next_hop_statuses[i] = sai_next_hop_api->remove_next_hop(m_syncdNextHops[ip_address].next_hop_id);
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        /* When next hop is not found, we continue to remove neighbor entry. */
+        if (next_hop_statuses[i] != SAI_STATUS_SUCCESS && next_hop_statuses[i] != SAI_STATUS_ITEM_NOT_FOUND)
+        {
+            continue;
+        }
+
+        sai_neighbor_entry_t &neighbor_entry = neighbor_entries[i];
+        neighbor_entry.rif_id = m_intfsOrch->getRouterIntfsId(tasks[i].entry.alias);
+        neighbor_entry.switch_id = gSwitchId;
+        copy(neighbor_entry.ip_address, tasks[i].entry.ip_address);
+
+        neighbor_statuses[i] = sai_neighbor_api->remove_neighbor_entry(&neighbor_entry);
+    }
+
+    uint32_t v4_next_hops = 0, v6_next_hops = 0;
+    uint32_t v4_neighbors = 0, v6_neighbors = 0;
+    vector<NeighborUpdate> updates;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const NeighborEntry &entry = tasks[i].entry;
+        const string &alias = entry.alias;
+        bool v4 = entry.ip_address.isV4();
+
+        if (next_hop_statuses[i] == SAI_STATUS_NOT_EXECUTED)
+        {
+            continue;
+        }
+
+        if (next_hop_statuses[i] == SAI_STATUS_SUCCESS)
+        {
+            v4 ? v4_next_hops++ : v6_next_hops++;
+            SWSS_LOG_NOTICE("Removed next hop %s on %s",
+                            entry.ip_address.to_string().c_str(), alias.c_str());
+        }
+        else if (next_hop_statuses[i] == SAI_STATUS_ITEM_NOT_FOUND)
+        {
+            SWSS_LOG_ERROR("Failed to locate next hop %s on %s, rv:%d",
+                           entry.ip_address.to_string().c_str(), alias.c_str(), next_hop_statuses[i]);
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to remove next hop %s on %s, rv:%d",
+                           entry.ip_address.to_string().c_str(), alias.c_str(), next_hop_statuses[i]);
+            continue;
+        }
+
+        if (neighbor_statuses[i] == SAI_STATUS_ITEM_NOT_FOUND)
+        {
+            SWSS_LOG_ERROR("Failed to locate neigbor %s on %s, rv:%d",
+                    m_syncdNeighbors[entry].to_string().c_str(), alias.c_str(), neighbor_statuses[i]);
+        }
+        else if (neighbor_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove neighbor %s on %s, rv:%d",
+                    m_syncdNeighbors[entry].to_string().c_str(), alias.c_str(), neighbor_statuses[i]);
+            continue;
+        }
+        else
+        {
+            v4 ? v4_neighbors++ : v6_neighbors++;
+            SWSS_LOG_NOTICE("Removed neighbor %s on %s",
+                    m_syncdNeighbors[entry].to_string().c_str(), alias.c_str());
+        }
+
+        m_syncdNeighbors.erase(entry);
+        m_intfsOrch->decreaseRouterIntfsRefCount(alias);
+        removeNextHop(entry.ip_address, alias);
+
+        updates.push_back({ entry, MacAddress(), false });
+
+        consumer.m_toSync.erase(tasks[i].task);
+    }
+
+    if (v4_next_hops)
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP, v4_next_hops);
+    if (v6_next_hops)
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEXTHOP, v6_next_hops);
+    if (v4_neighbors)
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR, v4_neighbors);
+    if (v6_neighbors)
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR, v6_neighbors);
+
+    for (auto &update : updates)
+    {
+        notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+    }
 }
 
 bool NeighOrch::addNeighbor(NeighborEntry neighborEntry, MacAddress macAddress)
@@ -452,103 +796,3 @@ bool NeighOrch::addNeighbor(NeighborEntry neighborEntry, MacAddress macAddress)
 
     return true;
 }
-
-bool NeighOrch::removeNeighbor(NeighborEntry neighborEntry)
-{
-    SWSS_LOG_ENTER();
-
-    sai_status_t status;
-    IpAddress ip_address = neighborEntry.ip_address;
-    string alias = neighborEntry.alias;
-
-    if (m_syncdNeighbors.find(neighborEntry) == m_syncdNeighbors.end())
-    {
-        return true;
-    }
-
-    if (m_syncdNextHops[ip_address].ref_count > 0)
-    {
-        SWSS_LOG_INFO("Failed to remove still referenced neighbor %s on %s",
-                      m_syncdNeighbors[neighborEntry].to_string().c_str(), alias.c_str());
-        return false;
-    }
-
-    sai_object_id_t rif_id = m_intfsOrch->getRouterIntfsId(alias);
-
-    sai_neighbor_entry_t neighbor_entry;
-    neighbor_entry.rif_id = rif_id;
-    neighbor_entry.switch_id = gSwitchId;
-    copy(neighbor_entry.ip_address, ip_address);
-
-    sai_object_id_t next_hop_id = m_syncdNextHops[ip_address].next_hop_id;
-    status = sai_next_hop_api->remove_next_hop(next_hop_id);
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        /* When next hop is not found, we continue to remove neighbor entry. */
-        if (status == SAI_STATUS_ITEM_NOT_FOUND)
-        {
-            SWSS_LOG_ERROR("Failed to locate next hop %s on %s, rv:%d",
-                           ip_address.to_string().c_str(), alias.c_str(), status);
-        }
-        else
-        {
-            SWSS_LOG_ERROR("Failed to remove next hop %s on %s, rv:%d",
-                           ip_address.to_string().c_str(), alias.c_str(), status);
-            return false;
-        }
-    }
-
-    if (status != SAI_STATUS_ITEM_NOT_FOUND)
-    {
-        if (neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
-        {
-            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
-        }
-        else
-        {
-            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEXTHOP);
-        }
-    }
-
-    SWSS_LOG_NOTICE("Removed next hop %s on %s",
-                    ip_address.to_string().c_str(), alias.c_str());
-
-    status = sai_neighbor_api->remove_neighbor_entry(&neighbor_entry);
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        if (status == SAI_STATUS_ITEM_NOT_FOUND)
-        {
-            SWSS_LOG_ERROR("Failed to locate neigbor %s on %s, rv:%d",
-                    m_syncdNeighbors[neighborEntry].to_string().c_str(), alias.c_str(), status);
-            return true;
-        }
-        else
-        {
-            SWSS_LOG_ERROR("Failed to remove neighbor %s on %s, rv:%d",
-                    m_syncdNeighbors[neighborEntry].to_string().c_str(), alias.c_str(), status);
-            return false;
-        }
-    }
-
-    if (neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
-    {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
-    }
-    else
-    {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
-    }
-
-    SWSS_LOG_NOTICE("Removed neighbor %s on %s",
-            m_syncdNeighbors[neighborEntry].to_string().c_str(), alias.c_str());
-
-    m_syncdNeighbors.erase(neighborEntry);
-    m_intfsOrch->decreaseRouterIntfsRefCount(alias);
-
-    NeighborUpdate update = { neighborEntry, MacAddress(), false };
-    notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
-
-    removeNextHop(ip_address, alias);
-
-    return true;
-}
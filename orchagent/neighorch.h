@@ -10,6 +10,8 @@
 
 #define NHFLAGS_IFDOWN                  0x1 // nexthop's outbound i/f is down
 
+#define STATE_PORT_NEXTHOP_TABLE_NAME   "PORT_NEXTHOP_TABLE"
+
 struct NeighborEntry
 {
     IpAddress           ip_address;     // neighbor IP address
@@ -43,6 +45,8 @@ struct NextHopEntry
 typedef map<NeighborEntry, MacAddress> NeighborTable;
 /* NextHopTable: next hop IP address, NextHopEntry */
 typedef map<IpAddress, NextHopEntry> NextHopTable;
+/* PortNextHopTable: i/f name alias, next hop IP addresses on the i/f */
+typedef map<string, set<IpAddress>> PortNextHopTable;
 
 struct NeighborUpdate
 {
@@ -74,12 +78,28 @@ private:
 
     NeighborTable m_syncdNeighbors;
     NextHopTable m_syncdNextHops;
+    PortNextHopTable m_portNextHops;
+
+    shared_ptr<DBConnector> m_stateDb;
+    unique_ptr<Table> m_statePortNextHopTable;
+
+    /* Neighbor task collected from m_toSync to be synced along with others */
+    struct NeighborTask
+    {
+        NeighborEntry entry;
+        MacAddress mac;
+        Port port;
+        SyncMap::iterator task;
+    };
 
     bool addNextHop(IpAddress, string);
     bool removeNextHop(IpAddress, string);
+    void syncNextHop(const IpAddress &, const string &, sai_object_id_t);
 
     bool addNeighbor(NeighborEntry, MacAddress);
-    bool removeNeighbor(NeighborEntry);
+
+    void addNeighbors(Consumer &consumer, vector<NeighborTask> &tasks);
+    void removeNeighbors(Consumer &consumer, vector<NeighborTask> &tasks);
 
     bool setNextHopFlag(const IpAddress &, const uint32_t);
     bool clearNextHopFlag(const IpAddress &, const uint32_t);
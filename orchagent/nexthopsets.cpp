@@ -0,0 +1,111 @@
+#include <assert.h>
+#include "nexthopsets.h"
+
+using namespace std;
+using namespace swss;
+
+NextHopSetTable::NextHopSetTable()
+{
+    auto ids = m_ids.emplace(IpAddresses(), EMPTY_NEXTHOP_SET).first;
+    m_entries.push_back({ ids, IpAddress(), 0, 1 });
+}
+
+NextHopSetId NextHopSetTable::intern(const IpAddresses &nexthops)
+{
+    auto ids = m_ids.find(nexthops);
+    if (ids != m_ids.end())
+    {
+        if (ids->second != EMPTY_NEXTHOP_SET)
+        {
+            m_entries[ids->second].ref_count++;
+        }
+        return ids->second;
+    }
+
+    NextHopSetId id;
+    if (!m_free.empty())
+    {
+        id = m_free.back();
+        m_free.pop_back();
+    }
+    else
+    {
+        id = (NextHopSetId)m_entries.size();
+        m_entries.emplace_back();
+    }
+
+    NextHopSetEntry &entry = m_entries[id];
+    entry.nexthops = m_ids.emplace(nexthops, id).first;
+    entry.size = (uint32_t)nexthops.getSize();
+    entry.nexthop = (entry.size == 1) ? *nexthops.getIpAddresses().begin() : IpAddress();
+    entry.ref_count = 1;
+
+    return id;
+}
+
+void NextHopSetTable::retain(NextHopSetId id)
+{
+    if (id == EMPTY_NEXTHOP_SET)
+    {
+        return;
+    }
+
+    assert(m_entries.at(id).ref_count > 0);
+    m_entries[id].ref_count++;
+}
+
+void NextHopSetTable::release(NextHopSetId id)
+{
+    if (id == EMPTY_NEXTHOP_SET)
+    {
+        return;
+    }
+
+    NextHopSetEntry &entry = m_entries.at(id);
+    assert(entry.ref_count > 0);
+
+    if (--entry.ref_count > 0)
+    {
+        return;
+    }
+
+    m_ids.erase(entry.nexthops);
+    entry.nexthops = m_ids.end();
+    entry.nexthop = IpAddress();
+    entry.size = 0;
+    m_free.push_back(id);
+}
+
+bool NextHopSetTable::find(const IpAddresses &nexthops, NextHopSetId &id) const
+{
+    auto ids = m_ids.find(nexthops);
+    if (ids == m_ids.end())
+    {
+        return false;
+    }
+
+    id = ids->second;
+    return true;
+}
+
+const IpAddresses &NextHopSetTable::get(NextHopSetId id) const
+{
+    assert(m_entries.at(id).ref_count > 0);
+    return m_entries[id].nexthops->first;
+}
+
+size_t NextHopSetTable::getSize(NextHopSetId id) const
+{
+    return m_entries.at(id).size;
+}
+
+const IpAddress &NextHopSetTable::getNextHop(NextHopSetId id) const
+{
+    assert(m_entries.at(id).size == 1);
+    return m_entries[id].nexthop;
+}
+
+size_t NextHopSetTable::size() const
+{
+    return m_ids.size();
+}
@@ -0,0 +1,66 @@
+#ifndef SWSS_NEXTHOPSETS_H
+#define SWSS_NEXTHOPSETS_H
+
+#include "ipaddress.h"
+#include "ipaddresses.h"
+
+#include <map>
+#include <vector>
+
+#include <stdint.h>
+
+/*
+ * Compact handle on an interned next hop set. Equal sets share a handle, so
+ * sets can be compared by comparing handles.
+ */
+typedef uint32_t NextHopSetId;
+
+/* Handle of the empty next hop set, always valid and never released */
+const NextHopSetId EMPTY_NEXTHOP_SET = 0;
+
+/*
+ * Reference counted table of interned next hop sets. Each distinct set is
+ * stored once however many routes use it, and is dropped when the last of
+ * them releases it. Handles of dropped sets are reused.
+ */
+class NextHopSetTable
+{
+public:
+    NextHopSetTable();
+
+    /* Return the handle of 'nexthops', taking a reference on it */
+    NextHopSetId intern(const swss::IpAddresses &nexthops);
+    /* Take one more reference on an interned set */
+    void retain(NextHopSetId id);
+    /* Drop a reference taken by intern() or retain() */
+    void release(NextHopSetId id);
+
+    /* Look 'nexthops' up without taking a reference */
+    bool find(const swss::IpAddresses &nexthops, NextHopSetId &id) const;
+
+    const swss::IpAddresses &get(NextHopSetId id) const;
+    /* Number of next hops in the set */
+    size_t getSize(NextHopSetId id) const;
+    /* The next hop of a single next hop set */
+    const swss::IpAddress &getNextHop(NextHopSetId id) const;
+
+    /* Number of distinct sets interned, the empty set included */
+    size_t size() const;
+
+private:
+    typedef std::map<swss::IpAddresses, NextHopSetId> NextHopSetIds;
+
+    struct NextHopSetEntry
+    {
+        NextHopSetIds::iterator     nexthops;       // interned set and its handle
+        swss::IpAddress             nexthop;        // next hop of a single next hop set
+        uint32_t                    size;           // number of next hops
+        uint32_t                    ref_count;      // reference count, 0 when unused
+    };
+
+    NextHopSetIds m_ids;
+    std::vector<NextHopSetEntry> m_entries;
+    std::vector<NextHopSetId> m_free;
+};
+
+#endif /* SWSS_NEXTHOPSETS_H */
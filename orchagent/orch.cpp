@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sys/time.h>
@@ -9,6 +10,7 @@
 #include "tokenize.h"
 #include "logger.h"
 #include "consumerstatetable.h"
+#include "warmRestartLoader.h"
 
 using namespace swss;
 
@@ -19,6 +21,31 @@ extern ofstream gRecordOfs;
 extern bool gLogRotate;
 extern string gRecordFile;
 
+unordered_map<string, Orch::ResolvedReference> Orch::m_resolvedReferences;
+map<object_reference, set<string>> Orch::m_referenceStrings;
+
+/* Pop batch bounds of the APPL_DB tables found in CONFIG_DB */
+static map<string, ConsumerBatchConfig> gConsumerBatchConfig;
+
+static ConsumerBatchConfig defaultConsumerBatchConfig()
+{
+    /*
+     * The cfgmgr daemons leave gBatchSize at 0. Their consumers are all on
+     * CONFIG_DB and STATE_DB, still keep any APPL_DB one to a fixed batch.
+     */
+    if (gBatchSize <= 0)
+    {
+        size_t size = (size_t)TableConsumable::DEFAULT_POP_BATCH_SIZE;
+        return { size, size, chrono::milliseconds(DEFAULT_CONSUMER_BATCH_LATENCY_MSECS) };
+    }
+
+    return {
+        (size_t)gBatchSize,
+        (size_t)gBatchSize * DEFAULT_CONSUMER_BATCH_GROWTH,
+        chrono::milliseconds(DEFAULT_CONSUMER_BATCH_LATENCY_MSECS)
+    };
+}
+
 Orch::Orch(DBConnector *db, const string tableName, int pri)
 {
     addConsumer(db, tableName, pri);
@@ -66,59 +93,64 @@ vector<Selectable *> Orch::getSelectables()
     return selectables;
 }
 
-size_t Consumer::addToSync(std::deque<KeyOpFieldsValuesTuple> &entries)
+void Consumer::addToSync(KeyOpFieldsValuesTuple &entry)
 {
-    SWSS_LOG_ENTER();
+    string key = kfvKey(entry);
+    string op  = kfvOp(entry);
 
-    /* Nothing popped */
-    if (entries.empty())
+    /* Record incoming tasks */
+    if (gSwssRecord)
     {
-        return 0;
+        Orch::recordTuple(*this, entry);
     }
 
-    for (auto& entry: entries)
+    /* If a new task comes or if a DEL task comes, we directly put it into getConsumerTable().m_toSync map */
+    if (m_toSync.find(key) == m_toSync.end() || op == DEL_COMMAND)
     {
-        string key = kfvKey(entry);
-        string op  = kfvOp(entry);
-
-        /* Record incoming tasks */
-        if (gSwssRecord)
-        {
-            Orch::recordTuple(*this, entry);
-        }
+       m_toSync[key] = entry;
+    }
+    /* If an old task is still there, we combine the old task with new task */
+    else
+    {
+        KeyOpFieldsValuesTuple existing_data = m_toSync[key];
 
-        /* If a new task comes or if a DEL task comes, we directly put it into getConsumerTable().m_toSync map */
-        if (m_toSync.find(key) == m_toSync.end() || op == DEL_COMMAND)
-        {
-           m_toSync[key] = entry;
-        }
-        /* If an old task is still there, we combine the old task with new task */
-        else
-        {
-            KeyOpFieldsValuesTuple existing_data = m_toSync[key];
+        auto new_values = kfvFieldsValues(entry);
+        auto existing_values = kfvFieldsValues(existing_data);
 
-            auto new_values = kfvFieldsValues(entry);
-            auto existing_values = kfvFieldsValues(existing_data);
 
+        for (auto it : new_values)
+        {
+            string field = fvField(it);
+            string value = fvValue(it);
 
-            for (auto it : new_values)
+            auto iu = existing_values.begin();
+            while (iu != existing_values.end())
             {
-                string field = fvField(it);
-                string value = fvValue(it);
-
-                auto iu = existing_values.begin();
-                while (iu != existing_values.end())
-                {
-                    string ofield = fvField(*iu);
-                    if (field == ofield)
-                        iu = existing_values.erase(iu);
-                    else
-                        iu++;
-                }
-                existing_values.push_back(FieldValueTuple(field, value));
+                string ofield = fvField(*iu);
+                if (field == ofield)
+                    iu = existing_values.erase(iu);
+                else
+                    iu++;
             }
-            m_toSync[key] = KeyOpFieldsValuesTuple(key, op, existing_values);
+            existing_values.push_back(FieldValueTuple(field, value));
         }
+        m_toSync[key] = KeyOpFieldsValuesTuple(key, op, existing_values);
+    }
+}
+
+size_t Consumer::addToSync(std::deque<KeyOpFieldsValuesTuple> &entries)
+{
+    SWSS_LOG_ENTER();
+
+    /* Nothing popped */
+    if (entries.empty())
+    {
+        return 0;
+    }
+
+    for (auto& entry: entries)
+    {
+        addToSync(entry);
     }
     return entries.size();
 }
@@ -160,29 +192,73 @@ size_t Consumer::refillToSync()
     else
     {
         // consumerTable is either ConsumerStateTable or ConsumerTable
-        auto db = consumerTable->getDbConnector();
-        string tableName = consumerTable->getTableName();
-        auto table = Table(db, tableName);
-        return refillToSync(&table);
+        return bulkRefillToSync(consumerTable->getDbConnector(),
+                                consumerTable->getTableName(),
+                                consumerTable->getTableNameSeparator());
     }
 }
 
+/*
+ * Bulk variant of refillToSync(Table*): keys and hashes are fetched in
+ * pipelined SCAN batches and fed straight into m_toSync, instead of issuing
+ * one round trip per entry.
+ */
+size_t Consumer::bulkRefillToSync(DBConnector *db, const string &tableName, const string &separator)
+{
+    SWSS_LOG_ENTER();
+
+    AppTableLoader loader(db, tableName, separator);
+
+    size_t count = loader.load([this](const string &key, const vector<FieldValueTuple> &fvs)
+    {
+        KeyOpFieldsValuesTuple kco(key, SET_COMMAND, fvs);
+        addToSync(kco);
+    });
+
+    SWSS_LOG_NOTICE("Refilled %zu entries from %s in %lu ms",
+                    count, tableName.c_str(), loader.getLoadTime());
+
+    return count;
+}
+
 void Consumer::execute()
 {
     SWSS_LOG_ENTER();
 
+    auto start = chrono::steady_clock::now();
+    ConsumerTableBase *table = getConsumerTable();
     std::deque<KeyOpFieldsValuesTuple> entries;
-    getConsumerTable()->pops(entries);
+    size_t limit = min(m_batch.size(), m_budget);
+    size_t popped = 0;
+    bool full;
+
+    /* Keep popping while the table has a backlog, up to the current batch size */
+    do
+    {
+        table->pops(entries);
+        popped += addToSync(entries);
+        full = entries.size() >= (size_t)table->POP_BATCH_SIZE;
+    }
+    while (full && popped < limit);
 
-    addToSync(entries);
+    m_executed = popped;
+    m_backlog = full;
+    m_budget = SIZE_MAX;
 
     drain();
+
+    m_batch.update(popped, chrono::steady_clock::now() - start);
 }
 
-void Consumer::drain()
+size_t Consumer::drain()
 {
-    if (!m_toSync.empty())
-        m_orch->doTask(*this);
+    if (m_toSync.empty())
+        return 0;
+
+    size_t pending = m_toSync.size();
+    m_orch->doTask(*this);
+
+    return m_toSync.size() < pending ? pending - m_toSync.size() : 0;
 }
 
 string Consumer::dumpTuple(KeyOpFieldsValuesTuple &tuple)
@@ -271,6 +347,15 @@ bool Orch::parseReference(type_map &type_maps, string &ref_in, string &type_name
     SWSS_LOG_ENTER();
 
     SWSS_LOG_DEBUG("input:%s", ref_in.c_str());
+
+    const ResolvedReference *resolved = findResolvedReference(type_maps, ref_in);
+    if (resolved)
+    {
+        type_name = resolved->type_name;
+        object_name = resolved->object->first;
+        return true;
+    }
+
     if (ref_in.size() < 2)
     {
         SWSS_LOG_ERROR("invalid reference received:%s\n", ref_in.c_str());
@@ -320,9 +405,162 @@ bool Orch::parseReference(type_map &type_maps, string &ref_in, string &type_name
     type_name = tokens[0];
     object_name = tokens[1];
     SWSS_LOG_DEBUG("parsed: type_name:%s, object_name:%s", type_name.c_str(), object_name.c_str());
+
+    m_resolvedReferences[ref_in] = { &type_maps, type_name, obj_it };
+    m_referenceStrings[object_reference(type_name, object_name)].insert(ref_in);
     return true;
 }
 
+const Orch::ResolvedReference *Orch::findResolvedReference(type_map &type_maps, const string &ref)
+{
+    auto it = m_resolvedReferences.find(ref);
+    if (it == m_resolvedReferences.end() || it->second.type_maps != &type_maps)
+    {
+        return NULL;
+    }
+
+    return &it->second;
+}
+
+void Orch::setReferencedObject(type_map &type_maps, const string &type_name, const string &object_name, sai_object_id_t object)
+{
+    SWSS_LOG_ENTER();
+
+    object_map *objects = type_maps.at(type_name);
+    auto it = objects->find(object_name);
+
+    if (it == objects->end())
+    {
+        (*objects)[object_name] = object;
+        return;
+    }
+
+    /* Resolved references point at the entry, they see the new object */
+    it->second = object;
+}
+
+void Orch::removeReferencedObject(type_map &type_maps, const string &type_name, const string &object_name)
+{
+    SWSS_LOG_ENTER();
+
+    object_map *objects = type_maps.at(type_name);
+    auto it = objects->find(object_name);
+
+    if (it == objects->end())
+    {
+        return;
+    }
+
+    auto refs = m_referenceStrings.find(object_reference(type_name, object_name));
+    if (refs != m_referenceStrings.end())
+    {
+        for (const auto &ref : refs->second)
+        {
+            m_resolvedReferences.erase(ref);
+        }
+        m_referenceStrings.erase(refs);
+    }
+
+    objects->erase(it);
+}
+
+/*
+ * Record which objects the entry references, so it can be re-applied when
+ * one of them is updated. Deleted entries are forgotten.
+ */
+void Orch::updateObjectDependents(type_map &type_maps, const string &table_name, const KeyOpFieldsValuesTuple &tuple)
+{
+    auto key = make_pair(table_name, kfvKey(tuple));
+    auto dependent = m_dependents.find(key);
+
+    if (dependent != m_dependents.end())
+    {
+        for (const auto &object : dependent->second.objects)
+        {
+            auto dependents = m_objectDependents.find(object);
+            dependents->second.erase(key);
+            if (dependents->second.empty())
+            {
+                m_objectDependents.erase(dependents);
+            }
+        }
+        m_dependents.erase(dependent);
+    }
+
+    if (kfvOp(tuple) != SET_COMMAND)
+    {
+        return;
+    }
+
+    set<object_reference> objects;
+    for (const auto &fv : kfvFieldsValues(tuple))
+    {
+        const string &value = fvValue(fv);
+        if (value.empty() || value[0] != ref_start)
+        {
+            continue;
+        }
+
+        /* References were resolved while processing the entry, they are cached */
+        size_t start = 0;
+        while (start < value.size())
+        {
+            size_t end = value.find(list_item_delimiter, start);
+            if (end == string::npos)
+            {
+                end = value.size();
+            }
+
+            const ResolvedReference *resolved = findResolvedReference(type_maps, value.substr(start, end - start));
+            if (resolved)
+            {
+                objects.insert(object_reference(resolved->type_name, resolved->object->first));
+            }
+            start = end + 1;
+        }
+    }
+
+    if (objects.empty())
+    {
+        return;
+    }
+
+    for (const auto &object : objects)
+    {
+        m_objectDependents[object].insert(key);
+    }
+    m_dependents[key] = { tuple, objects };
+}
+
+/* Queue the entries referencing 'object' again, unless newer ones are already pending */
+size_t Orch::reapplyObjectDependents(const object_reference &object)
+{
+    auto dependents = m_objectDependents.find(object);
+    if (dependents == m_objectDependents.end())
+    {
+        return 0;
+    }
+
+    size_t count = 0;
+    for (const auto &key : dependents->second)
+    {
+        auto consumer = dynamic_cast<Consumer *>(getExecutor(key.first));
+        if (consumer == NULL)
+        {
+            continue;
+        }
+
+        if (consumer->m_toSync.emplace(key.second, m_dependents[key].tuple).second)
+        {
+            count++;
+        }
+    }
+
+    SWSS_LOG_INFO("Re-applying %zu entries referencing [%s:%s]", count, object.first.c_str(), object.second.c_str());
+
+    return count;
+}
+
 ref_resolve_status Orch::resolveFieldRefValue(
     type_map &type_maps,
     const string &field_name,
@@ -342,16 +580,21 @@ ref_resolve_status Orch::resolveFieldRefValue(
                 SWSS_LOG_ERROR("Multiple same fields %s", field_name.c_str());
                 return ref_resolve_status::multiple_instances;
             }
-            string ref_type_name, object_name;
-            if (!parseReference(type_maps, fvValue(*i), ref_type_name, object_name))
+            const ResolvedReference *resolved = findResolvedReference(type_maps, fvValue(*i));
+            if (!resolved)
             {
-                return ref_resolve_status::not_resolved;
-            }
-            else if (ref_type_name.empty() && object_name.empty())
-            {
-                return ref_resolve_status::empty;
+                string ref_type_name, object_name;
+                if (!parseReference(type_maps, fvValue(*i), ref_type_name, object_name))
+                {
+                    return ref_resolve_status::not_resolved;
+                }
+                else if (ref_type_name.empty() && object_name.empty())
+                {
+                    return ref_resolve_status::empty;
+                }
+                resolved = findResolvedReference(type_maps, fvValue(*i));
             }
-            sai_object = (*(type_maps[ref_type_name]))[object_name];
+            sai_object = resolved->object->second;
             hit = true;
         }
     }
@@ -362,12 +605,30 @@ ref_resolve_status Orch::resolveFieldRefValue(
     return ref_resolve_status::success;
 }
 
-void Orch::doTask()
+size_t Orch::doTask()
 {
+    size_t done = 0;
     for(auto &it : m_consumerMap)
     {
-        it.second->drain();
+        done += it.second->drain();
     }
+    return done;
+}
+
+vector<Consumer *> Orch::getConsumers()
+{
+    vector<Consumer *> consumers;
+
+    for (auto &it : m_consumerMap)
+    {
+        auto consumer = dynamic_cast<Consumer *>(it.second.get());
+        if (consumer)
+        {
+            consumers.push_back(consumer);
+        }
+    }
+
+    return consumers;
 }
 
 void Orch::dumpPendingTasks(vector<string> &ts)
@@ -385,6 +646,56 @@ void Orch::dumpPendingTasks(vector<string> &ts)
     }
 }
 
+void Orch::loadConsumerBatchConfig(DBConnector *configDb)
+{
+    SWSS_LOG_ENTER();
+
+    Table table(configDb, CFG_CONSUMER_BATCH_TABLE_NAME);
+    vector<string> keys;
+
+    table.getKeys(keys);
+    for (const auto &key : keys)
+    {
+        vector<FieldValueTuple> fvs;
+        ConsumerBatchConfig config = defaultConsumerBatchConfig();
+
+        table.get(key, fvs);
+        if (!parseConsumerBatchConfig(fvs, config))
+        {
+            SWSS_LOG_ERROR("Invalid %s %s configuration, using defaults",
+                           CFG_CONSUMER_BATCH_TABLE_NAME, key.c_str());
+            continue;
+        }
+
+        SWSS_LOG_NOTICE("%s pop batch between %zu and %zu entries, latency target %ld ms",
+                        key.c_str(), config.minSize, config.maxSize,
+                        (long)config.latencyTarget.count());
+        gConsumerBatchConfig[key] = config;
+    }
+}
+
+void Orch::publishConsumerBatches(Table &table)
+{
+    for (auto &it : m_consumerMap)
+    {
+        Consumer* consumer = dynamic_cast<Consumer *>(it.second.get());
+        if (consumer == NULL)
+        {
+            continue;
+        }
+
+        AdaptiveBatch &batch = consumer->getBatch();
+        vector<FieldValueTuple> fvs = {
+            { "batch_size",       to_string(batch.size()) },
+            { "min_batch_size",   to_string(batch.config().minSize) },
+            { "max_batch_size",   to_string(batch.config().maxSize) },
+            { "max_latency_usec", to_string(batch.takeMaxLatency().count()) }
+        };
+
+        table.set(it.first, fvs);
+    }
+}
+
 void Orch::logfileReopen()
 {
     gRecordOfs.close();
@@ -456,13 +767,18 @@ ref_resolve_status Orch::resolveFieldRefArray(
             }
             for (size_t ind = 0; ind < list_items.size(); ind++)
             {
-                if (!parseReference(type_maps, list_items[ind], ref_type_name, object_name))
+                const ResolvedReference *resolved = findResolvedReference(type_maps, list_items[ind]);
+                if (!resolved)
                 {
-                    SWSS_LOG_ERROR("Failed to parse profile reference:%s\n", list_items[ind].c_str());
-                    return ref_resolve_status::not_resolved;
+                    if (!parseReference(type_maps, list_items[ind], ref_type_name, object_name) ||
+                        !(resolved = findResolvedReference(type_maps, list_items[ind])))
+                    {
+                        SWSS_LOG_ERROR("Failed to parse profile reference:%s\n", list_items[ind].c_str());
+                        return ref_resolve_status::not_resolved;
+                    }
                 }
-                sai_object_id_t sai_obj = (*(type_maps[ref_type_name]))[object_name];
-                SWSS_LOG_DEBUG("Resolved to sai_object:0x%lx, type:%s, name:%s", sai_obj, ref_type_name.c_str(), object_name.c_str());
+                sai_object_id_t sai_obj = resolved->object->second;
+                SWSS_LOG_DEBUG("Resolved to sai_object:0x%lx, type:%s, name:%s", sai_obj, resolved->type_name.c_str(), resolved->object->first.c_str());
                 sai_object_arr.push_back(sai_obj);
             }
             count++;
@@ -513,7 +829,18 @@ void Orch::addConsumer(DBConnector *db, string tableName, int pri)
     }
     else
     {
-        addExecutor(new Consumer(new ConsumerStateTable(db, tableName, gBatchSize, pri), this, tableName));
+        ConsumerBatchConfig config = defaultConsumerBatchConfig();
+
+        auto it = gConsumerBatchConfig.find(tableName);
+        if (it != gConsumerBatchConfig.end())
+        {
+            config = it->second;
+        }
+
+        /* Redis pops go by the smallest batch, larger ones take several */
+        auto consumer = new Consumer(new ConsumerStateTable(db, tableName, (int)config.minSize, pri), this, tableName);
+        consumer->setBatchConfig(config);
+        addExecutor(consumer);
     }
 }
 
@@ -4,7 +4,9 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <map>
+#include <set>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 extern "C" {
@@ -19,6 +21,7 @@ extern "C" {
 #include "notificationconsumer.h"
 #include "selectabletimer.h"
 #include "macaddress.h"
+#include "adaptivebatch.h"
 
 using namespace std;
 using namespace swss;
@@ -56,10 +59,20 @@ typedef pair<string, sai_object_id_t> object_map_pair;
 
 typedef map<string, object_map*> type_map;
 typedef pair<string, object_map*> type_map_pair;
+
+/* Referenced object, as the pair of its type name and object name */
+typedef pair<string, string> object_reference;
 typedef map<string, KeyOpFieldsValuesTuple> SyncMap;
 
 typedef pair<string, int> table_name_with_pri_t;
 
+/*
+ * Serializes access to orch state between the main event loop and the
+ * telemetry worker loop. The main loop holds it while processing an event,
+ * orchs running on the worker take it only around accesses to shared state.
+ */
+extern recursive_mutex gOrchStateMutex;
+
 class Orch;
 
 // Design assumption
@@ -70,7 +83,8 @@ class Executor : public Selectable
 {
 public:
     Executor(Selectable *selectable, Orch *orch, const string &name)
-        : m_selectable(selectable)
+        : Selectable(selectable->getPri())
+        , m_selectable(selectable)
         , m_orch(orch)
         , m_name(name)
     {
@@ -91,7 +105,15 @@ public:
 
     // Execute on event happening
     virtual void execute() { }
-    virtual void drain() { }
+    /* Retry pending entries, returning how many of them got done */
+    virtual size_t drain() { return 0; }
+
+    /* Most entries the next execute() may take in, set by the event loop scheduler */
+    virtual void setBudget(size_t entries) { }
+    /* Entries taken in by the last execute() */
+    virtual size_t getExecuted() const { return 0; }
+    /* The last execute() left entries pending, having run out of budget */
+    virtual bool hasBacklog() const { return false; }
 
     virtual string getName() const
     {
@@ -113,6 +135,8 @@ class Consumer : public Executor {
 public:
     Consumer(ConsumerTableBase *select, Orch *orch, const string &name)
         : Executor(select, orch, name)
+        , m_batch({ (size_t)select->POP_BATCH_SIZE, (size_t)select->POP_BATCH_SIZE,
+                    chrono::milliseconds(DEFAULT_CONSUMER_BATCH_LATENCY_MSECS) })
     {
     }
 
@@ -136,16 +160,36 @@ public:
 
     size_t refillToSync();
     size_t refillToSync(Table* table);
+    size_t bulkRefillToSync(DBConnector *db, const string &tableName, const string &separator);
     void execute();
-    void drain();
+    size_t drain();
+
+    void setBudget(size_t entries) override { m_budget = entries; }
+    size_t getExecuted() const override { return m_executed; }
+    bool hasBacklog() const override { return m_backlog; }
+
+    /* Let the pop batch grow up to 'config.maxSize' while the table has a backlog */
+    void setBatchConfig(const ConsumerBatchConfig &config) { m_batch = AdaptiveBatch(config); }
+    AdaptiveBatch &getBatch() { return m_batch; }
 
     /* Store the latest 'golden' status */
     // TODO: hide?
     SyncMap m_toSync;
 
 protected:
+    /* Hands over the entries it pops from the route ring */
+    friend class RouteRingConsumer;
+
     // Returns: the number of entries added to m_toSync
     size_t addToSync(std::deque<KeyOpFieldsValuesTuple> &entries);
+    void addToSync(KeyOpFieldsValuesTuple &entry);
+
+private:
+    AdaptiveBatch m_batch;
+
+    size_t m_budget = SIZE_MAX;
+    size_t m_executed = 0;
+    bool m_backlog = false;
 };
 
 typedef map<string, std::shared_ptr<Executor>> ConsumerMap;
@@ -182,8 +226,12 @@ public:
     // otherwise fallback to cold start
     virtual bool bake();
 
-    /* Iterate all consumers in m_consumerMap and run doTask(Consumer) */
-    virtual void doTask();
+    /* Iterate all consumers in m_consumerMap and run doTask(Consumer),
+     * returning the number of pending entries that got done */
+    virtual size_t doTask();
+
+    /* Table consumers of the orch, leaving out notifications and timers */
+    vector<Consumer *> getConsumers();
 
     /* Run doTask against a specific executor */
     virtual void doTask(Consumer &consumer) = 0;
@@ -194,6 +242,18 @@ public:
     static void recordTuple(Consumer &consumer, KeyOpFieldsValuesTuple &tuple);
 
     void dumpPendingTasks(vector<string> &ts);
+
+    /* Read the pop batch bounds of APPL_DB tables, before any orch is created */
+    static void loadConsumerBatchConfig(DBConnector *configDb);
+    /* Write the current pop batch of every table consumer to 'table' */
+    void publishConsumerBatches(Table &table);
+
+    /*
+     * Objects which can be referenced must be added and removed from their
+     * type map through these, so resolved references stay valid.
+     */
+    static void setReferencedObject(type_map &type_maps, const string &type_name, const string &object_name, sai_object_id_t object);
+    static void removeReferencedObject(type_map &type_maps, const string &type_name, const string &object_name);
 protected:
     ConsumerMap m_consumerMap;
 
@@ -204,11 +264,39 @@ protected:
     bool parseReference(type_map &type_maps, string &ref, string &table_name, string &object_name);
     ref_resolve_status resolveFieldRefArray(type_map&, const string&, KeyOpFieldsValuesTuple&, vector<sai_object_id_t>&);
 
+    /* Track the objects referenced by an entry of 'table_name' once it has been processed */
+    void updateObjectDependents(type_map &type_maps, const string &table_name, const KeyOpFieldsValuesTuple &tuple);
+    /* Queue again the entries referencing an object after it was updated */
+    size_t reapplyObjectDependents(const object_reference &object);
+
     /* Note: consumer will be owned by this class */
     void addExecutor(Executor* executor);
     Executor *getExecutor(string executorName);
 private:
     void addConsumer(DBConnector *db, string tableName, int pri = default_orch_pri);
+
+    struct ResolvedReference
+    {
+        const type_map *type_maps;
+        string type_name;
+        object_map::iterator object;
+    };
+
+    static const ResolvedReference *findResolvedReference(type_map &type_maps, const string &ref);
+
+    /* References resolved so far keyed by their string, and the strings resolved to each object */
+    static unordered_map<string, ResolvedReference> m_resolvedReferences;
+    static map<object_reference, set<string>> m_referenceStrings;
+
+    /* Last processed entry of a table referencing objects, and what it references */
+    struct ObjectDependent
+    {
+        KeyOpFieldsValuesTuple tuple;
+        set<object_reference> objects;
+    };
+
+    map<pair<string, string>, ObjectDependent> m_dependents;
+    map<object_reference, set<pair<string, string>>> m_objectDependents;
 };
 
 #include "request_parser.h"
@@ -1,4 +1,5 @@
 #include <unistd.h>
+#include <algorithm>
 #include <unordered_map>
 #include <limits.h>
 #include "orchdaemon.h"
@@ -15,9 +16,17 @@ using namespace swss;
 /* select() function timeout retry time */
 #define SELECT_TIMEOUT 1000
 #define PFC_WD_POLL_MSECS 100
+/* Loop latency statistics publishing interval */
+#define LOOP_STATS_PUBLISH_SECS 10
+/* Bound on warm restore rounds, should entries keep being queued back */
+#define WARM_RESTORE_MAX_ROUNDS 100
 
 extern sai_switch_api_t*           sai_switch_api;
 extern sai_object_id_t             gSwitchId;
+extern bool                        gTelemetryWorker;
+extern bool                        gRouteRing;
+extern size_t                      gFlushMaxOps;
+extern int                         gFlushMaxDelay;
 
 extern void syncd_apply_view();
 /*
@@ -33,11 +42,167 @@ CrmOrch *gCrmOrch;
 BufferOrch *gBufferOrch;
 SwitchOrch *gSwitchOrch;
 Directory<Orch*> gDirectory;
+recursive_mutex gOrchStateMutex;
+
+OrchLoopStats::OrchLoopStats(const string &name) :
+        m_name(name),
+        m_stateDb(STATE_DB, DBConnector::DEFAULT_UNIXSOCKET, 0),
+        m_statsTable(&m_stateDb, STATE_ORCH_LOOP_STATS_TABLE_NAME),
+        m_batchTable(&m_stateDb, STATE_CONSUMER_BATCH_TABLE_NAME),
+        m_lastPublish(chrono::steady_clock::now())
+{
+}
+
+void OrchLoopStats::record(chrono::steady_clock::duration busy)
+{
+    uint64_t usec = chrono::duration_cast<chrono::microseconds>(busy).count();
+
+    m_iterations++;
+    m_totalUsec += usec;
+    m_maxUsec = max(m_maxUsec, usec);
+
+    if (chrono::steady_clock::now() - m_lastPublish >= chrono::seconds(LOOP_STATS_PUBLISH_SECS))
+    {
+        publish();
+    }
+}
+
+void OrchLoopStats::publish()
+{
+    vector<FieldValueTuple> fvs = {
+        { "iterations", to_string(m_iterations) },
+        { "avg_usec",   to_string(m_iterations ? m_totalUsec / m_iterations : 0) },
+        { "max_usec",   to_string(m_maxUsec) }
+    };
+
+    if (m_flushPolicy)
+    {
+        FlushPolicy::Stats flushes = m_flushPolicy->takeStats();
+
+        fvs.emplace_back("flushes", to_string(flushes.flushes));
+        fvs.emplace_back("ops_per_flush", to_string(flushes.flushes ? flushes.ops / flushes.flushes : 0));
+        fvs.emplace_back("avg_flush_delay_usec", to_string(flushes.flushes ? flushes.totalDelayUsec / flushes.flushes : 0));
+        fvs.emplace_back("max_flush_delay_usec", to_string(flushes.maxDelayUsec));
+    }
+
+    m_statsTable.set(m_name, fvs);
+
+    for (Orch *o : m_orchList)
+    {
+        o->publishConsumerBatches(m_batchTable);
+    }
+
+    m_iterations = 0;
+    m_totalUsec = 0;
+    m_maxUsec = 0;
+    m_lastPublish = chrono::steady_clock::now();
+}
+
+OrchWorker::OrchWorker(const string &name) :
+        m_name(name),
+        m_running(false),
+        m_stats(name)
+{
+}
+
+OrchWorker::~OrchWorker()
+{
+    stop();
+}
+
+void OrchWorker::addOrch(Orch *orch)
+{
+    m_orchList.push_back(orch);
+}
+
+bool OrchWorker::hasOrch(Orch *orch) const
+{
+    return find(m_orchList.begin(), m_orchList.end(), orch) != m_orchList.end();
+}
+
+void OrchWorker::start()
+{
+    SWSS_LOG_ENTER();
+
+    for (Orch *o : m_orchList)
+    {
+        m_select.addSelectables(o->getSelectables());
+    }
+    m_stats.setOrchs(m_orchList);
+
+    m_running = true;
+    m_thread = thread(&OrchWorker::run, this);
+
+    SWSS_LOG_NOTICE("Started %s event loop with %zu orchs", m_name.c_str(), m_orchList.size());
+}
+
+void OrchWorker::stop()
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    m_running = false;
+    m_thread.join();
+}
+
+void OrchWorker::run()
+{
+    SWSS_LOG_ENTER();
+
+    while (m_running)
+    {
+        Selectable *s;
+        int ret;
+
+        ret = m_select.select(&s, SELECT_TIMEOUT);
+
+        if (ret == Select::ERROR)
+        {
+            SWSS_LOG_NOTICE("Error: %s!\n", strerror(errno));
+            continue;
+        }
+
+        if (ret == Select::TIMEOUT)
+        {
+            continue;
+        }
+
+        auto start = chrono::steady_clock::now();
+        auto *c = (Executor *)s;
+
+        /*
+         * Table consumers hand their tasks straight to the orch, run them
+         * like the main loop does. Timers and notifications are expected to
+         * lock only around the state they share with the main loop.
+         */
+        if (dynamic_cast<Consumer *>(c))
+        {
+            lock_guard<recursive_mutex> lock(gOrchStateMutex);
+            c->execute();
+        }
+        else
+        {
+            c->execute();
+        }
+
+        {
+            lock_guard<recursive_mutex> lock(gOrchStateMutex);
+            for (Orch *o : m_orchList)
+                o->doTask();
+        }
+
+        m_stats.record(chrono::steady_clock::now() - start);
+    }
+}
 
 OrchDaemon::OrchDaemon(DBConnector *applDb, DBConnector *configDb, DBConnector *stateDb) :
         m_applDb(applDb),
         m_configDb(configDb),
-        m_stateDb(stateDb)
+        m_stateDb(stateDb),
+        m_loopStats("main"),
+        m_flushPolicy(gFlushMaxOps, chrono::milliseconds(gFlushMaxDelay))
 {
     SWSS_LOG_ENTER();
 }
@@ -45,8 +210,14 @@ OrchDaemon::OrchDaemon(DBConnector *applDb, DBConnector *configDb, DBConnector *
 OrchDaemon::~OrchDaemon()
 {
     SWSS_LOG_ENTER();
+
+    /* Stop the worker before the orchs it runs go away */
+    delete m_worker;
+
     for (Orch *o : m_orchList)
         delete(o);
+
+    delete m_workerConfigDb;
 }
 
 bool OrchDaemon::init()
@@ -55,6 +226,8 @@ bool OrchDaemon::init()
 
     string platform = getenv("platform") ? getenv("platform") : "";
 
+    Orch::loadConsumerBatchConfig(m_configDb);
+
     gSwitchOrch = new SwitchOrch(m_applDb, APP_SWITCH_TABLE_NAME);
 
     const int portsorch_base_pri = 40;
@@ -67,7 +240,19 @@ bool OrchDaemon::init()
         { APP_LAG_MEMBER_TABLE_NAME,  portsorch_base_pri     }
     };
 
-    gCrmOrch = new CrmOrch(m_configDb, CFG_CRM_TABLE_NAME);
+    /*
+     * Telemetry orchs only poll counters and publish them, they may run on the
+     * worker event loop, which needs its own CONFIG_DB connection.
+     */
+    DBConnector *telemetryConfigDb = m_configDb;
+    if (gTelemetryWorker)
+    {
+        m_workerConfigDb = new DBConnector(CONFIG_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
+        m_worker = new OrchWorker("worker");
+        telemetryConfigDb = m_workerConfigDb;
+    }
+
+    gCrmOrch = new CrmOrch(telemetryConfigDb, CFG_CRM_TABLE_NAME);
     gPortsOrch = new PortsOrch(m_applDb, ports_tables);
     TableConnector applDbFdb(m_applDb, APP_FDB_TABLE_NAME);
     TableConnector stateDbFdb(m_stateDb, STATE_FDB_TABLE_NAME);
@@ -95,6 +280,14 @@ bool OrchDaemon::init()
     gIntfsOrch = new IntfsOrch(m_applDb, APP_INTF_TABLE_NAME, vrf_orch);
     gNeighOrch = new NeighOrch(m_applDb, APP_NEIGH_TABLE_NAME, gIntfsOrch);
     gRouteOrch = new RouteOrch(m_applDb, APP_ROUTE_TABLE_NAME, gNeighOrch);
+    if (gRouteRing)
+    {
+        gRouteOrch->enableRouteRing();
+    }
+    else
+    {
+        RouteRingReader::removeStale();
+    }
     CoppOrch  *copp_orch  = new CoppOrch(m_applDb, APP_COPP_TABLE_NAME);
     TunnelDecapOrch *tunnel_decap_orch = new TunnelDecapOrch(m_applDb, APP_TUNNEL_DECAP_TABLE_NAME);
 
@@ -148,7 +341,7 @@ bool OrchDaemon::init()
         CFG_DTEL_EVENT_TABLE_NAME
     };
 
-    WatermarkOrch *wm_orch = new WatermarkOrch(m_configDb, CFG_WATERMARK_TABLE_NAME);
+    WatermarkOrch *wm_orch = new WatermarkOrch(telemetryConfigDb, CFG_WATERMARK_TABLE_NAME);
 
     /*
      * The order of the orch list is important for state restore of warm start and
@@ -298,7 +491,19 @@ bool OrchDaemon::init()
                     PFC_WD_POLL_MSECS));
     }
 
-    m_orchList.push_back(&CounterCheckOrch::getInstance(m_configDb));
+    CounterCheckOrch *counter_check_orch = &CounterCheckOrch::getInstance(telemetryConfigDb);
+    m_orchList.push_back(counter_check_orch);
+
+    /*
+     * Worker orchs stay in m_orchList, warm restore and pending task dumps
+     * still cover them, but the main loop doesn't select on them.
+     */
+    if (m_worker)
+    {
+        m_worker->addOrch(gCrmOrch);
+        m_worker->addOrch(wm_orch);
+        m_worker->addOrch(counter_check_orch);
+    }
 
     if (WarmStart::isWarmStart())
     {
@@ -331,17 +536,35 @@ void OrchDaemon::start()
 {
     SWSS_LOG_ENTER();
 
+    vector<Orch *> mainOrchList;
+    OrchScheduler scheduler(m_select);
+
     for (Orch *o : m_orchList)
     {
-        m_select->addSelectables(o->getSelectables());
+        if (m_worker && m_worker->hasOrch(o))
+        {
+            continue;
+        }
+
+        mainOrchList.push_back(o);
+        scheduler.addSelectables(o->getSelectables());
+    }
+    m_loopStats.setOrchs(mainOrchList);
+    m_loopStats.setFlushPolicy(&m_flushPolicy);
+
+    SWSS_LOG_NOTICE("Flushing sairedis pipeline once idle, or every %zu operations or %d ms",
+                    gFlushMaxOps, gFlushMaxDelay);
+
+    if (m_worker)
+    {
+        m_worker->start();
     }
 
     while (true)
     {
-        Selectable *s;
         int ret;
 
-        ret = m_select->select(&s, SELECT_TIMEOUT);
+        ret = scheduler.wait(SELECT_TIMEOUT);
 
         if (ret == Select::ERROR)
         {
@@ -354,23 +577,35 @@ void OrchDaemon::start()
             continue;
         }
 
-        auto *c = (Executor *)s;
-        c->execute();
+        auto start = chrono::steady_clock::now();
+        lock_guard<recursive_mutex> lock(gOrchStateMutex);
 
-        /* After each iteration, periodically check all m_toSync map to
+        size_t ops = scheduler.runRound();
+
+        /* After each round, periodically check all m_toSync map to
          * execute all the remaining tasks that need to be retried. */
 
         /* TODO: Abstract Orch class to have a specific todo list */
-        for (Orch *o : m_orchList)
-            o->doTask();
+        /* Retries done here issue SAI calls too, so count them toward the flush */
+        for (Orch *o : mainOrchList)
+            ops += o->doTask();
 
         /* Let sairedis to flush all SAI function call to ASIC DB.
          * Normally the redis pipeline will flush when enough request
          * accumulated. Still it is possible that small amount of
          * requests live in it. When the daemon has finished events/tasks, it
          * is a good chance to flush the pipeline before next select happened.
+         * While more events are waiting, keep them going to the pipeline,
+         * up to the flush policy limits.
          */
-        flush();
+        auto now = chrono::steady_clock::now();
+        m_flushPolicy.add(ops, now);
+
+        if (m_flushPolicy.due(scheduler.wait(0) != Select::OBJECT, now))
+        {
+            flush();
+            m_flushPolicy.flushed(chrono::steady_clock::now());
+        }
 
         /*
          * Asked to check warm restart readiness.
@@ -404,9 +639,124 @@ void OrchDaemon::start()
                 }
             }
         }
+
+        m_loopStats.record(chrono::steady_clock::now() - start);
     }
 }
 
+/*
+ * Process the data baked into the consumers until none of them can make any
+ * more progress.
+ *
+ * Entries wait for others, often of another orch: ports for port init, LAG
+ * and VLAN members for their LAG and VLAN, buffer profiles for their pool,
+ * and so on. A consumer is drained again if its previous drain processed
+ * some of its entries, if any consumer processed some since, which it may
+ * have been waiting for, or if entries were queued to it meanwhile. Those
+ * which are empty, or stalled with nothing new to wait for, are skipped.
+ */
+void OrchDaemon::warmRestoreConverge()
+{
+    SWSS_LOG_ENTER();
+
+    struct Progress
+    {
+        Consumer   *consumer;
+        size_t      pending;        // after its previous drain
+        bool        shrank;         // its previous drain processed entries
+        uint64_t    epoch;          // progress made overall as of its previous drain
+        uint64_t    usec;           // total time spent draining it
+    };
+
+    vector<Progress> consumers;
+    uint64_t epoch = 1;
+    size_t pending = 0;
+
+    for (Orch *o : m_orchList)
+    {
+        for (Consumer *consumer : o->getConsumers())
+        {
+            consumers.push_back({ consumer, consumer->m_toSync.size(), false, 0, 0 });
+            pending += consumer->m_toSync.size();
+        }
+    }
+
+    auto start = chrono::steady_clock::now();
+    bool converged = false;
+    int round;
+
+    SWSS_LOG_NOTICE("Warm restore: %zu entries pending in %zu consumers", pending, consumers.size());
+
+    for (round = 1; round <= WARM_RESTORE_MAX_ROUNDS; round++)
+    {
+        auto roundStart = chrono::steady_clock::now();
+        size_t drained = 0;
+        size_t before = pending;
+
+        for (auto &p : consumers)
+        {
+            size_t count = p.consumer->m_toSync.size();
+
+            if (count == 0 || (!p.shrank && p.epoch == epoch && count == p.pending))
+            {
+                continue;
+            }
+
+            auto drainStart = chrono::steady_clock::now();
+            p.consumer->drain();
+            uint64_t usec = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - drainStart).count();
+
+            p.pending = p.consumer->m_toSync.size();
+            p.shrank = p.pending < count;
+            p.usec += usec;
+            if (p.shrank)
+            {
+                epoch++;
+            }
+            p.epoch = epoch;
+            drained++;
+
+            SWSS_LOG_NOTICE("Warm restore round %d: %s %zu -> %zu pending in %lu us",
+                            round, p.consumer->getName().c_str(), count, p.pending, usec);
+        }
+
+        if (drained == 0)
+        {
+            converged = true;
+            break;
+        }
+
+        pending = 0;
+        for (auto &p : consumers)
+        {
+            pending += p.consumer->m_toSync.size();
+        }
+
+        SWSS_LOG_NOTICE("Warm restore round %d: drained %zu consumers, %zu -> %zu pending in %ld ms",
+                        round, drained, before, pending,
+                        chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - roundStart).count());
+    }
+
+    if (!converged)
+    {
+        SWSS_LOG_WARN("Warm restore still making progress after %d rounds, giving up", WARM_RESTORE_MAX_ROUNDS);
+    }
+
+    for (auto &p : consumers)
+    {
+        if (p.usec)
+        {
+            SWSS_LOG_INFO("Warm restore: %s took %lu us, %zu left pending",
+                          p.consumer->getName().c_str(), p.usec, p.pending);
+        }
+    }
+
+    SWSS_LOG_NOTICE("Warm restore done in %d rounds, %ld ms, %zu entries left pending",
+                    round - 1,
+                    chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count(),
+                    pending);
+}
+
 /*
  * Try to perform orchagent state restore and dynamic states sync up if
  * warm start reqeust is detected.
@@ -420,26 +770,7 @@ bool OrchDaemon::warmRestoreAndSyncUp()
         o->bake();
     }
 
-    /*
-     * Four iterations are needed.
-     *
-     * First iteration: switchorch, Port init/hostif create part of portorch.
-     *
-     * Second iteratoin: gBufferOrch which requires port created,
-     *   then port speed/mtu/fec_mode/pfc_asym/admin_status config.
-     *
-     * Third iteration: other orch(s) which wait for port init done.
-     *
-     * Fourth iteration: Drain remaining data that are out of order like LAG_MEMBER_TABLE and
-     * VLAN_MEMBER_TABLE since they were checked before LAG_TABLE and VLAN_TABLE within gPortsOrch.
-     */
-    for (auto it = 0; it < 4; it++)
-    {
-        for (Orch *o : m_orchList)
-        {
-            o->doTask();
-        }
-    }
+    warmRestoreConverge();
 
     /*
      * At this point, all the pre-existing data should have been processed properly, and
@@ -1,6 +1,10 @@
 #ifndef SWSS_ORCHDAEMON_H
 #define SWSS_ORCHDAEMON_H
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "consumertable.h"
@@ -27,9 +31,74 @@
 #include "flexcounterorch.h"
 #include "watermarkorch.h"
 #include "directory.h"
+#include "orchscheduler.h"
+#include "flushpolicy.h"
 
 using namespace swss;
 
+#define STATE_ORCH_LOOP_STATS_TABLE_NAME "ORCH_LOOP_STATS_TABLE"
+
+/*
+ * Per event loop latency accounting. Busy time of every loop iteration is
+ * accumulated and periodically published to STATE_DB ORCH_LOOP_STATS_TABLE,
+ * along with the sairedis flushes of the loop, if it does any, and the pop
+ * batch sizes of its consumers.
+ */
+class OrchLoopStats
+{
+public:
+    OrchLoopStats(const string &name);
+
+    void setOrchs(const vector<Orch *> &orchs) { m_orchList = orchs; }
+    void setFlushPolicy(FlushPolicy *policy) { m_flushPolicy = policy; }
+    void record(chrono::steady_clock::duration busy);
+
+private:
+    string m_name;
+    DBConnector m_stateDb;
+    Table m_statsTable;
+    Table m_batchTable;
+    vector<Orch *> m_orchList;
+    FlushPolicy *m_flushPolicy = nullptr;
+
+    uint64_t m_iterations = 0;
+    uint64_t m_totalUsec = 0;
+    uint64_t m_maxUsec = 0;
+    chrono::steady_clock::time_point m_lastPublish;
+
+    void publish();
+};
+
+/*
+ * Event loop running a set of orchs on a dedicated thread, so that their
+ * timers and slow counter polling don't delay APPL_DB/CONFIG_DB processing
+ * in the main loop. Orchs assigned to the worker must be built on their own
+ * DBConnector and take gOrchStateMutex around any state shared with the
+ * main loop.
+ */
+class OrchWorker
+{
+public:
+    OrchWorker(const string &name);
+    ~OrchWorker();
+
+    void addOrch(Orch *orch);
+    bool hasOrch(Orch *orch) const;
+
+    void start();
+    void stop();
+
+private:
+    string m_name;
+    vector<Orch *> m_orchList;
+    Select m_select;
+    thread m_thread;
+    atomic<bool> m_running;
+    OrchLoopStats m_stats;
+
+    void run();
+};
+
 class OrchDaemon
 {
 public:
@@ -41,6 +110,7 @@ public:
     bool warmRestoreAndSyncUp();
     void getTaskToSync(vector<string> &ts);
     bool warmRestoreValidation();
+    void warmRestoreConverge();
 
     bool warmRestartCheck();
 private:
@@ -51,6 +121,11 @@ private:
     std::vector<Orch *> m_orchList;
     Select *m_select;
 
+    DBConnector *m_workerConfigDb = nullptr;
+    OrchWorker *m_worker = nullptr;
+    OrchLoopStats m_loopStats;
+    FlushPolicy m_flushPolicy;
+
     void flush();
 };
 
@@ -0,0 +1,158 @@
+#include "orchscheduler.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <string.h>
+
+#include "logger.h"
+
+using namespace std;
+using namespace swss;
+
+OrchScheduler::OrchScheduler(Select *select, chrono::milliseconds roundBudget, size_t quantum) :
+    m_select(select),
+    m_roundBudget(roundBudget),
+    m_quantum(quantum)
+{
+}
+
+void OrchScheduler::addSelectables(const vector<Selectable *> &selectables)
+{
+    m_select->addSelectables(selectables);
+}
+
+/* Move the executors Select reports ready to the queue */
+int OrchScheduler::gather(int timeout)
+{
+    Selectable *s;
+    int ret = m_select->select(&s, timeout);
+
+    while (ret == Select::OBJECT)
+    {
+        m_select->removeSelectable(s);
+        m_queue.push_back({ static_cast<Executor *>(s), 0, false, false, false });
+
+        ret = m_select->select(&s, 0);
+    }
+
+    return ret;
+}
+
+/* Highest priority executor not served yet in this round */
+list<OrchScheduler::Entry>::iterator OrchScheduler::next()
+{
+    auto best = m_queue.end();
+
+    for (auto it = m_queue.begin(); it != m_queue.end(); it++)
+    {
+        if (!it->served && (best == m_queue.end() ||
+                            it->executor->getPri() > best->executor->getPri()))
+        {
+            best = it;
+        }
+    }
+
+    return best;
+}
+
+size_t OrchScheduler::serve(list<Entry>::iterator entry)
+{
+    Executor *executor = entry->executor;
+    bool contended = m_queue.size() > 1;
+    size_t executed;
+
+    entry->served = true;
+
+    if (contended)
+    {
+        entry->deficit += (int64_t)(m_quantum * weight(executor->getPri()));
+
+        /* Still paying back what it took in over its budget */
+        if (entry->deficit <= 0)
+        {
+            return 0;
+        }
+
+        executor->setBudget((size_t)entry->deficit);
+    }
+    else
+    {
+        /* Nobody to be fair to */
+        entry->deficit = 0;
+    }
+
+    executor->execute();
+    executed = executor->getExecuted();
+
+    if (contended)
+    {
+        entry->deficit -= (int64_t)executed;
+    }
+
+    if (!executor->hasBacklog())
+    {
+        /* Caught up, wait for more in Select */
+        m_queue.erase(entry);
+        m_select->addSelectable(executor);
+    }
+
+    /* Timers and notifications take in no entries, but still do some work */
+    return max(executed, (size_t)1);
+}
+
+int OrchScheduler::wait(int timeout)
+{
+    int ret = gather(m_queue.empty() ? timeout : 0);
+
+    if (ret == Select::ERROR)
+    {
+        return ret;
+    }
+
+    return m_queue.empty() ? Select::TIMEOUT : Select::OBJECT;
+}
+
+size_t OrchScheduler::runRound()
+{
+    auto start = chrono::steady_clock::now();
+    bool first = true;
+    size_t executed = 0;
+
+    for (auto &entry : m_queue)
+    {
+        entry.served = false;
+    }
+
+    while (true)
+    {
+        /* Let executors which just got ready compete for the next turn */
+        if (!first && gather(0) == Select::ERROR)
+        {
+            SWSS_LOG_NOTICE("Error: %s!", strerror(errno));
+        }
+        first = false;
+
+        auto entry = next();
+        if (entry == m_queue.end())
+        {
+            break;
+        }
+
+        if (!entry->deferred && chrono::steady_clock::now() - start >= m_roundBudget)
+        {
+            entry->served = true;
+            entry->deferNext = true;
+            continue;
+        }
+
+        executed += serve(entry);
+    }
+
+    for (auto &entry : m_queue)
+    {
+        entry.deferred = entry.deferNext;
+        entry.deferNext = false;
+    }
+
+    return executed;
+}
@@ -0,0 +1,84 @@
+#ifndef SWSS_ORCHSCHEDULER_H
+#define SWSS_ORCHSCHEDULER_H
+
+#include <chrono>
+#include <list>
+#include <stdint.h>
+#include <vector>
+
+#include "select.h"
+#include "orch.h"
+
+/* Entries a priority 0 consumer may take in per round while others wait */
+#define ORCH_SCHED_QUANTUM              64
+/* Time after which the executors left in a round are deferred to the next */
+#define ORCH_SCHED_ROUND_BUDGET_MSECS   20
+
+/*
+ * Weighted round robin over the executors of an event loop.
+ *
+ * Executors Select reports ready are taken out of it and queued. A round
+ * serves each queued executor once, highest priority first, looking for
+ * newly ready executors between two turns, so a higher priority executor
+ * never waits for more than the turn in progress.
+ *
+ * While others are queued, an executor takes in at most its deficit: a
+ * quantum of entries weighted by its priority, accumulated for as long as
+ * it stays backlogged. Consumers take entries in by whole pop batches, so
+ * may go over; what they overspend is carried over as a negative deficit,
+ * and they sit out their turns until the quanta of the next rounds have
+ * paid it back. Executors which ran out of budget keep their place in the
+ * queue, the others go back to Select.
+ *
+ * Once a round has run past its time budget, the executors it didn't serve
+ * yet are deferred to the next round, which serves them whatever its own
+ * time budget.
+ */
+class OrchScheduler
+{
+public:
+    OrchScheduler(Select *select,
+                  std::chrono::milliseconds roundBudget = std::chrono::milliseconds(ORCH_SCHED_ROUND_BUDGET_MSECS),
+                  size_t quantum = ORCH_SCHED_QUANTUM);
+
+    void addSelectables(const std::vector<Selectable *> &selectables);
+
+    /*
+     * Wait up to 'timeout' ms for executors to get ready, unless some are
+     * queued already. Returns Select::OBJECT once there are executors to
+     * serve, otherwise Select::TIMEOUT or Select::ERROR.
+     */
+    int wait(int timeout);
+
+    /*
+     * Serve the queued executors for one round. Returns the entries they
+     * took in, counting at least one for each turn.
+     */
+    size_t runRound();
+
+    /* Weight of the executors of priority 'pri' */
+    static size_t weight(int pri) { return 1 + (size_t)(pri > 0 ? pri : 0) / 5; }
+
+    size_t queued() const { return m_queue.size(); }
+
+private:
+    struct Entry
+    {
+        Executor   *executor;
+        int64_t     deficit;        // negative after taking in more than the budget
+        bool        served;
+        bool        deferred;       // left over by the previous round
+        bool        deferNext;      // left over by this round
+    };
+
+    Select *m_select;
+    std::chrono::milliseconds m_roundBudget;
+    size_t m_quantum;
+    std::list<Entry> m_queue;
+
+    int gather(int timeout);
+    std::list<Entry>::iterator next();
+    size_t serve(std::list<Entry>::iterator entry);
+};
+
+#endif /* SWSS_ORCHSCHEDULER_H */
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <tuple>
 #include <sstream>
+#include <chrono>
 
 #include <netinet/if_ether.h>
 #include "net/if.h"
@@ -22,6 +23,7 @@
 #include "crmorch.h"
 #include "countercheckorch.h"
 #include "notifier.h"
+#include "saibulk.h"
 
 extern sai_switch_api_t *sai_switch_api;
 extern sai_bridge_api_t *sai_bridge_api;
@@ -145,24 +147,25 @@ PortsOrch::PortsOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames)
 
     /* Initialize counter table */
     m_counter_db = shared_ptr<DBConnector>(new DBConnector(COUNTERS_DB, DBConnector::DEFAULT_UNIXSOCKET, 0));
-    m_counterTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_PORT_NAME_MAP));
+    m_counterPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_counter_db.get()));
+    m_counterTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_PORT_NAME_MAP, true));
 
     /* Initialize port table */
     m_portTable = unique_ptr<Table>(new Table(db, APP_PORT_TABLE_NAME));
 
     /* Initialize queue tables */
-    m_queueTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_NAME_MAP));
-    m_queuePortTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_PORT_MAP));
-    m_queueIndexTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_INDEX_MAP));
-    m_queueTypeTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_TYPE_MAP));
+    m_queueTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_QUEUE_NAME_MAP, true));
+    m_queuePortTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_QUEUE_PORT_MAP, true));
+    m_queueIndexTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_QUEUE_INDEX_MAP, true));
+    m_queueTypeTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_QUEUE_TYPE_MAP, true));
 
     /* Initialize ingress priority group tables */
-    m_pgTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_PG_NAME_MAP));
-    m_pgPortTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_PG_PORT_MAP));
-    m_pgIndexTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_PG_INDEX_MAP));
+    m_pgTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_PG_NAME_MAP, true));
+    m_pgPortTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_PG_PORT_MAP, true));
+    m_pgIndexTable = unique_ptr<Table>(new Table(m_counterPipeline.get(), COUNTERS_PG_INDEX_MAP, true));
 
     m_flex_db = shared_ptr<DBConnector>(new DBConnector(FLEX_COUNTER_DB, DBConnector::DEFAULT_UNIXSOCKET, 0));
-    m_flexCounterTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_TABLE));
+    m_flexCounters = unique_ptr<FlexCounterBatch>(new FlexCounterBatch(m_flex_db.get()));
     m_flexCounterGroupTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_GROUP_TABLE));
 
     vector<FieldValueTuple> fields;
@@ -1249,51 +1252,77 @@ void PortsOrch::updateDbPortOperStatus(const Port& port, sai_port_oper_status_t
     m_portTable->set(port.m_alias, tuples);
 }
 
-bool PortsOrch::addPort(const set<int> &lane_set, uint32_t speed, int an, string fec_mode)
+bool PortsOrch::addPorts(const map<set<int>, tuple<string, uint32_t, int, string>> &ports)
 {
     SWSS_LOG_ENTER();
 
-    vector<uint32_t> lanes(lane_set.begin(), lane_set.end());
+    vector<set<int>> lane_sets;
+    vector<vector<uint32_t>> lanes;
+    vector<vector<sai_attribute_t>> attrs;
 
-    sai_attribute_t attr;
-    vector<sai_attribute_t> attrs;
+    lanes.reserve(ports.size());
+    for (const auto &it : ports)
+    {
+        uint32_t speed = get<1>(it.second);
+        int an = get<2>(it.second);
+        const string &fec_mode = get<3>(it.second);
 
-    attr.id = SAI_PORT_ATTR_SPEED;
-    attr.value.u32 = speed;
-    attrs.push_back(attr);
+        lane_sets.push_back(it.first);
+        lanes.emplace_back(it.first.begin(), it.first.end());
 
-    attr.id = SAI_PORT_ATTR_HW_LANE_LIST;
-    attr.value.u32list.list = lanes.data();
-    attr.value.u32list.count = static_cast<uint32_t>(lanes.size());
-    attrs.push_back(attr);
+        sai_attribute_t attr;
+        vector<sai_attribute_t> port_attrs;
 
-    if (an == true)
-    {
-        attr.id = SAI_PORT_ATTR_AUTO_NEG_MODE;
-        attr.value.booldata = true;
-        attrs.push_back(attr);
-    }
+        attr.id = SAI_PORT_ATTR_SPEED;
+        attr.value.u32 = speed;
+        port_attrs.push_back(attr);
 
-    if (!fec_mode.empty())
-    {
-        attr.id = SAI_PORT_ATTR_FEC_MODE;
-        attr.value.u32 = fec_mode_map[fec_mode];
-        attrs.push_back(attr);
+        attr.id = SAI_PORT_ATTR_HW_LANE_LIST;
+        attr.value.u32list.list = lanes.back().data();
+        attr.value.u32list.count = static_cast<uint32_t>(lanes.back().size());
+        port_attrs.push_back(attr);
+
+        if (an == true)
+        {
+            attr.id = SAI_PORT_ATTR_AUTO_NEG_MODE;
+            attr.value.booldata = true;
+            port_attrs.push_back(attr);
+        }
+
+        if (!fec_mode.empty())
+        {
+            attr.id = SAI_PORT_ATTR_FEC_MODE;
+            attr.value.u32 = fec_mode_map[fec_mode];
+            port_attrs.push_back(attr);
+        }
+
+        attrs.push_back(port_attrs);
     }
 
-    sai_object_id_t port_id;
-    sai_status_t status = sai_port_api->create_port(&port_id, gSwitchId, static_cast<uint32_t>(attrs.size()), attrs.data());
-    if (status != SAI_STATUS_SUCCESS)
+    /*
+     * The port API of the SAI version in use has no bulk create entry point,
+     * the helper issues one create_port per port.
+     */
+    vector<sai_object_id_t> ids;
+    vector<sai_status_t> statuses;
+    bulkCreateObjects(nullptr, sai_port_api->create_port, gSwitchId, attrs, ids, statuses);
+
+    bool rc = true;
+    for (size_t i = 0; i < attrs.size(); i++)
     {
-        SWSS_LOG_ERROR("Failed to create port with the speed %u, rv:%d", speed, status);
-        return false;
-    }
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create port with the speed %u, rv:%d", attrs[i][0].value.u32, statuses[i]);
+            rc = false;
+            continue;
+        }
 
-    m_portListLaneMap[lane_set] = port_id;
+        m_portListLaneMap[lane_sets[i]] = ids[i];
 
-    SWSS_LOG_NOTICE("Create port %lx with the speed %u", port_id, speed);
+        SWSS_LOG_NOTICE("Create port %lx with the speed %u", ids[i], attrs[i][0].value.u32);
+    }
 
-    return true;
+    return rc;
 }
 
 bool PortsOrch::removePort(sai_object_id_t port_id)
@@ -1319,26 +1348,6 @@ bool PortsOrch::removePort(sai_object_id_t port_id)
     return true;
 }
 
-string PortsOrch::getPortFlexCounterTableKey(string key)
-{
-    return string(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP) + ":" + key;
-}
-
-string PortsOrch::getQueueFlexCounterTableKey(string key)
-{
-    return string(QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP) + ":" + key;
-}
-
-string PortsOrch::getQueueWatermarkFlexCounterTableKey(string key)
-{
-    return string(QUEUE_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP) + ":" + key;
-}
-
-string PortsOrch::getPriorityGroupWatermarkFlexCounterTableKey(string key)
-{
-    return string(PG_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP) + ":" + key;
-}
-
 bool PortsOrch::initPort(const string &alias, const set<int> &lane_set)
 {
     SWSS_LOG_ENTER();
@@ -1372,19 +1381,9 @@ bool PortsOrch::initPort(const string &alias, const set<int> &lane_set)
                 m_counterTable->set("", fields);
 
                 /* Add port to flex_counter for updating stat counters  */
-                string key = getPortFlexCounterTableKey(sai_serialize_object_id(p.m_port_id));
-                std::string delimiter = "";
-                std::ostringstream counters_stream;
-                for (const auto &id: portStatIds)
-                {
-                    counters_stream << delimiter << sai_serialize_port_stat(id);
-                    delimiter = comma;
-                }
-
-                fields.clear();
-                fields.emplace_back(PORT_COUNTER_ID_LIST, counters_stream.str());
-
-                m_flexCounterTable->set(key, fields);
+                static const string portCounterIds = serializeCounterIds(portStatIds, sai_serialize_port_stat);
+                m_flexCounters->add(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP, sai_serialize_object_id(p.m_port_id),
+                                    PORT_COUNTER_ID_LIST, portCounterIds);
 
                 PortUpdate update = {p, true };
                 notify(SUBJECT_TYPE_PORT_CHANGE, static_cast<void *>(&update));
@@ -1407,6 +1406,107 @@ bool PortsOrch::initPort(const string &alias, const set<int> &lane_set)
     return true;
 }
 
+/*
+ * Bring up all ports received from the port table at once:
+ * 1. Remove ports which don't exist anymore
+ * 2. Create new ports in a single batch
+ * 3. Initialize all ports, buffering their counter table entries
+ * 4. Write all counter table entries in one go
+ */
+void PortsOrch::initPorts()
+{
+    SWSS_LOG_ENTER();
+
+    auto start = chrono::steady_clock::now();
+
+    // work around to avoid syncd termination on SAI error due missing create_port SAI API
+    // can be removed when SAI redis return NotImplemented error
+    char *platform = getenv("platform");
+    bool canCreatePorts = platform && (strstr(platform, BFN_PLATFORM_SUBSTRING) || strstr(platform, MLNX_PLATFORM_SUBSTRING));
+
+    for (auto it = m_portListLaneMap.begin(); it != m_portListLaneMap.end();)
+    {
+        if (m_lanesAliasSpeedMap.find(it->first) == m_lanesAliasSpeedMap.end())
+        {
+            if (canCreatePorts)
+            {
+                if (!removePort(it->second))
+                {
+                    throw runtime_error("PortsOrch initialization failure.");
+                }
+            }
+            else
+            {
+                SWSS_LOG_NOTICE("Failed to remove Port %lx due to missing SAI remove_port API.", it->second);
+            }
+
+            it = m_portListLaneMap.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+
+    map<set<int>, tuple<string, uint32_t, int, string>> newPorts;
+    for (const auto &it : m_lanesAliasSpeedMap)
+    {
+        if (m_portListLaneMap.find(it.first) == m_portListLaneMap.end())
+        {
+            if (canCreatePorts)
+            {
+                newPorts.insert(it);
+            }
+            else
+            {
+                SWSS_LOG_NOTICE("Failed to create Port %s due to missing SAI create_port API.", get<0>(it.second).c_str());
+            }
+        }
+    }
+
+    if (!addPorts(newPorts))
+    {
+        throw runtime_error("PortsOrch initialization failure.");
+    }
+
+    auto created = chrono::steady_clock::now();
+
+    size_t count = 0;
+    for (auto it = m_lanesAliasSpeedMap.begin(); it != m_lanesAliasSpeedMap.end();)
+    {
+        if (m_portListLaneMap.find(it->first) != m_portListLaneMap.end())
+        {
+            if (!initPort(get<0>(it->second), it->first))
+            {
+                throw runtime_error("PortsOrch initialization failure.");
+            }
+            count++;
+        }
+
+        it = m_lanesAliasSpeedMap.erase(it);
+    }
+
+    auto initialized = chrono::steady_clock::now();
+
+    flushCounterTables();
+
+    auto flushed = chrono::steady_clock::now();
+
+    using msecs = chrono::milliseconds;
+    SWSS_LOG_NOTICE("Initialized %zu ports (%zu created) in %ld ms: create %ld ms, initialize %ld ms, counters %ld ms",
+                    count, newPorts.size(),
+                    (long)chrono::duration_cast<msecs>(flushed - start).count(),
+                    (long)chrono::duration_cast<msecs>(created - start).count(),
+                    (long)chrono::duration_cast<msecs>(initialized - created).count(),
+                    (long)chrono::duration_cast<msecs>(flushed - initialized).count());
+}
+
+void PortsOrch::flushCounterTables()
+{
+    m_counterPipeline->flush();
+    m_flexCounters->flush();
+}
+
 bool PortsOrch::bake()
 {
     SWSS_LOG_ENTER();
@@ -1589,76 +1689,10 @@ void PortsOrch::doPortTask(Consumer &consumer)
             // the complete m_lanesAliasSpeedMap may be populated again, so initPort() will be called more than once
             // for the same port.
 
-            /* Once all ports received, go through the each port and perform appropriate actions:
-             * 1. Remove ports which don't exist anymore
-             * 2. Create new ports
-             * 3. Initialize all ports
-             */
+            /* Once all ports received, remove, create and initialize them in one batch */
             if (m_portConfigDone && (m_lanesAliasSpeedMap.size() == m_portCount))
             {
-                for (auto it = m_portListLaneMap.begin(); it != m_portListLaneMap.end();)
-                {
-                    if (m_lanesAliasSpeedMap.find(it->first) == m_lanesAliasSpeedMap.end())
-                    {
-                        char *platform = getenv("platform");
-                        if (platform && (strstr(platform, BFN_PLATFORM_SUBSTRING) || strstr(platform, MLNX_PLATFORM_SUBSTRING)))
-                        {
-                            if (!removePort(it->second))
-                            {
-                                throw runtime_error("PortsOrch initialization failure.");
-                            }
-                        }
-                        else
-                        {
-                            SWSS_LOG_NOTICE("Failed to remove Port %lx due to missing SAI remove_port API.", it->second);
-                        }
-
-                        it = m_portListLaneMap.erase(it);
-                    }
-                    else
-                    {
-                        it++;
-                    }
-                }
-
-                for (auto it = m_lanesAliasSpeedMap.begin(); it != m_lanesAliasSpeedMap.end();)
-                {
-                    bool port_created = false;
-
-                    if (m_portListLaneMap.find(it->first) == m_portListLaneMap.end())
-                    {
-                        // work around to avoid syncd termination on SAI error due missing create_port SAI API
-                        // can be removed when SAI redis return NotImplemented error
-                        char *platform = getenv("platform");
-                        if (platform && (strstr(platform, BFN_PLATFORM_SUBSTRING) || strstr(platform, MLNX_PLATFORM_SUBSTRING)))
-                        {
-                            if (!addPort(it->first, get<1>(it->second), get<2>(it->second), get<3>(it->second)))
-                            {
-                                throw runtime_error("PortsOrch initialization failure.");
-                            }
-
-                            port_created = true;
-                        }
-                        else
-                        {
-                            SWSS_LOG_NOTICE("Failed to create Port %s due to missing SAI create_port API.", get<0>(it->second).c_str());
-                        }
-                    }
-                    else
-                    {
-                        port_created = true;
-                    }
-
-                    if (port_created)
-                    {
-                        if (!initPort(get<0>(it->second), it->first))
-                        {
-                            throw runtime_error("PortsOrch initialization failure.");
-                        }
-                    }
-
-                    it = m_lanesAliasSpeedMap.erase(it);
-                }
+                initPorts();
             }
 
             if (!m_portConfigDone)
@@ -2315,73 +2349,67 @@ void PortsOrch::doTask(Consumer &consumer)
     }
 }
 
-void PortsOrch::initializeQueues(Port &port)
+/*
+ * Read the port attributes needed at initialization with two get calls, one
+ * for the queue and priority group counts along with the admin state and
+ * speed, one for the queue and priority group lists.
+ */
+void PortsOrch::initializePortAttributes(Port &port)
 {
     SWSS_LOG_ENTER();
 
-    sai_attribute_t attr;
-    attr.id = SAI_PORT_ATTR_QOS_NUMBER_OF_QUEUES;
-    sai_status_t status = sai_port_api->get_port_attribute(port.m_port_id, 1, &attr);
+    sai_attribute_t attrs[4];
+    attrs[0].id = SAI_PORT_ATTR_QOS_NUMBER_OF_QUEUES;
+    attrs[1].id = SAI_PORT_ATTR_NUMBER_OF_INGRESS_PRIORITY_GROUPS;
+    attrs[2].id = SAI_PORT_ATTR_ADMIN_STATE;
+    attrs[3].id = SAI_PORT_ATTR_SPEED;
+
+    sai_status_t status = sai_port_api->get_port_attribute(port.m_port_id, 4, attrs);
     if (status != SAI_STATUS_SUCCESS)
     {
-        SWSS_LOG_ERROR("Failed to get number of queues for port %s rv:%d", port.m_alias.c_str(), status);
+        SWSS_LOG_ERROR("Failed to get initial attributes for port %s rv:%d", port.m_alias.c_str(), status);
         throw runtime_error("PortsOrch initialization failure.");
     }
-    SWSS_LOG_INFO("Get %d queues for port %s", attr.value.u32, port.m_alias.c_str());
+    SWSS_LOG_INFO("Get %d queues and %d priority groups for port %s",
+                  attrs[0].value.u32, attrs[1].value.u32, port.m_alias.c_str());
 
-    port.m_queue_ids.resize(attr.value.u32);
+    port.m_queue_ids.resize(attrs[0].value.u32);
+    port.m_priority_group_ids.resize(attrs[1].value.u32);
+    port.m_admin_state_up = attrs[2].value.booldata;
+    port.m_speed = attrs[3].value.u32;
 
-    if (attr.value.u32 == 0)
-    {
-        return;
-    }
-
-    attr.id = SAI_PORT_ATTR_QOS_QUEUE_LIST;
-    attr.value.objlist.count = (uint32_t)port.m_queue_ids.size();
-    attr.value.objlist.list = port.m_queue_ids.data();
+    vector<sai_attribute_t> lists;
+    sai_attribute_t attr;
 
-    status = sai_port_api->get_port_attribute(port.m_port_id, 1, &attr);
-    if (status != SAI_STATUS_SUCCESS)
+    if (!port.m_queue_ids.empty())
     {
-        SWSS_LOG_ERROR("Failed to get queue list for port %s rv:%d", port.m_alias.c_str(), status);
-        throw runtime_error("PortsOrch initialization failure.");
+        attr.id = SAI_PORT_ATTR_QOS_QUEUE_LIST;
+        attr.value.objlist.count = (uint32_t)port.m_queue_ids.size();
+        attr.value.objlist.list = port.m_queue_ids.data();
+        lists.push_back(attr);
     }
 
-    SWSS_LOG_INFO("Get queues for port %s", port.m_alias.c_str());
-}
-
-void PortsOrch::initializePriorityGroups(Port &port)
-{
-    SWSS_LOG_ENTER();
-
-    sai_attribute_t attr;
-    attr.id = SAI_PORT_ATTR_NUMBER_OF_INGRESS_PRIORITY_GROUPS;
-    sai_status_t status = sai_port_api->get_port_attribute(port.m_port_id, 1, &attr);
-    if (status != SAI_STATUS_SUCCESS)
+    if (!port.m_priority_group_ids.empty())
     {
-        SWSS_LOG_ERROR("Failed to get number of priority groups for port %s rv:%d", port.m_alias.c_str(), status);
-        throw runtime_error("PortsOrch initialization failure.");
+        attr.id = SAI_PORT_ATTR_INGRESS_PRIORITY_GROUP_LIST;
+        attr.value.objlist.count = (uint32_t)port.m_priority_group_ids.size();
+        attr.value.objlist.list = port.m_priority_group_ids.data();
+        lists.push_back(attr);
     }
-    SWSS_LOG_INFO("Get %d priority groups for port %s", attr.value.u32, port.m_alias.c_str());
 
-    port.m_priority_group_ids.resize(attr.value.u32);
-
-    if (attr.value.u32 == 0)
+    if (lists.empty())
     {
         return;
     }
 
-    attr.id = SAI_PORT_ATTR_INGRESS_PRIORITY_GROUP_LIST;
-    attr.value.objlist.count = (uint32_t)port.m_priority_group_ids.size();
-    attr.value.objlist.list = port.m_priority_group_ids.data();
-
-    status = sai_port_api->get_port_attribute(port.m_port_id, 1, &attr);
+    status = sai_port_api->get_port_attribute(port.m_port_id, (uint32_t)lists.size(), lists.data());
     if (status != SAI_STATUS_SUCCESS)
     {
-        SWSS_LOG_ERROR("Fail to get priority group list for port %s rv:%d", port.m_alias.c_str(), status);
+        SWSS_LOG_ERROR("Failed to get queue and priority group lists for port %s rv:%d", port.m_alias.c_str(), status);
         throw runtime_error("PortsOrch initialization failure.");
     }
-    SWSS_LOG_INFO("Get priority groups for port %s", port.m_alias.c_str());
+
+    SWSS_LOG_INFO("Get queues and priority groups for port %s", port.m_alias.c_str());
 }
 
 bool PortsOrch::initializePort(Port &port)
@@ -2390,8 +2418,7 @@ bool PortsOrch::initializePort(Port &port)
 
     SWSS_LOG_NOTICE("Initializing port alias:%s pid:%lx", port.m_alias.c_str(), port.m_port_id);
 
-    initializePriorityGroups(port);
-    initializeQueues(port);
+    initializePortAttributes(port);
 
     /* Create host interface */
     if (!addHostIntfs(port, port.m_alias, port.m_hif_id))
@@ -2435,20 +2462,6 @@ bool PortsOrch::initializePort(Port &port)
         port.m_oper_status = SAI_PORT_OPER_STATUS_DOWN;
     }
 
-    /* initialize port admin status */
-    if (!getPortAdminStatus(port.m_port_id, port.m_admin_state_up))
-    {
-        SWSS_LOG_ERROR("Failed to get initial port admin status %s", port.m_alias.c_str());
-        return false;
-    }
-
-    /* initialize port admin speed */
-    if (!getPortSpeed(port.m_port_id, port.m_speed))
-    {
-        SWSS_LOG_ERROR("Failed to get initial port admin speed %d", port.m_speed);
-        return false;
-    }
-
     /*
      * always initialize Port SAI_HOSTIF_ATTR_OPER_STATUS based on oper_status value in appDB.
      */
@@ -2986,6 +2999,8 @@ void PortsOrch::generateQueueMap()
         }
     }
 
+    flushCounterTables();
+
     m_isQueueMapGenerated = true;
 }
 
@@ -2998,6 +3013,9 @@ void PortsOrch::generateQueueMapPerPort(const Port& port)
     vector<FieldValueTuple> queueIndexVector;
     vector<FieldValueTuple> queueTypeVector;
 
+    static const string queueCounterIds = serializeCounterIds(queueStatIds, sai_serialize_queue_stat);
+    static const string queueWatermarkCounterIds = serializeCounterIds(queueWatermarkStatIds, sai_serialize_queue_stat);
+
     for (size_t queueIndex = 0; queueIndex < port.m_queue_ids.size(); ++queueIndex)
     {
         std::ostringstream name;
@@ -3017,36 +3035,10 @@ void PortsOrch::generateQueueMapPerPort(const Port& port)
         }
 
         /* add ordinary Queue stat counters */
-        string key = getQueueFlexCounterTableKey(id);
-
-        std::string delimiter = "";
-        std::ostringstream counters_stream;
-        for (const auto& it: queueStatIds)
-        {
-            counters_stream << delimiter << sai_serialize_queue_stat(it);
-            delimiter = comma;
-        }
-
-        vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(QUEUE_COUNTER_ID_LIST, counters_stream.str());
-
-        m_flexCounterTable->set(key, fieldValues);
+        m_flexCounters->add(QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP, id, QUEUE_COUNTER_ID_LIST, queueCounterIds);
 
         /* add watermark queue counters */
-        key = getQueueWatermarkFlexCounterTableKey(id);
-
-        delimiter = "";
-        counters_stream.str("");
-        for (const auto& it: queueWatermarkStatIds)
-        {
-            counters_stream << delimiter << sai_serialize_queue_stat(it);
-            delimiter = comma;
-        }
-
-        fieldValues.clear();
-        fieldValues.emplace_back(QUEUE_COUNTER_ID_LIST, counters_stream.str());
-
-        m_flexCounterTable->set(key, fieldValues);
+        m_flexCounters->add(QUEUE_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP, id, QUEUE_COUNTER_ID_LIST, queueWatermarkCounterIds);
     }
 
     m_queueTable->set("", queueVector);
@@ -3072,6 +3064,8 @@ void PortsOrch::generatePriorityGroupMap()
         }
     }
 
+    flushCounterTables();
+
     m_isPriorityGroupMapGenerated = true;
 }
 
@@ -3083,6 +3077,9 @@ void PortsOrch::generatePriorityGroupMapPerPort(const Port& port)
     vector<FieldValueTuple> pgPortVector;
     vector<FieldValueTuple> pgIndexVector;
 
+    static const string pgWatermarkCounterIds =
+        serializeCounterIds(ingressPriorityGroupWatermarkStatIds, sai_serialize_ingress_priority_group_stat);
+
     for (size_t pgIndex = 0; pgIndex < port.m_priority_group_ids.size(); ++pgIndex)
     {
         std::ostringstream name;
@@ -3094,21 +3091,8 @@ void PortsOrch::generatePriorityGroupMapPerPort(const Port& port)
         pgPortVector.emplace_back(id, sai_serialize_object_id(port.m_port_id));
         pgIndexVector.emplace_back(id, to_string(pgIndex));
 
-        string key = getPriorityGroupWatermarkFlexCounterTableKey(id);
-
-        std::string delimiter = "";
-        std::ostringstream counters_stream;
         /* Add watermark counters to flex_counter */
-        for (const auto& it: ingressPriorityGroupWatermarkStatIds)
-        {
-            counters_stream << delimiter << sai_serialize_ingress_priority_group_stat(it);
-            delimiter = comma;
-        }
-
-        vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(PG_COUNTER_ID_LIST, counters_stream.str());
-
-        m_flexCounterTable->set(key, fieldValues);
+        m_flexCounters->add(PG_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP, id, PG_COUNTER_ID_LIST, pgWatermarkCounterIds);
     }
 
     m_pgTable->set("", pgVector);
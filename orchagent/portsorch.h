@@ -9,6 +9,7 @@
 #include "observer.h"
 #include "macaddress.h"
 #include "producertable.h"
+#include "flexcounterbatch.h"
 
 #define FCS_LEN 4
 #define VLAN_TAG_LEN 4
@@ -85,6 +86,10 @@ public:
     void refreshPortStatus();
     bool removeAclTableGroup(const Port &p);
 private:
+    /* COUNTERS_DB and FLEX_COUNTER_DB writes are buffered until flushCounterTables() */
+    unique_ptr<RedisPipeline> m_counterPipeline;
+    unique_ptr<FlexCounterBatch> m_flexCounters;
+
     unique_ptr<Table> m_counterTable;
     unique_ptr<Table> m_portTable;
     unique_ptr<Table> m_queueTable;
@@ -94,14 +99,8 @@ private:
     unique_ptr<Table> m_pgTable;
     unique_ptr<Table> m_pgPortTable;
     unique_ptr<Table> m_pgIndexTable;
-    unique_ptr<ProducerTable> m_flexCounterTable;
     unique_ptr<ProducerTable> m_flexCounterGroupTable;
 
-    std::string getQueueFlexCounterTableKey(std::string s);
-    std::string getQueueWatermarkFlexCounterTableKey(std::string s);
-    std::string getPortFlexCounterTableKey(std::string s);
-    std::string getPriorityGroupWatermarkFlexCounterTableKey(std::string s);
-
     shared_ptr<DBConnector> m_counter_db;
     shared_ptr<DBConnector> m_flex_db;
 
@@ -132,12 +131,13 @@ private:
 
     void doTask(NotificationConsumer &consumer);
 
+    void flushCounterTables();
+
     void removeDefaultVlanMembers();
     void removeDefaultBridgePorts();
 
     bool initializePort(Port &port);
-    void initializePriorityGroups(Port &port);
-    void initializeQueues(Port &port);
+    void initializePortAttributes(Port &port);
 
     bool addHostIntfs(Port &port, string alias, sai_object_id_t &host_intfs_id);
     bool setHostIntfsStripTag(Port &port, sai_hostif_vlan_tag_t strip);
@@ -156,9 +156,10 @@ private:
     bool removeLagMember(Port &lag, Port &port);
     void getLagMember(Port &lag, vector<Port> &portv);
 
-    bool addPort(const set<int> &lane_set, uint32_t speed, int an=0, string fec="");
+    bool addPorts(const map<set<int>, tuple<string, uint32_t, int, string>> &ports);
     bool removePort(sai_object_id_t port_id);
     bool initPort(const string &alias, const set<int> &lane_set);
+    void initPorts();
 
     bool setPortAdminStatus(sai_object_id_t id, bool up);
     bool getPortAdminStatus(sai_object_id_t id, bool& up);
@@ -101,7 +101,7 @@ task_process_status QosMapHandler::processWorkItem(Consumer& consumer)
                 freeAttribResources(attributes);
                 return task_process_status::task_failed;
             }
-            (*(QosOrch::getTypeMap()[qos_map_type_name]))[qos_object_name] = sai_object;
+            QosOrch::setReferencedObject(QosOrch::getTypeMap(), qos_map_type_name, qos_object_name, sai_object);
             SWSS_LOG_NOTICE("Created [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
         }
         freeAttribResources(attributes);
@@ -118,8 +118,7 @@ task_process_status QosMapHandler::processWorkItem(Consumer& consumer)
             SWSS_LOG_ERROR("Failed to remove dscp_to_tc map. db name:%s sai object:%lx", qos_object_name.c_str(), sai_object);
             return task_process_status::task_failed;
         }
-        auto it_to_delete = (QosOrch::getTypeMap()[qos_map_type_name])->find(qos_object_name);
-        (QosOrch::getTypeMap()[qos_map_type_name])->erase(it_to_delete);
+        QosOrch::removeReferencedObject(QosOrch::getTypeMap(), qos_map_type_name, qos_object_name);
     }
     else
     {
@@ -897,7 +896,7 @@ task_process_status QosOrch::handleSchedulerTable(Consumer& consumer)
                 return task_process_status::task_failed;
             }
             SWSS_LOG_NOTICE("Created [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
-            (*(m_qos_maps[qos_map_type_name]))[qos_object_name] = sai_object;
+            setReferencedObject(m_qos_maps, qos_map_type_name, qos_object_name, sai_object);
         }
     }
     else if (op == DEL_COMMAND)
@@ -913,8 +912,7 @@ task_process_status QosOrch::handleSchedulerTable(Consumer& consumer)
             SWSS_LOG_ERROR("Failed to remove scheduler profile. db name:%s sai object:%lx", qos_object_name.c_str(), sai_object);
             return task_process_status::task_failed;
         }
-        auto it_to_delete = (m_qos_maps[qos_map_type_name])->find(qos_object_name);
-        (m_qos_maps[qos_map_type_name])->erase(it_to_delete);
+        removeReferencedObject(m_qos_maps, qos_map_type_name, qos_object_name);
     }
     else
     {
@@ -1382,10 +1380,20 @@ void QosOrch::doTask(Consumer &consumer)
             continue;
         }
 
+        /* Updating an object re-applies the entries referencing it */
+        auto objects = m_qos_maps.find(qos_map_type_name);
+        bool update = kfvOp(it->second) == SET_COMMAND && objects != m_qos_maps.end() &&
+                      objects->second->find(kfvKey(it->second)) != objects->second->end();
+
         auto task_status = (this->*(m_qos_handler_map[qos_map_type_name]))(consumer);
         switch(task_status)
         {
             case task_process_status::task_success :
+                if (update)
+                {
+                    reapplyObjectDependents(object_reference(qos_map_type_name, kfvKey(it->second)));
+                }
+                updateObjectDependents(m_qos_maps, qos_map_type_name, it->second);
                 it = consumer.m_toSync.erase(it);
                 break;
             case task_process_status::task_invalid_entry :
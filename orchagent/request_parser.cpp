@@ -1,5 +1,6 @@
 #include <net/ethernet.h>
 #include <cassert>
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -13,6 +14,70 @@
 #include "request_parser.h"
 
 
+void Request::compileSchema()
+{
+    for (const auto& item: request_description_.attr_item_types)
+    {
+        AttrSlot slot;
+        slot.name = item.first;
+        slot.type = item.second;
+        slot.is_set = false;
+        slot.value.uint_value = 0;
+        attr_slots_.push_back(slot);
+    }
+
+    std::sort(attr_slots_.begin(), attr_slots_.end(),
+              [](const AttrSlot& a, const AttrSlot& b) { return a.name < b.name; });
+
+    for (const auto& attr: request_description_.mandatory_attr_items)
+    {
+        mandatory_attr_slots_.push_back(findAttrSlot(attr));
+    }
+
+    parsed_attr_slots_.reserve(attr_slots_.size());
+
+    key_items_.resize(number_of_key_items_);
+    key_item_strings_.resize(number_of_key_items_);
+    key_item_mac_addresses_.resize(number_of_key_items_);
+    key_item_ip_addresses_.resize(number_of_key_items_);
+    key_item_ip_prefix_.resize(number_of_key_items_);
+    key_item_uint_.resize(number_of_key_items_);
+}
+
+size_t Request::findAttrSlot(const std::string& attr_name) const
+{
+    const auto slot = std::lower_bound(attr_slots_.begin(), attr_slots_.end(), attr_name,
+                                       [](const AttrSlot& a, const std::string& name) { return a.name < name; });
+
+    if (slot == attr_slots_.end() || slot->name != attr_name)
+    {
+        return std::string::npos;
+    }
+
+    return static_cast<size_t>(slot - attr_slots_.begin());
+}
+
+const Request::AttrSlot& Request::getAttrSlot(const std::string& attr_name, request_types_t type) const
+{
+    const size_t slot = findAttrSlot(attr_name);
+
+    if (slot == std::string::npos || !attr_slots_[slot].is_set || attr_slots_[slot].type != type)
+    {
+        throw std::out_of_range(std::string("Attribute is not set: ") + attr_name);
+    }
+
+    return attr_slots_[slot];
+}
+
+void Request::checkKeyItemType(int position, request_types_t type) const
+{
+    if (position < 0 || position >= static_cast<int>(number_of_key_items_)
+        || request_description_.key_item_types[position] != type)
+    {
+        throw std::out_of_range(std::string("Wrong key item position: ") + std::to_string(position));
+    }
+}
+
 void Request::parse(const KeyOpFieldsValuesTuple& request)
 {
     if (is_parsed_)
@@ -31,13 +96,14 @@ void Request::clear()
 {
     operation_.clear();
     full_key_.clear();
+
+    for (auto slot: parsed_attr_slots_)
+    {
+        attr_slots_[slot].is_set = false;
+    }
+    parsed_attr_slots_.clear();
     attr_names_.clear();
-    key_item_strings_.clear();
-    key_item_mac_addresses_.clear();
-    attr_item_strings_.clear();
-    attr_item_bools_.clear();
-    attr_item_mac_addresses_.clear();
-    attr_item_packet_actions_.clear();
+    attr_names_valid_ = false;
 
     is_parsed_ = false;
 }
@@ -56,18 +122,29 @@ void Request::parseKey(const KeyOpFieldsValuesTuple& request)
     full_key_ = kfvKey(request);
 
     // split the key by separator
-    std::vector<std::string> key_items;
+    size_t number_of_key_items = 0;
     size_t f_position = 0;
     size_t e_position = full_key_.find(key_separator_);
-    while (e_position != std::string::npos)
+    while (true)
     {
-        key_items.push_back(full_key_.substr(f_position, e_position - f_position));
+        size_t length = (e_position == std::string::npos) ? std::string::npos : e_position - f_position;
+
+        if (number_of_key_items < number_of_key_items_)
+        {
+            key_items_[number_of_key_items].assign(full_key_, f_position, length);
+        }
+        number_of_key_items++;
+
+        if (e_position == std::string::npos)
+        {
+            break;
+        }
+
         f_position = e_position + 1;
         e_position = full_key_.find(key_separator_, f_position);
     }
-    key_items.push_back(full_key_.substr(f_position, full_key_.length()));
 
-    if (key_items.size() != number_of_key_items_)
+    if (number_of_key_items != number_of_key_items_)
     {
         throw std::invalid_argument(std::string("Wrong number of key items. Expected ")
                                   + std::to_string(number_of_key_items_)
@@ -82,33 +159,31 @@ void Request::parseKey(const KeyOpFieldsValuesTuple& request)
         switch(request_description_.key_item_types[i])
         {
             case REQ_T_STRING:
-                key_item_strings_[i] = key_items[i];
+                key_item_strings_[i] = key_items_[i];
                 break;
             case REQ_T_MAC_ADDRESS:
-                key_item_mac_addresses_[i] = parseMacAddress(key_items[i]);
+                key_item_mac_addresses_[i] = parseMacAddress(key_items_[i]);
                 break;
             case REQ_T_IP:
-                key_item_ip_addresses_[i] = parseIpAddress(key_items[i]);
+                key_item_ip_addresses_[i] = parseIpAddress(key_items_[i]);
                 break;
             case REQ_T_IP_PREFIX:
-                key_item_ip_prefix_[i] = parseIpPrefix(key_items[i]);
+                key_item_ip_prefix_[i] = parseIpPrefix(key_items_[i]);
                 break;
             case REQ_T_UINT:
-                key_item_uint_[i] = parseUint(key_items[i]);
+                key_item_uint_[i] = parseUint(key_items_[i]);
                 break;
             default:
                 throw std::logic_error(std::string("Not implemented key type parser. Key '")
                                      + full_key_
                                      + std::string("'. Key item:")
-                                     + key_items[i]);
+                                     + key_items_[i]);
         }
     }
 }
 
 void Request::parseAttrs(const KeyOpFieldsValuesTuple& request)
 {
-    const auto not_found = std::end(request_description_.attr_item_types);
-
     for (auto i = kfvFieldsValues(request).begin();
          i != kfvFieldsValues(request).end(); i++)
     {
@@ -118,55 +193,63 @@ void Request::parseAttrs(const KeyOpFieldsValuesTuple& request)
             // it's used when we don't have any attributes, but we have to provide one for redis
             continue;
         }
-        const auto item = request_description_.attr_item_types.find(fvField(*i));
-        if (item == not_found)
+        const size_t slot = findAttrSlot(fvField(*i));
+        if (slot == std::string::npos)
         {
             throw std::invalid_argument(std::string("Unknown attribute name: ") + fvField(*i));
         }
-        attr_names_.insert(fvField(*i));
-        switch(item->second)
+        auto& item = attr_slots_[slot];
+        switch(item.type)
         {
             case REQ_T_STRING:
-                attr_item_strings_[fvField(*i)] = fvValue(*i);
+                item.str_value = fvValue(*i);
                 break;
             case REQ_T_BOOL:
-                attr_item_bools_[fvField(*i)] = parseBool(fvValue(*i));
+                item.value.bool_value = parseBool(fvValue(*i));
                 break;
             case REQ_T_MAC_ADDRESS:
-                attr_item_mac_addresses_[fvField(*i)] = parseMacAddress(fvValue(*i));
+                item.mac_value = parseMacAddress(fvValue(*i));
                 break;
             case REQ_T_PACKET_ACTION:
-                attr_item_packet_actions_[fvField(*i)] = parsePacketAction(fvValue(*i));
+                item.value.packet_action_value = parsePacketAction(fvValue(*i));
                 break;
             case REQ_T_VLAN:
-                attr_item_vlan_[fvField(*i)] = parseVlan(fvValue(*i));
+                item.value.vlan_value = parseVlan(fvValue(*i));
                 break;
             case REQ_T_IP:
-                attr_item_ip_[fvField(*i)] = parseIpAddress(fvValue(*i));
+                item.ip_value = parseIpAddress(fvValue(*i));
                 break;
             case REQ_T_UINT:
-                attr_item_uint_[fvField(*i)] = parseUint(fvValue(*i));
+                item.value.uint_value = parseUint(fvValue(*i));
                 break;
             case REQ_T_SET:
-                attr_item_set_[fvField(*i)] = parseSet(fvValue(*i));
+                item.set_value = parseSet(fvValue(*i));
                 break;
             default:
                 throw std::logic_error(std::string("Not implemented attribute type parser for attribute:") + fvField(*i));
         }
+        if (!item.is_set)
+        {
+            item.is_set = true;
+            parsed_attr_slots_.push_back(slot);
+        }
     }
 
-    if (operation_ == DEL_COMMAND && attr_names_.size() > 0)
+    if (operation_ == DEL_COMMAND && parsed_attr_slots_.size() > 0)
     {
         throw std::invalid_argument("Delete operation request contains attributes");
     }
 
     if (operation_ == SET_COMMAND)
     {
-        for (const auto& attr: request_description_.mandatory_attr_items)
+        for (size_t i = 0; i < mandatory_attr_slots_.size(); i++)
         {
-            if (attr_names_.find(attr) == std::end(attr_names_))
+            const size_t slot = mandatory_attr_slots_[i];
+            if (slot == std::string::npos || !attr_slots_[slot].is_set)
             {
-                throw std::invalid_argument(std::string("Mandatory attribute '") + attr + std::string("' not found"));
+                throw std::invalid_argument(std::string("Mandatory attribute '")
+                                          + request_description_.mandatory_attr_items[i]
+                                          + std::string("' not found"));
             }
         }
     }
@@ -296,7 +379,7 @@ uint16_t Request::parseVlan(const std::string& str)
 
 sai_packet_action_t Request::parsePacketAction(const std::string& str)
 {
-    std::unordered_map<std::string, sai_packet_action_t> m = {
+    static const std::unordered_map<std::string, sai_packet_action_t> m = {
         {"drop", SAI_PACKET_ACTION_DROP},
         {"forward", SAI_PACKET_ACTION_FORWARD},
         {"copy", SAI_PACKET_ACTION_COPY},
@@ -30,6 +30,48 @@ typedef struct _request_description
 class Request
 {
 public:
+    /* Name and type of an attribute set by the request */
+    struct AttrField
+    {
+        std::string name;
+        request_types_t type;
+    };
+
+    /*
+     * Attributes set by the request, in the order they were parsed. Walks
+     * the parsed slots in place, without hashing nor copying their names.
+     */
+    class AttrFields
+    {
+    public:
+        class const_iterator
+        {
+        public:
+            const_iterator(const Request& request, std::vector<size_t>::const_iterator slot)
+                : request_(request), slot_(slot)
+            {
+            }
+
+            const AttrField& operator*() const { return request_.attr_slots_[*slot_]; }
+            const AttrField* operator->() const { return &**this; }
+            const_iterator& operator++() { ++slot_; return *this; }
+            bool operator!=(const const_iterator& other) const { return slot_ != other.slot_; }
+
+        private:
+            const Request& request_;
+            std::vector<size_t>::const_iterator slot_;
+        };
+
+        AttrFields(const Request& request) : request_(request) { }
+
+        const_iterator begin() const { return const_iterator(request_, request_.parsed_attr_slots_.begin()); }
+        const_iterator end() const { return const_iterator(request_, request_.parsed_attr_slots_.end()); }
+        size_t size() const { return request_.parsed_attr_slots_.size(); }
+
+    private:
+        const Request& request_;
+    };
+
     void parse(const KeyOpFieldsValuesTuple& request);
     void clear();
 
@@ -48,85 +90,112 @@ public:
     const std::string& getKeyString(int position) const
     {
         assert(is_parsed_);
-        return key_item_strings_.at(position);
+        checkKeyItemType(position, REQ_T_STRING);
+        return key_item_strings_[position];
     }
 
     const MacAddress& getKeyMacAddress(int position) const
     {
         assert(is_parsed_);
-        return key_item_mac_addresses_.at(position);
+        checkKeyItemType(position, REQ_T_MAC_ADDRESS);
+        return key_item_mac_addresses_[position];
     }
 
     const IpAddress& getKeyIpAddress(int position) const
     {
         assert(is_parsed_);
-        return key_item_ip_addresses_.at(position);
+        checkKeyItemType(position, REQ_T_IP);
+        return key_item_ip_addresses_[position];
     }
 
     const IpPrefix& getKeyIpPrefix(int position) const
     {
         assert(is_parsed_);
-        return key_item_ip_prefix_.at(position);
+        checkKeyItemType(position, REQ_T_IP_PREFIX);
+        return key_item_ip_prefix_[position];
     }
 
     const uint64_t& getKeyUint(int position) const
     {
         assert(is_parsed_);
-        return key_item_uint_.at(position);
+        checkKeyItemType(position, REQ_T_UINT);
+        return key_item_uint_[position];
     }
 
+    AttrFields getAttrFields() const
+    {
+        assert(is_parsed_);
+        return AttrFields(*this);
+    }
+
+    bool hasAttr(const std::string& attr_name) const
+    {
+        assert(is_parsed_);
+        const size_t slot = findAttrSlot(attr_name);
+        return slot != std::string::npos && attr_slots_[slot].is_set;
+    }
+
+    /* Names of getAttrFields() as a set, built per request: for tests */
     const std::unordered_set<std::string>& getAttrFieldNames() const
     {
         assert(is_parsed_);
+        if (!attr_names_valid_)
+        {
+            for (const auto& field: getAttrFields())
+            {
+                attr_names_.insert(field.name);
+            }
+            attr_names_valid_ = true;
+        }
         return attr_names_;
     }
 
     const std::string& getAttrString(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_strings_.at(attr_name);
+        return getAttrSlot(attr_name, REQ_T_STRING).str_value;
     }
 
     bool getAttrBool(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_bools_.at(attr_name);
+        return getAttrSlot(attr_name, REQ_T_BOOL).value.bool_value;
     }
 
     const MacAddress& getAttrMacAddress(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_mac_addresses_.at(attr_name);
+        return getAttrSlot(attr_name, REQ_T_MAC_ADDRESS).mac_value;
     }
 
     sai_packet_action_t getAttrPacketAction(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_packet_actions_.at(attr_name);
+        return getAttrSlot(attr_name, REQ_T_PACKET_ACTION).value.packet_action_value;
     }
 
     uint16_t getAttrVlan(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_vlan_.at(attr_name);
+        return getAttrSlot(attr_name, REQ_T_VLAN).value.vlan_value;
     }
 
     IpAddress getAttrIP(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_ip_.at(attr_name);
+        return getAttrSlot(attr_name, REQ_T_IP).ip_value;
     }
 
     const uint64_t& getAttrUint(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_uint_.at(attr_name);
+        return getAttrSlot(attr_name, REQ_T_UINT).value.uint_value;
     }
 
     const set<string>& getAttrSet(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_set_.at(attr_name);
+        return getAttrSlot(attr_name, REQ_T_SET).set_value;
     }
 
     void setTableName(std::string& table_name)
@@ -145,12 +214,39 @@ protected:
         : request_description_(request_description),
           key_separator_(key_separator),
           is_parsed_(false),
-          number_of_key_items_(request_description.key_item_types.size())
+          number_of_key_items_(request_description.key_item_types.size()),
+          attr_names_valid_(false)
     {
+        compileSchema();
     }
 
 
 private:
+    /*
+     * Parsed value of one attribute of the request description. Slots are
+     * allocated once from the description and reused by every request.
+     */
+    struct AttrSlot : AttrField
+    {
+        bool is_set;
+        union
+        {
+            bool bool_value;
+            sai_packet_action_t packet_action_value;
+            uint16_t vlan_value;
+            uint64_t uint_value;
+        } value;
+        std::string str_value;
+        MacAddress mac_value;
+        IpAddress ip_value;
+        set<string> set_value;
+    };
+
+    void compileSchema();
+    size_t findAttrSlot(const std::string& attr_name) const;
+    const AttrSlot& getAttrSlot(const std::string& attr_name, request_types_t type) const;
+    void checkKeyItemType(int position, request_types_t type) const;
+
     void parseOperation(const KeyOpFieldsValuesTuple& request);
     void parseKey(const KeyOpFieldsValuesTuple& request);
     void parseAttrs(const KeyOpFieldsValuesTuple& request);
@@ -172,21 +268,22 @@ private:
     std::string table_name_;
     std::string operation_;
     std::string full_key_;
-    std::unordered_map<int, std::string> key_item_strings_;
-    std::unordered_map<int, MacAddress> key_item_mac_addresses_;
-    std::unordered_map<int, IpAddress> key_item_ip_addresses_;
-    std::unordered_map<int, IpPrefix> key_item_ip_prefix_;
-    std::unordered_map<int, uint64_t> key_item_uint_;
-    std::unordered_set<std::string> attr_names_;
-    // FIXME: Make one union with all the values, except string
-    std::unordered_map<std::string, std::string> attr_item_strings_;
-    std::unordered_map<std::string, bool> attr_item_bools_;
-    std::unordered_map<std::string, MacAddress> attr_item_mac_addresses_;
-    std::unordered_map<std::string, sai_packet_action_t> attr_item_packet_actions_;
-    std::unordered_map<std::string, uint16_t> attr_item_vlan_;
-    std::unordered_map<std::string, IpAddress> attr_item_ip_;
-    std::unordered_map<std::string, uint64_t> attr_item_uint_;
-    std::unordered_map<std::string, set<string>> attr_item_set_;
+    std::vector<std::string> key_items_;
+    std::vector<std::string> key_item_strings_;
+    std::vector<MacAddress> key_item_mac_addresses_;
+    std::vector<IpAddress> key_item_ip_addresses_;
+    std::vector<IpPrefix> key_item_ip_prefix_;
+    std::vector<uint64_t> key_item_uint_;
+
+    // Attribute slots sorted by name, looked up with a binary search
+    std::vector<AttrSlot> attr_slots_;
+    // Slots of the mandatory attributes, npos for ones missing from the description
+    std::vector<size_t> mandatory_attr_slots_;
+    // Slots set by the current request, in the order they were parsed
+    std::vector<size_t> parsed_attr_slots_;
+    // Built on demand from parsed_attr_slots_
+    mutable std::unordered_set<std::string> attr_names_;
+    mutable bool attr_names_valid_;
 };
 
 #endif // __REQUEST_PARSER_H
@@ -3,6 +3,8 @@
 #include "logger.h"
 #include "swssnet.h"
 #include "crmorch.h"
+#include "timer.h"
+#include "saibulk.h"
 
 extern sai_object_id_t gVirtualRouterId;
 extern sai_object_id_t gSwitchId;
@@ -19,16 +21,28 @@ extern CrmOrch *gCrmOrch;
 #define DEFAULT_NUMBER_OF_ECMP_GROUPS   128
 #define DEFAULT_MAX_ECMP_GROUP_SIZE     32
 
+/* Maximum number of stale routes removed per resync sweep batch */
+#define RESYNC_SWEEP_BATCH_SIZE         1024
+/* Interval between two resync sweep batches */
+#define RESYNC_SWEEP_INTERVAL_MSECS     10
+
 const int routeorch_pri = 5;
 
 RouteOrch::RouteOrch(DBConnector *db, string tableName, NeighOrch *neighOrch) :
         Orch(db, tableName, routeorch_pri),
         m_neighOrch(neighOrch),
         m_nextHopGroupCount(0),
-        m_resync(false)
+        m_resync(false),
+        m_routeGeneration(0),
+        m_resyncSweep(false)
 {
     SWSS_LOG_ENTER();
 
+    auto interv = timespec { .tv_sec = 0, .tv_nsec = RESYNC_SWEEP_INTERVAL_MSECS * 1000000 };
+    m_resyncSweepTimer = new SelectableTimer(interv);
+    auto executor = new ExecutableTimer(m_resyncSweepTimer, this, "ROUTE_RESYNC_SWEEP");
+    Orch::addExecutor(executor);
+
     sai_attribute_t attr;
     attr.id = SAI_SWITCH_ATTR_NUMBER_OF_ECMP_GROUPS;
 
@@ -81,7 +95,7 @@ RouteOrch::RouteOrch(DBConnector *db, string tableName, NeighOrch *neighOrch) :
     gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
 
     /* Add default IPv4 route into the m_syncdRoutes */
-    m_syncdRoutes[default_ip_prefix] = IpAddresses();
+    m_syncdRoutes[default_ip_prefix] = { EMPTY_NEXTHOP_SET, m_routeGeneration };
 
     SWSS_LOG_NOTICE("Create IPv4 default route with packet action drop");
 
@@ -100,7 +114,7 @@ RouteOrch::RouteOrch(DBConnector *db, string tableName, NeighOrch *neighOrch) :
     gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
 
     /* Add default IPv6 route into the m_syncdRoutes */
-    m_syncdRoutes[v6_default_ip_prefix] = IpAddresses();
+    m_syncdRoutes[v6_default_ip_prefix] = { EMPTY_NEXTHOP_SET, m_routeGeneration };
 
     SWSS_LOG_NOTICE("Create IPv6 default route with packet action drop");
 }
@@ -130,13 +144,13 @@ void RouteOrch::attach(Observer *observer, const IpAddress& dstAddr)
         observerEntry = m_nextHopObservers.find(dstAddr);
 
         /* Find the prefixes that cover the destination IP */
-        for (auto route : m_syncdRoutes)
+        for (const auto &route : m_syncdRoutes)
         {
             if (route.first.isAddressInSubnet(dstAddr))
             {
                 SWSS_LOG_NOTICE("route%s", route.first.to_string().c_str());
                 observerEntry->second.routeTable.emplace(
-                        route.first, route.second);
+                        route.first, m_nextHopSets.get(route.second.nexthops));
             }
         }
 
@@ -192,77 +206,153 @@ bool RouteOrch::validnexthopinNextHopGroup(const IpAddress &ipaddr)
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t nexthop_id;
-    sai_status_t status;
+    auto groups = m_nextHopGroupIndex.find(ipaddr);
+    if (groups == m_nextHopGroupIndex.end())
+    {
+        return true;
+    }
+
+    NextHopGroupMemberOps members;
 
-    for (auto nhopgroup = m_syncdNextHopGroups.begin();
-         nhopgroup != m_syncdNextHopGroups.end(); ++nhopgroup)
+    for (auto nhopgroup : groups->second)
     {
+        members.push_back({ &nhopgroup->second, ipaddr });
+    }
+
+    return addNextHopGroupMembers(members);
+}
 
-        if (!(nhopgroup->first.contains(ipaddr)))
+bool RouteOrch::invalidnexthopinNextHopGroup(const IpAddress &ipaddr)
+{
+    size_t members;
+
+    return invalidnexthopsinNextHopGroups({ ipaddr }, members);
+}
+
+/*
+ * Remove the members of all the next hop groups using any of 'ipaddrs' in a
+ * single bulk call. The groups to visit come from m_nextHopGroupIndex rather
+ * than from a walk over all next hop groups. 'members' is set to the number
+ * of members removed.
+ */
+bool RouteOrch::invalidnexthopsinNextHopGroups(const vector<IpAddress> &ipaddrs, size_t &members)
+{
+    SWSS_LOG_ENTER();
+
+    vector<sai_object_id_t> member_ids;
+    vector<sai_object_id_t> group_ids;
+
+    for (const auto &ipaddr : ipaddrs)
+    {
+        auto groups = m_nextHopGroupIndex.find(ipaddr);
+        if (groups == m_nextHopGroupIndex.end())
         {
             continue;
         }
 
-        vector<sai_attribute_t> nhgm_attrs;
-        sai_attribute_t nhgm_attr;
+        for (auto nhopgroup : groups->second)
+        {
+            auto member = nhopgroup->second.nhopgroup_members.find(ipaddr);
+            if (member == nhopgroup->second.nhopgroup_members.end())
+            {
+                continue;
+            }
 
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
-        nhgm_attr.value.oid = nhopgroup->second.next_hop_group_id;
-        nhgm_attrs.push_back(nhgm_attr);
+            member_ids.push_back(member->second);
+            group_ids.push_back(nhopgroup->second.next_hop_group_id);
+        }
+    }
 
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-        nhgm_attr.value.oid = m_neighOrch->getNextHopId(ipaddr);
-        nhgm_attrs.push_back(nhgm_attr);
+    vector<sai_status_t> statuses;
+    bulkRemoveObjects(sai_next_hop_group_api->remove_next_hop_group_members,
+                      sai_next_hop_group_api->remove_next_hop_group_member,
+                      member_ids, statuses);
 
-        status = sai_next_hop_group_api->create_next_hop_group_member(&nexthop_id, gSwitchId,
-                                                                      (uint32_t)nhgm_attrs.size(),
-                                                                      nhgm_attrs.data());
+    bool rc = true;
+    members = 0;
 
-        if (status != SAI_STATUS_SUCCESS)
+    for (size_t i = 0; i < member_ids.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
         {
-            SWSS_LOG_ERROR("Failed to add next hop member to group %lx: %d\n",
-                           nhopgroup->second.next_hop_group_id, status);
-            return false;
+            SWSS_LOG_ERROR("Failed to remove next hop member %lx from group %lx: %d\n",
+                           member_ids[i], group_ids[i], statuses[i]);
+            rc = false;
+            continue;
         }
 
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
-        nhopgroup->second.nhopgroup_members[ipaddr] = nexthop_id;
+        members++;
     }
 
-    return true;
+    if (members)
+    {
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER, (uint32_t)members);
+    }
+
+    return rc;
 }
 
-bool RouteOrch::invalidnexthopinNextHopGroup(const IpAddress &ipaddr)
+void RouteOrch::indexNextHopGroup(NextHopGroupTable::value_type &nhopgroup, bool add)
 {
-    SWSS_LOG_ENTER();
-
-    sai_object_id_t nexthop_id;
-    sai_status_t status;
-
-    for (auto nhopgroup = m_syncdNextHopGroups.begin();
-         nhopgroup != m_syncdNextHopGroups.end(); ++nhopgroup)
+    for (const auto &ip : nhopgroup.first.getIpAddresses())
     {
-
-        if (!(nhopgroup->first.contains(ipaddr)))
+        if (add)
         {
+            m_nextHopGroupIndex[ip].insert(&nhopgroup);
             continue;
         }
 
-        nexthop_id = nhopgroup->second.nhopgroup_members[ipaddr];
-        status = sai_next_hop_group_api->remove_next_hop_group_member(nexthop_id);
-
-        if (status != SAI_STATUS_SUCCESS)
+        auto groups = m_nextHopGroupIndex.find(ip);
+        if (groups == m_nextHopGroupIndex.end())
         {
-            SWSS_LOG_ERROR("Failed to remove next hop member %lx from group %lx: %d\n",
-                           nexthop_id, nhopgroup->second.next_hop_group_id, status);
-            return false;
+            continue;
         }
 
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+        groups->second.erase(&nhopgroup);
+        if (groups->second.empty())
+        {
+            m_nextHopGroupIndex.erase(groups);
+        }
     }
+}
 
-    return true;
+RouteRingConsumer::RouteRingConsumer(RouteRingReader *ring, Orch *orch, Consumer *consumer) :
+        Executor(ring, orch, "ROUTE_RING"),
+        m_ring(ring),
+        m_consumer(consumer)
+{
+}
+
+void RouteRingConsumer::execute()
+{
+    SWSS_LOG_ENTER();
+
+    /* The ring follows the pop batch of the table consumer */
+    std::deque<KeyOpFieldsValuesTuple> entries;
+    m_executed = m_ring->pops(entries, min(m_consumer->getBatch().size(), m_budget));
+    m_budget = SIZE_MAX;
+
+    /* Merged with the updates coming from APP_DB, then processed alike */
+    m_consumer->addToSync(entries);
+    m_consumer->drain();
+}
+
+void RouteOrch::enableRouteRing()
+{
+    SWSS_LOG_ENTER();
+
+    auto consumer = dynamic_cast<Consumer *>(getExecutor(APP_ROUTE_TABLE_NAME));
+    assert(consumer);
+
+    try
+    {
+        addExecutor(new RouteRingConsumer(new RouteRingReader(ROUTE_RING_PATH, RouteRing::DEFAULT_SIZE, routeorch_pri),
+                                          this, consumer));
+    }
+    catch (const exception &e)
+    {
+        SWSS_LOG_ERROR("Failed to create route ring, routes only come through APP_DB: %s", e.what());
+    }
 }
 
 void RouteOrch::doTask(Consumer& consumer)
@@ -284,46 +374,48 @@ void RouteOrch::doTask(Consumer& consumer)
 
         /* Get notification from application */
         /* resync application:
-         * When routeorch receives 'resync' message, it marks all current
-         * routes as dirty and waits for 'resync complete' message. For all
-         * newly received routes, if they match current dirty routes, it unmarks
-         * them dirty. After receiving 'resync complete' message, it creates all
-         * newly added routes and removes all dirty routes.
+         * When routeorch receives 'resync' message, it starts a new route
+         * generation, all current routes become dirty. Every route received
+         * from then on is stamped with the new generation, which unmarks it
+         * dirty. After receiving 'resync complete' message, the routes still
+         * carrying an older generation are removed in the background.
+         * Route updates keep being processed during the resync.
          */
         if (key == "resync")
         {
             if (op == "SET")
             {
-                /* Mark all current routes as dirty (DEL) in consumer.m_toSync map */
-                SWSS_LOG_NOTICE("Start resync routes\n");
-                for (auto i : m_syncdRoutes)
-                {
-                    vector<FieldValueTuple> v;
-                    auto x = KeyOpFieldsValuesTuple(i.first.to_string(), DEL_COMMAND, v);
-                    consumer.m_toSync[i.first.to_string()] = x;
-                }
+                m_routeGeneration++;
                 m_resync = true;
+
+                /* A sweep still running is superseded by the new resync */
+                m_resyncSweep = false;
+                m_resyncSweepTimer->stop();
+
+                SWSS_LOG_NOTICE("Start resync routes, generation %u\n", m_routeGeneration);
             }
-            else
+            else if (m_resync)
             {
-                SWSS_LOG_NOTICE("Complete resync routes\n");
+                SWSS_LOG_NOTICE("Complete resync routes, generation %u\n", m_routeGeneration);
                 m_resync = false;
+                startResyncSweep();
             }
 
             it = consumer.m_toSync.erase(it);
             continue;
         }
 
-        if (m_resync)
-        {
-            it++;
-            continue;
-        }
-
         IpPrefix ip_prefix = IpPrefix(key);
 
         if (op == SET_COMMAND)
         {
+            /* The application still owns the route, keep it out of the resync sweep */
+            auto it_route = m_syncdRoutes.find(ip_prefix);
+            if (it_route != m_syncdRoutes.end())
+            {
+                it_route->second.generation = m_routeGeneration;
+            }
+
             IpAddresses ip_addresses;
             string alias;
 
@@ -361,9 +453,11 @@ void RouteOrch::doTask(Consumer& consumer)
                 continue;
             }
 
-            if (m_syncdRoutes.find(ip_prefix) == m_syncdRoutes.end() || m_syncdRoutes[ip_prefix] != ip_addresses)
+            NextHopSetId nexthops = m_nextHopSets.intern(ip_addresses);
+
+            if (it_route == m_syncdRoutes.end() || it_route->second.nexthops != nexthops)
             {
-                if (addRoute(ip_prefix, ip_addresses))
+                if (addRoute(ip_prefix, nexthops))
                     it = consumer.m_toSync.erase(it);
                 else
                     it++;
@@ -371,6 +465,8 @@ void RouteOrch::doTask(Consumer& consumer)
             else
                 /* Duplicate entry */
                 it = consumer.m_toSync.erase(it);
+
+            m_nextHopSets.release(nexthops);
         }
         else if (op == DEL_COMMAND)
         {
@@ -483,8 +579,7 @@ void RouteOrch::increaseNextHopRefCount(IpAddresses ipAddresses)
     }
     else if (ipAddresses.getSize() == 1)
     {
-        IpAddress ip_address(ipAddresses.to_string());
-        m_neighOrch->increaseNextHopRefCount(ip_address);
+        m_neighOrch->increaseNextHopRefCount(*ipAddresses.getIpAddresses().begin());
     }
     else
     {
@@ -500,9 +595,7 @@ void RouteOrch::decreaseNextHopRefCount(IpAddresses ipAddresses)
     }
     else if (ipAddresses.getSize() == 1)
     {
-        IpAddress ip_address(ipAddresses.to_string());
-
-        m_neighOrch->decreaseNextHopRefCount(ip_address);
+        m_neighOrch->decreaseNextHopRefCount(*ipAddresses.getIpAddresses().begin());
     }
     else
     {
@@ -510,6 +603,48 @@ void RouteOrch::decreaseNextHopRefCount(IpAddresses ipAddresses)
     }
 }
 
+/* Take a route reference on the next hop (group) of an interned set */
+void RouteOrch::refNextHopSet(NextHopSetId nexthops)
+{
+    size_t size = m_nextHopSets.getSize(nexthops);
+
+    if (size == 1)
+    {
+        m_neighOrch->increaseNextHopRefCount(m_nextHopSets.getNextHop(nexthops));
+    }
+    else if (size > 1)
+    {
+        m_syncdNextHopGroups[m_nextHopSets.get(nexthops)].ref_count ++;
+    }
+
+    m_nextHopSets.retain(nexthops);
+}
+
+/*
+ * Drop a route reference taken by refNextHopSet(), removing the next hop
+ * group once no route uses it anymore.
+ */
+void RouteOrch::unrefNextHopSet(NextHopSetId nexthops)
+{
+    size_t size = m_nextHopSets.getSize(nexthops);
+
+    if (size == 1)
+    {
+        m_neighOrch->decreaseNextHopRefCount(m_nextHopSets.getNextHop(nexthops));
+    }
+    else if (size > 1)
+    {
+        const IpAddresses &ip_addresses = m_nextHopSets.get(nexthops);
+
+        if (--m_syncdNextHopGroups[ip_addresses].ref_count == 0)
+        {
+            removeNextHopGroup(ip_addresses);
+        }
+    }
+
+    m_nextHopSets.release(nexthops);
+}
+
 bool RouteOrch::isRefCounterZero(const IpAddresses& ipAddresses) const
 {
     if (!hasNextHopGroup(ipAddresses))
@@ -533,12 +668,9 @@ bool RouteOrch::addNextHopGroup(IpAddresses ipAddresses)
         return false;
     }
 
-    vector<sai_object_id_t> next_hop_ids;
     set<IpAddress> next_hop_set = ipAddresses.getIpAddresses();
-    std::map<sai_object_id_t, IpAddress> nhopgroup_members_set;
 
-    /* Assert each IP address exists in m_syncdNextHops table,
-     * and add the corresponding next_hop_id to next_hop_ids. */
+    /* Assert each IP address exists in m_syncdNextHops table */
     for (auto it : next_hop_set)
     {
         if (!m_neighOrch->hasNextHop(it))
@@ -547,10 +679,6 @@ bool RouteOrch::addNextHopGroup(IpAddresses ipAddresses)
                     it.to_string().c_str(), ipAddresses.to_string().c_str());
             return false;
         }
-
-        sai_object_id_t next_hop_id = m_neighOrch->getNextHopId(it);
-        next_hop_ids.push_back(next_hop_id);
-        nhopgroup_members_set[next_hop_id] = it;
     }
 
     sai_attribute_t nhg_attr;
@@ -581,44 +709,29 @@ bool RouteOrch::addNextHopGroup(IpAddresses ipAddresses)
     NextHopGroupEntry next_hop_group_entry;
     next_hop_group_entry.next_hop_group_id = next_hop_group_id;
 
-    for (auto nhid: next_hop_ids)
+    NextHopGroupMemberOps members;
+    for (const auto &ip : next_hop_set)
     {
-        // skip next hop group member create for neighbor from down port
-        if (m_neighOrch->isNextHopFlagSet(nhopgroup_members_set[nhid], NHFLAGS_IFDOWN)) {
-            continue;
-        }
-
-        // Create a next hop group member
-        vector<sai_attribute_t> nhgm_attrs;
-
-        sai_attribute_t nhgm_attr;
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
-        nhgm_attr.value.oid = next_hop_group_id;
-        nhgm_attrs.push_back(nhgm_attr);
-
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-        nhgm_attr.value.oid = nhid;
-        nhgm_attrs.push_back(nhgm_attr);
+        members.push_back({ &next_hop_group_entry, ip });
+    }
 
-        sai_object_id_t next_hop_group_member_id;
-        status = sai_next_hop_group_api->create_next_hop_group_member(&next_hop_group_member_id,
-                                                                      gSwitchId,
-                                                                      (uint32_t)nhgm_attrs.size(),
-                                                                      nhgm_attrs.data());
+    if (!addNextHopGroupMembers(members))
+    {
+        /* Undo the members created so far along with the group */
+        removeNextHopGroupMembers(members);
 
+        status = sai_next_hop_group_api->remove_next_hop_group(next_hop_group_id);
         if (status != SAI_STATUS_SUCCESS)
         {
-            // TODO: do we need to clean up?
-            SWSS_LOG_ERROR("Failed to create next hop group %lx member %lx: %d\n",
-                           next_hop_group_id, next_hop_group_member_id, status);
-            return false;
+            SWSS_LOG_ERROR("Failed to remove next hop group %lx, rv:%d", next_hop_group_id, status);
+        }
+        else
+        {
+            m_nextHopGroupCount --;
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
         }
 
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
-
-        // Save the membership into next hop structure
-        next_hop_group_entry.nhopgroup_members[nhopgroup_members_set.find(nhid)->second] =
-                                                                next_hop_group_member_id;
+        return false;
     }
 
     /* Increment the ref_count for the next hops used by the next hop group. */
@@ -631,6 +744,7 @@ bool RouteOrch::addNextHopGroup(IpAddresses ipAddresses)
      */
     next_hop_group_entry.ref_count = 0;
     m_syncdNextHopGroups[ipAddresses] = next_hop_group_entry;
+    indexNextHopGroup(*m_syncdNextHopGroups.find(ipAddresses), true);
 
 
     return true;
@@ -654,27 +768,15 @@ bool RouteOrch::removeNextHopGroup(IpAddresses ipAddresses)
     next_hop_group_id = next_hop_group_entry->second.next_hop_group_id;
     SWSS_LOG_NOTICE("Delete next hop group %s", ipAddresses.to_string().c_str());
 
-    for (auto nhop = next_hop_group_entry->second.nhopgroup_members.begin();
-         nhop != next_hop_group_entry->second.nhopgroup_members.end();)
+    NextHopGroupMemberOps members;
+    for (const auto &nhop : next_hop_group_entry->second.nhopgroup_members)
     {
+        members.push_back({ &next_hop_group_entry->second, nhop.first });
+    }
 
-        if (m_neighOrch->isNextHopFlagSet(nhop->first, NHFLAGS_IFDOWN))
-        {
-            SWSS_LOG_WARN("NHFLAGS_IFDOWN set for next hop group member %s with next_hop_id %lx",
-                           nhop->first.to_string().c_str(), nhop->second);
-            nhop = next_hop_group_entry->second.nhopgroup_members.erase(nhop);
-            continue;
-        }
-        status = sai_next_hop_group_api->remove_next_hop_group_member(nhop->second);
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to remove next hop group member %lx, rv:%d",
-                           nhop->second, status);
-            return false;
-        }
-
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
-        nhop = next_hop_group_entry->second.nhopgroup_members.erase(nhop);
+    if (!removeNextHopGroupMembers(members))
+    {
+        return false;
     }
 
     status = sai_next_hop_group_api->remove_next_hop_group(next_hop_group_id);
@@ -692,11 +794,234 @@ bool RouteOrch::removeNextHopGroup(IpAddresses ipAddresses)
     {
         m_neighOrch->decreaseNextHopRefCount(it);
     }
+    indexNextHopGroup(*next_hop_group_entry, false);
     m_syncdNextHopGroups.erase(ipAddresses);
 
     return true;
 }
 
+/*
+ * Turn the next hop group of 'current' into a group of 'nextHops' in place,
+ * only creating and removing the members that differ. New members are added
+ * before old ones are removed so that the group never goes empty. The caller
+ * must be the only user of the group.
+ */
+bool RouteOrch::updateNextHopGroup(IpAddresses current, IpAddresses nextHops)
+{
+    SWSS_LOG_ENTER();
+
+    assert(hasNextHopGroup(current));
+    assert(!hasNextHopGroup(nextHops));
+
+    set<IpAddress> current_set = current.getIpAddresses();
+    set<IpAddress> next_hop_set = nextHops.getIpAddresses();
+
+    vector<IpAddress> added;
+    vector<IpAddress> removed;
+
+    for (const auto &ip : next_hop_set)
+    {
+        if (!current_set.count(ip))
+        {
+            if (!m_neighOrch->hasNextHop(ip))
+            {
+                SWSS_LOG_INFO("Failed to get next hop %s in %s",
+                        ip.to_string().c_str(), nextHops.to_string().c_str());
+                return false;
+            }
+            added.push_back(ip);
+        }
+    }
+
+    for (const auto &ip : current_set)
+    {
+        if (!next_hop_set.count(ip))
+        {
+            removed.push_back(ip);
+        }
+    }
+
+    NextHopGroupEntry &entry = m_syncdNextHopGroups[current];
+
+    NextHopGroupMemberOps added_members;
+    for (const auto &ip : added)
+    {
+        added_members.push_back({ &entry, ip });
+    }
+
+    if (!addNextHopGroupMembers(added_members))
+    {
+        /* Roll back the members added, the group is left as it was */
+        removeNextHopGroupMembers(added_members);
+        return false;
+    }
+
+    NextHopGroupMemberOps removed_members;
+    for (const auto &ip : removed)
+    {
+        removed_members.push_back({ &entry, ip });
+    }
+
+    if (!removeNextHopGroupMembers(removed_members))
+    {
+        /*
+         * The group is still keyed by 'current' and next hop ref counts
+         * are untouched, the caller falls back to a new group and the
+         * whole old group gets removed with its remaining members.
+         */
+        return false;
+    }
+
+    for (const auto &ip : added)
+    {
+        m_neighOrch->increaseNextHopRefCount(ip);
+    }
+
+    for (const auto &ip : removed)
+    {
+        m_neighOrch->decreaseNextHopRefCount(ip);
+    }
+
+    SWSS_LOG_NOTICE("Update next hop group %s to %s, %zu member(s) added, %zu removed",
+            current.to_string().c_str(), nextHops.to_string().c_str(),
+            added.size(), removed.size());
+
+    m_syncdNextHopGroups[nextHops] = entry;
+    indexNextHopGroup(*m_syncdNextHopGroups.find(current), false);
+    m_syncdNextHopGroups.erase(current);
+    indexNextHopGroup(*m_syncdNextHopGroups.find(nextHops), true);
+
+    return true;
+}
+
+/*
+ * Create the next hop group members of 'members' in a single bulk call,
+ * skipping next hops on a down port. Created members are recorded in their
+ * group whatever the outcome of the others, false is returned if any failed.
+ */
+bool RouteOrch::addNextHopGroupMembers(const NextHopGroupMemberOps &members)
+{
+    SWSS_LOG_ENTER();
+
+    NextHopGroupMemberOps ops;
+    vector<vector<sai_attribute_t>> attrs;
+
+    for (const auto &member : members)
+    {
+        // skip next hop group member create for neighbor from down port
+        if (m_neighOrch->isNextHopFlagSet(member.ip, NHFLAGS_IFDOWN))
+        {
+            continue;
+        }
+
+        vector<sai_attribute_t> nhgm_attrs;
+        sai_attribute_t nhgm_attr;
+
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+        nhgm_attr.value.oid = member.group->next_hop_group_id;
+        nhgm_attrs.push_back(nhgm_attr);
+
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+        nhgm_attr.value.oid = m_neighOrch->getNextHopId(member.ip);
+        nhgm_attrs.push_back(nhgm_attr);
+
+        ops.push_back(member);
+        attrs.push_back(nhgm_attrs);
+    }
+
+    vector<sai_object_id_t> ids;
+    vector<sai_status_t> statuses;
+    bulkCreateObjects(sai_next_hop_group_api->create_next_hop_group_members,
+                      sai_next_hop_group_api->create_next_hop_group_member,
+                      gSwitchId, attrs, ids, statuses);
+
+    bool rc = true;
+    uint32_t created = 0;
+
+    for (size_t i = 0; i < ops.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to add next hop %s to group %lx: %d\n",
+                           ops[i].ip.to_string().c_str(), ops[i].group->next_hop_group_id, statuses[i]);
+            rc = false;
+            continue;
+        }
+
+        ops[i].group->nhopgroup_members[ops[i].ip] = ids[i];
+        created++;
+    }
+
+    if (created)
+    {
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER, created);
+    }
+
+    return rc;
+}
+
+/*
+ * Remove the next hop group members of 'members' in a single bulk call.
+ * Members of next hops on a down port are already gone from their group
+ * and are only forgotten. Members not in their group are ignored.
+ */
+bool RouteOrch::removeNextHopGroupMembers(const NextHopGroupMemberOps &members)
+{
+    SWSS_LOG_ENTER();
+
+    NextHopGroupMemberOps ops;
+    vector<sai_object_id_t> ids;
+
+    for (const auto &member : members)
+    {
+        auto it = member.group->nhopgroup_members.find(member.ip);
+        if (it == member.group->nhopgroup_members.end())
+        {
+            continue;
+        }
+
+        if (m_neighOrch->isNextHopFlagSet(member.ip, NHFLAGS_IFDOWN))
+        {
+            SWSS_LOG_WARN("NHFLAGS_IFDOWN set for next hop group member %s with next_hop_id %lx",
+                           member.ip.to_string().c_str(), it->second);
+            member.group->nhopgroup_members.erase(it);
+            continue;
+        }
+
+        ops.push_back(member);
+        ids.push_back(it->second);
+    }
+
+    vector<sai_status_t> statuses;
+    bulkRemoveObjects(sai_next_hop_group_api->remove_next_hop_group_members,
+                      sai_next_hop_group_api->remove_next_hop_group_member,
+                      ids, statuses);
+
+    bool rc = true;
+    uint32_t removed = 0;
+
+    for (size_t i = 0; i < ops.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove next hop member %lx from group %lx: %d\n",
+                           ids[i], ops[i].group->next_hop_group_id, statuses[i]);
+            rc = false;
+            continue;
+        }
+
+        ops[i].group->nhopgroup_members.erase(ops[i].ip);
+        removed++;
+    }
+
+    if (removed)
+    {
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER, removed);
+    }
+
+    return rc;
+}
+
 void RouteOrch::addTempRoute(IpPrefix ipPrefix, IpAddresses nextHops)
 {
     SWSS_LOG_ENTER();
@@ -725,22 +1050,29 @@ void RouteOrch::addTempRoute(IpPrefix ipPrefix, IpAddresses nextHops)
     advance(it, rand() % next_hop_set.size());
 
     /* Set the route's temporary next hop to be the randomly picked one */
-    IpAddresses tmp_next_hop((*it).to_string());
+    NextHopSetId tmp_next_hop = m_nextHopSets.intern(IpAddresses((*it).to_string()));
     addRoute(ipPrefix, tmp_next_hop);
+    m_nextHopSets.release(tmp_next_hop);
 }
 
-bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
+/*
+ * Point the route to the interned next hop set 'nextHopSet', on which the
+ * caller holds a reference for the duration of the call.
+ */
+bool RouteOrch::addRoute(IpPrefix ipPrefix, NextHopSetId nextHopSet)
 {
     SWSS_LOG_ENTER();
 
+    const IpAddresses &nextHops = m_nextHopSets.get(nextHopSet);
+
     /* next_hop_id indicates the next hop id or next hop group id of this route */
     sai_object_id_t next_hop_id;
     auto it_route = m_syncdRoutes.find(ipPrefix);
 
     /* The route is pointing to a next hop */
-    if (nextHops.getSize() == 1)
+    if (m_nextHopSets.getSize(nextHopSet) == 1)
     {
-        IpAddress ip_address(nextHops.to_string());
+        const IpAddress &ip_address = m_nextHopSets.getNextHop(nextHopSet);
         if (m_neighOrch->hasNextHop(ip_address))
         {
             next_hop_id = m_neighOrch->getNextHopId(ip_address);
@@ -755,6 +1087,29 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
     /* The route is pointing to a next hop group */
     else
     {
+        /*
+         * When the route is the only user of its current next hop group,
+         * update that group's members in place rather than creating a new
+         * group. The route keeps pointing to the same group object.
+         */
+        if (!hasNextHopGroup(nextHops) && it_route != m_syncdRoutes.end()
+            && m_nextHopSets.getSize(it_route->second.nexthops) > 1
+            && m_syncdNextHopGroups[m_nextHopSets.get(it_route->second.nexthops)].ref_count == 1
+            && updateNextHopGroup(m_nextHopSets.get(it_route->second.nexthops), nextHops))
+        {
+            SWSS_LOG_INFO("Set route %s with next hop(s) %s in place",
+                    ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
+
+            /* The group moved over, only the interned sets change hands */
+            m_nextHopSets.retain(nextHopSet);
+            m_nextHopSets.release(it_route->second.nexthops);
+            it_route->second.nexthops = nextHopSet;
+            it_route->second.generation = m_routeGeneration;
+
+            notifyNextHopChangeObservers(ipPrefix, nextHops, true);
+            return true;
+        }
+
         /* Check if there is already an existing next hop group */
         if (!hasNextHopGroup(nextHops))
         {
@@ -765,9 +1120,9 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
 
                 /* If the current next hop is part of the next hop group to sync,
                  * then return false and no need to add another temporary route. */
-                if (it_route != m_syncdRoutes.end() && it_route->second.getSize() == 1)
+                if (it_route != m_syncdRoutes.end() && m_nextHopSets.getSize(it_route->second.nexthops) == 1)
                 {
-                    IpAddress ip_address(it_route->second.to_string());
+                    const IpAddress &ip_address = m_nextHopSets.getNextHop(it_route->second.nexthops);
                     if (nextHops.contains(ip_address))
                     {
                         return false;
@@ -829,7 +1184,7 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
         }
 
         /* Increase the ref_count for the next hop (group) entry */
-        increaseNextHopRefCount(nextHops);
+        refNextHopSet(nextHopSet);
         SWSS_LOG_INFO("Create route %s with next hop(s) %s",
                 ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
     }
@@ -838,7 +1193,7 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
         sai_status_t status;
 
         /* Set the packet action to forward when there was no next hop (dropped) */
-        if (it_route->second.getSize() == 0)
+        if (it_route->second.nexthops == EMPTY_NEXTHOP_SET)
         {
             route_attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
             route_attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
@@ -865,19 +1220,13 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
         }
 
         /* Increase the ref_count for the next hop (group) entry */
-        increaseNextHopRefCount(nextHops);
-
-        decreaseNextHopRefCount(it_route->second);
-        if (it_route->second.getSize() > 1
-            && m_syncdNextHopGroups[it_route->second].ref_count == 0)
-        {
-            removeNextHopGroup(it_route->second);
-        }
+        refNextHopSet(nextHopSet);
+        unrefNextHopSet(it_route->second.nexthops);
         SWSS_LOG_INFO("Set route %s with next hop(s) %s",
                 ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
     }
 
-    m_syncdRoutes[ipPrefix] = nextHops;
+    m_syncdRoutes[ipPrefix] = { nextHopSet, m_routeGeneration };
 
     notifyNextHopChangeObservers(ipPrefix, nextHops, true);
     return true;
@@ -951,22 +1300,19 @@ bool RouteOrch::removeRoute(IpPrefix ipPrefix)
          * and check wheather the reference count decreases to zero. If yes, then we need
          * to remove the next hop group.
          */
-        decreaseNextHopRefCount(it_route->second);
-        if (it_route->second.getSize() > 1
-            && m_syncdNextHopGroups[it_route->second].ref_count == 0)
-        {
-            removeNextHopGroup(it_route->second);
-        }
+        SWSS_LOG_INFO("Remove route %s with next hop(s) %s",
+                ipPrefix.to_string().c_str(), m_nextHopSets.get(it_route->second.nexthops).to_string().c_str());
+
+        unrefNextHopSet(it_route->second.nexthops);
+        it_route->second.nexthops = EMPTY_NEXTHOP_SET;
     }
-    SWSS_LOG_INFO("Remove route %s with next hop(s) %s",
-            ipPrefix.to_string().c_str(), it_route->second.to_string().c_str());
 
     if (ipPrefix.isDefaultRoute())
     {
-        m_syncdRoutes[ipPrefix] = IpAddresses();
+        m_syncdRoutes[ipPrefix].nexthops = EMPTY_NEXTHOP_SET;
 
         /* Notify about default route next hop change */
-        notifyNextHopChangeObservers(ipPrefix, m_syncdRoutes[ipPrefix], true);
+        notifyNextHopChangeObservers(ipPrefix, IpAddresses(), true);
     }
     else
     {
@@ -978,3 +1324,75 @@ bool RouteOrch::removeRoute(IpPrefix ipPrefix)
 
     return true;
 }
+
+void RouteOrch::startResyncSweep()
+{
+    SWSS_LOG_ENTER();
+
+    m_resyncSweep = true;
+    m_resyncSweepNext = m_syncdRoutes.begin()->first;
+    m_resyncSweepTimer->start();
+}
+
+void RouteOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_resyncSweep)
+    {
+        m_resyncSweepTimer->stop();
+        return;
+    }
+
+    if (!gPortsOrch->isPortReady())
+    {
+        return;
+    }
+
+    sweepStaleRoutes();
+}
+
+/*
+ * Remove up to RESYNC_SWEEP_BATCH_SIZE routes not refreshed during the last
+ * resync, resuming from where the previous batch stopped.
+ */
+void RouteOrch::sweepStaleRoutes()
+{
+    SWSS_LOG_ENTER();
+
+    size_t removed = 0;
+    auto it = m_syncdRoutes.lower_bound(m_resyncSweepNext);
+
+    while (it != m_syncdRoutes.end() && removed < RESYNC_SWEEP_BATCH_SIZE)
+    {
+        /* Dropped default routes have nothing left to remove */
+        if (it->second.generation == m_routeGeneration || it->second.nexthops == EMPTY_NEXTHOP_SET)
+        {
+            it++;
+            continue;
+        }
+
+        IpPrefix prefix = it->first;
+        it++;
+
+        if (!removeRoute(prefix))
+        {
+            /* Retry from this route on the next batch */
+            m_resyncSweepNext = prefix;
+            return;
+        }
+
+        removed++;
+    }
+
+    if (it != m_syncdRoutes.end())
+    {
+        m_resyncSweepNext = it->first;
+        return;
+    }
+
+    SWSS_LOG_NOTICE("Resync generation %u swept", m_routeGeneration);
+
+    m_resyncSweep = false;
+    m_resyncSweepTimer->stop();
+}
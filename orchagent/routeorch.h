@@ -5,12 +5,15 @@
 #include "observer.h"
 #include "intfsorch.h"
 #include "neighorch.h"
+#include "nexthopsets.h"
+#include "fpmsyncd/routering.h"
 
 #include "ipaddress.h"
 #include "ipaddresses.h"
 #include "ipprefix.h"
 
 #include <map>
+#include <set>
 
 /* Maximum next hop group number */
 #define NHGRP_MAX_SIZE 128
@@ -24,6 +27,15 @@ struct NextHopGroupEntry
     NextHopGroupMembers     nhopgroup_members;      // ids of members indexed by ip address
 };
 
+/* Next hop group member to be created or removed along with others */
+struct NextHopGroupMemberOp
+{
+    NextHopGroupEntry      *group;                  // next hop group of the member
+    IpAddress               ip;                     // next hop IP address of the member
+};
+
+typedef std::vector<NextHopGroupMemberOp> NextHopGroupMemberOps;
+
 struct NextHopUpdate
 {
     IpAddress destination;
@@ -33,10 +45,20 @@ struct NextHopUpdate
 
 struct NextHopObserverEntry;
 
+struct SyncdRouteEntry
+{
+    NextHopSetId            nexthops;               // interned next hop IP address(es)
+    uint32_t                generation;             // route resync generation the route was last refreshed in
+};
+
 /* NextHopGroupTable: next hop group IP addersses, NextHopGroupEntry */
 typedef std::map<IpAddresses, NextHopGroupEntry> NextHopGroupTable;
+/* NextHopGroupIndex: next hop IP address, next hop groups it is a member of */
+typedef std::map<IpAddress, std::set<NextHopGroupTable::value_type *>> NextHopGroupIndex;
 /* RouteTable: destination network, next hop IP address(es) */
 typedef std::map<IpPrefix, IpAddresses> RouteTable;
+/* SyncdRouteTable: destination network, synced route entry */
+typedef std::map<IpPrefix, SyncdRouteEntry> SyncdRouteTable;
 /* NextHopObserverTable: Destination IP address, next hop observer entry */
 typedef std::map<IpAddress, NextHopObserverEntry> NextHopObserverTable;
 
@@ -46,11 +68,37 @@ struct NextHopObserverEntry
     list<Observer *> observers;
 };
 
+/*
+ * Route updates sent by fpmsyncd through the route ring, handed over to the
+ * ROUTE_TABLE consumer as if they had been popped from APP_DB.
+ */
+class RouteRingConsumer : public Executor
+{
+public:
+    RouteRingConsumer(swss::RouteRingReader *ring, Orch *orch, Consumer *consumer);
+
+    void execute();
+
+    void setBudget(size_t entries) override { m_budget = entries; }
+    size_t getExecuted() const override { return m_executed; }
+    bool hasBacklog() const override { return !m_ring->empty(); }
+
+private:
+    swss::RouteRingReader *m_ring;
+    Consumer *m_consumer;
+
+    size_t m_budget = SIZE_MAX;
+    size_t m_executed = 0;
+};
+
 class RouteOrch : public Orch, public Subject
 {
 public:
     RouteOrch(DBConnector *db, string tableName, NeighOrch *neighOrch);
 
+    /* Offer fpmsyncd a route ring, on top of ROUTE_TABLE */
+    void enableRouteRing();
+
     bool hasNextHopGroup(const IpAddresses&) const;
     sai_object_id_t getNextHopGroupId(const IpAddresses&);
 
@@ -66,6 +114,7 @@ public:
 
     bool validnexthopinNextHopGroup(const IpAddress &);
     bool invalidnexthopinNextHopGroup(const IpAddress &);
+    bool invalidnexthopsinNextHopGroups(const vector<IpAddress> &, size_t &);
 
     void notifyNextHopChangeObservers(IpPrefix, IpAddresses, bool);
 private:
@@ -75,16 +124,41 @@ private:
     int m_maxNextHopGroupCount;
     bool m_resync;
 
-    RouteTable m_syncdRoutes;
+    /*
+     * Route resync is a mark and sweep: starting a resync bumps the
+     * generation, every route refreshed by the application is stamped with
+     * it, and completing the resync sweeps the routes left with an older
+     * generation in bounded batches driven by m_resyncSweepTimer.
+     */
+    uint32_t m_routeGeneration;
+    bool m_resyncSweep;
+    IpPrefix m_resyncSweepNext;
+    SelectableTimer *m_resyncSweepTimer;
+
+    SyncdRouteTable m_syncdRoutes;
+    NextHopSetTable m_nextHopSets;
     NextHopGroupTable m_syncdNextHopGroups;
+    NextHopGroupIndex m_nextHopGroupIndex;
 
     NextHopObserverTable m_nextHopObservers;
 
+    void indexNextHopGroup(NextHopGroupTable::value_type &, bool);
+    bool updateNextHopGroup(IpAddresses, IpAddresses);
+    bool addNextHopGroupMembers(const NextHopGroupMemberOps&);
+    bool removeNextHopGroupMembers(const NextHopGroupMemberOps&);
+
+    void refNextHopSet(NextHopSetId);
+    void unrefNextHopSet(NextHopSetId);
+
     void addTempRoute(IpPrefix, IpAddresses);
-    bool addRoute(IpPrefix, IpAddresses);
+    bool addRoute(IpPrefix, NextHopSetId);
     bool removeRoute(IpPrefix);
 
+    void startResyncSweep();
+    void sweepStaleRoutes();
+
     void doTask(Consumer& consumer);
+    void doTask(SelectableTimer &timer);
 };
 
 #endif /* SWSS_ROUTEORCH_H */
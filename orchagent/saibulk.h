@@ -0,0 +1,94 @@
+// Helpers issuing SAI bulk object create/remove calls, falling back to one
+// call per object when the SAI implementation doesn't provide the bulk API.
+//
+#pragma once
+
+#include <vector>
+extern "C" {
+#include "sai.h"
+}
+
+namespace swss {
+
+/*
+ * Remove 'ids' with a single bulk call when 'bulkRemove' is implemented,
+ * otherwise with one 'remove' call per object. Per object results are
+ * returned in 'statuses', removal keeps going past failures.
+ */
+template <typename RemoveFn>
+inline static void bulkRemoveObjects(sai_bulk_object_remove_fn bulkRemove, RemoveFn remove,
+                                     const std::vector<sai_object_id_t> &ids,
+                                     std::vector<sai_status_t> &statuses)
+{
+    statuses.assign(ids.size(), SAI_STATUS_NOT_EXECUTED);
+
+    if (ids.empty())
+    {
+        return;
+    }
+
+    if (bulkRemove)
+    {
+        sai_status_t status = bulkRemove((uint32_t)ids.size(), ids.data(),
+                                         SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                         statuses.data());
+        if (status != SAI_STATUS_NOT_IMPLEMENTED && status != SAI_STATUS_NOT_SUPPORTED)
+        {
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+        statuses[i] = remove(ids[i]);
+    }
+}
+
+/*
+ * Create objects described by 'attrs' with a single bulk call when
+ * 'bulkCreate' is implemented, otherwise with one 'create' call per object.
+ * Per object ids and results are returned in 'ids' and 'statuses'.
+ */
+template <typename CreateFn>
+inline static void bulkCreateObjects(sai_bulk_object_create_fn bulkCreate, CreateFn create,
+                                     sai_object_id_t switchId,
+                                     const std::vector<std::vector<sai_attribute_t>> &attrs,
+                                     std::vector<sai_object_id_t> &ids,
+                                     std::vector<sai_status_t> &statuses)
+{
+    ids.assign(attrs.size(), SAI_NULL_OBJECT_ID);
+    statuses.assign(attrs.size(), SAI_STATUS_NOT_EXECUTED);
+
+    if (attrs.empty())
+    {
+        return;
+    }
+
+    if (bulkCreate)
+    {
+        std::vector<uint32_t> attrCounts;
+        std::vector<const sai_attribute_t *> attrLists;
+
+        for (const auto &a : attrs)
+        {
+            attrCounts.push_back((uint32_t)a.size());
+            attrLists.push_back(a.data());
+        }
+
+        sai_status_t status = bulkCreate(switchId, (uint32_t)attrs.size(),
+                                         attrCounts.data(), attrLists.data(),
+                                         SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                         ids.data(), statuses.data());
+        if (status != SAI_STATUS_NOT_IMPLEMENTED && status != SAI_STATUS_NOT_SUPPORTED)
+        {
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < attrs.size(); i++)
+    {
+        statuses[i] = create(&ids[i], switchId, (uint32_t)attrs[i].size(), attrs[i].data());
+    }
+}
+
+}
@@ -1175,8 +1175,10 @@ bool VNetOrch::addOperation(const Request& request)
     uint32_t vni=0;
     string tunnel;
 
-    for (const auto& name: request.getAttrFieldNames())
+    for (const auto& field: request.getAttrFields())
     {
+        const auto& name = field.name;
+
         if (name == "src_mac")
         {
             const auto& mac = request.getAttrMacAddress("src_mac");
@@ -1650,8 +1652,10 @@ bool VNetRouteOrch::handleRoutes(const Request& request)
     IpAddresses ip_addresses;
     string ifname = "";
 
-    for (const auto& name: request.getAttrFieldNames())
+    for (const auto& field: request.getAttrFields())
     {
+        const auto& name = field.name;
+
         if (name == "ifname")
         {
             ifname = request.getAttrString(name);
@@ -1696,8 +1700,10 @@ bool VNetRouteOrch::handleTunnel(const Request& request)
     MacAddress mac;
     uint32_t vni = 0;
 
-    for (const auto& name: request.getAttrFieldNames())
+    for (const auto& field: request.getAttrFields())
     {
+        const auto& name = field.name;
+
         if (name == "endpoint")
         {
             ip = request.getAttrIP(name);
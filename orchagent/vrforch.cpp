@@ -21,8 +21,10 @@ bool VRFOrch::addOperation(const Request& request)
     sai_attribute_t attr;
     vector<sai_attribute_t> attrs;
 
-    for (const auto& name: request.getAttrFieldNames())
+    for (const auto& field: request.getAttrFields())
     {
+        const auto& name = field.name;
+
         if (name == "v4")
         {
             attr.id = SAI_VIRTUAL_ROUTER_ATTR_ADMIN_V4_STATE;
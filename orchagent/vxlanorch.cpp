@@ -633,8 +633,7 @@ bool VxlanTunnelOrch::addOperation(const Request& request)
     }
 
     IpAddress dst_ip;
-    auto attr_names = request.getAttrFieldNames();
-    if (attr_names.count("dst_ip") == 0)
+    if (!request.hasAttr("dst_ip"))
     {
         dst_ip = IpAddress("0.0.0.0");
     }
@@ -96,9 +96,13 @@ void WatermarkOrch::doTask(Consumer &consumer)
 
 void WatermarkOrch::doTask(NotificationConsumer &consumer)
 {
-    if (!gPortsOrch->isPortReady())
     {
-        return;
+        /* Notifications may be handled on the telemetry worker loop */
+        lock_guard<recursive_mutex> lock(gOrchStateMutex);
+        if (!gPortsOrch->isPortReady())
+        {
+            return;
+        }
     }
 
     std::string op;
@@ -30,6 +30,7 @@ const string INTFS_PREFIX = "Ethernet";
 const string LAG_PREFIX = "PortChannel";
 
 extern set<string> g_portSet;
+extern set<string> g_knownPortSet;
 extern bool g_init;
 
 struct if_nameindex
@@ -218,8 +219,7 @@ void LinkSync::onMsg(int nlmsg_type, struct nl_object *obj)
     /* front panel interfaces: Check if the port is in the PORT_TABLE
      * non-front panel interfaces such as eth0, lo which are not in the
      * PORT_TABLE are ignored. */
-    vector<FieldValueTuple> temp;
-    if (m_portTable.get(key, temp))
+    if (g_knownPortSet.find(key) != g_knownPortSet.end())
     {
         /* TODO: When port is removed from the kernel */
         if (nlmsg_type == RTM_DELLINK)
@@ -33,6 +33,13 @@ using namespace swss;
 set<string> g_portSet;
 bool g_init = false;
 
+/*
+ * All front panel ports this daemon has written to the APP_DB PORT_TABLE.
+ * LinkSync checks netlink messages against it instead of reading the
+ * PORT_TABLE back for every message.
+ */
+set<string> g_knownPortSet;
+
 void usage()
 {
     cout << "Usage: portsyncd [-p port_config.ini]" << endl;
@@ -45,6 +52,7 @@ bool handlePortConfigFromConfigDB(ProducerStateTable &p, DBConnector &cfgDb, boo
 void handleVlanIntfFile(string file);
 void handlePortConfig(ProducerStateTable &p, map<string, KeyOpFieldsValuesTuple> &port_cfg_map);
 void checkPortInitDone(DBConnector *appl_db);
+void handlePendingPortWork(ProducerStateTable &p, map<string, KeyOpFieldsValuesTuple> &port_cfg_map);
 
 int main(int argc, char **argv)
 {
@@ -105,11 +113,18 @@ int main(int argc, char **argv)
         s.addSelectable(&netlink);
         s.addSelectable(&portCfg);
 
+        /*
+         * Both PortInitDone and the pending port configuration only wait
+         * for host interfaces to be created, which is learnt from netlink
+         * messages, so there is nothing to do between two events.
+         */
+        handlePendingPortWork(p, port_cfg_map);
+
         while (true)
         {
             Selectable *temps;
             int ret;
-            ret = s.select(&temps, 1);
+            ret = s.select(&temps);
 
             if (ret == Select::ERROR)
             {
@@ -117,30 +132,6 @@ int main(int argc, char **argv)
                 continue;
             }
 
-            if (ret == Select::TIMEOUT)
-            {
-                if (!g_init && g_portSet.empty())
-                {
-                    /*
-                     * After finishing reading port configuration file and
-                     * creating all host interfaces, this daemon shall send
-                     * out a signal to orchagent indicating port initialization
-                     * procedure is done and other application could start
-                     * syncing.
-                     */
-                    FieldValueTuple finish_notice("lanes", "0");
-                    vector<FieldValueTuple> attrs = { finish_notice };
-                    p.set("PortInitDone", attrs);
-                    SWSS_LOG_NOTICE("PortInitDone");
-
-                    g_init = true;
-                }
-                if (!port_cfg_map.empty())
-                {
-                    handlePortConfig(p, port_cfg_map);
-                }
-            }
-
             if (temps == (Selectable *)&portCfg)
             {
                 std::deque<KeyOpFieldsValuesTuple> entries;
@@ -157,8 +148,9 @@ int main(int argc, char **argv)
                     }
                     port_cfg_map[key] = entry;
                 }
-                handlePortConfig(p, port_cfg_map);
             }
+
+            handlePendingPortWork(p, port_cfg_map);
         }
     }
     catch (const std::exception& e)
@@ -207,6 +199,7 @@ bool handlePortConfigFromConfigDB(ProducerStateTable &p, DBConnector &cfgDb, boo
             p.set(k, attrs);
         }
         g_portSet.insert(k);
+        g_knownPortSet.insert(k);
     }
     if (!warm)
     {
@@ -298,6 +291,7 @@ void handlePortConfigFile(ProducerStateTable &p, string file, bool warm)
         }
 
         g_portSet.insert(entry["name"]);
+        g_knownPortSet.insert(entry["name"]);
     }
 
     infile.close();
@@ -325,6 +319,7 @@ void handlePortConfig(ProducerStateTable &p, map<string, KeyOpFieldsValuesTuple>
             if (op == SET_COMMAND)
             {
                 p.set(key, values);
+                g_knownPortSet.insert(key);
             }
 
             it = port_cfg_map.erase(it);
@@ -335,3 +330,28 @@ void handlePortConfig(ProducerStateTable &p, map<string, KeyOpFieldsValuesTuple>
         }
     }
 }
+
+void handlePendingPortWork(ProducerStateTable &p, map<string, KeyOpFieldsValuesTuple> &port_cfg_map)
+{
+    if (!g_init && g_portSet.empty())
+    {
+        /*
+         * After finishing reading port configuration file and
+         * creating all host interfaces, this daemon shall send
+         * out a signal to orchagent indicating port initialization
+         * procedure is done and other application could start
+         * syncing.
+         */
+        FieldValueTuple finish_notice("lanes", "0");
+        vector<FieldValueTuple> attrs = { finish_notice };
+        p.set("PortInitDone", attrs);
+        SWSS_LOG_NOTICE("PortInitDone");
+
+        g_init = true;
+    }
+
+    if (!port_cfg_map.empty())
+    {
+        handlePortConfig(p, port_cfg_map);
+    }
+}
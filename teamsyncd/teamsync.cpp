@@ -5,6 +5,7 @@
 #include <linux/if.h>
 #include <netlink/route/link.h>
 #include <chrono>
+#include <algorithm>
 #include "logger.h"
 #include "netmsg.h"
 #include "dbconnector.h"
@@ -19,11 +20,14 @@ using namespace swss;
 /* Taken from drivers/net/team/team.c */
 #define TEAM_DRV_NAME "team"
 
-TeamSync::TeamSync(DBConnector *db, DBConnector *stateDb, Select *select) :
+TeamSync::TeamSync(DBConnector *db, DBConnector *stateDb, Select *select,
+                   uint32_t debounceMsecs) :
     m_select(select),
-    m_lagTable(db, APP_LAG_TABLE_NAME),
-    m_lagMemberTable(db, APP_LAG_MEMBER_TABLE_NAME),
-    m_stateLagTable(stateDb, STATE_LAG_TABLE_NAME)
+    m_pipeline(db),
+    m_lagTable(&m_pipeline, APP_LAG_TABLE_NAME, true),
+    m_lagMemberTable(&m_pipeline, APP_LAG_MEMBER_TABLE_NAME, true),
+    m_stateLagTable(stateDb, STATE_LAG_TABLE_NAME),
+    m_debounce(debounceMsecs)
 {
     WarmStart::initialize("teamsyncd", "teamd");
     WarmStart::checkWarmStart("teamsyncd", "teamd");
@@ -47,12 +51,50 @@ void TeamSync::periodic()
         auto diff = duration_cast<seconds>(steady_clock::now() - m_start_time);
         if(diff.count() > m_pending_timeout)
         {
+            /* Members missing from the temp view would be removed, then added back */
+            publishLagMembers(true);
             applyState();
             m_warmstart = false; // apply state just once
         }
     }
 
     doSelectableTask();
+    publishLagMembers();
+
+    m_pipeline.flush();
+}
+
+int TeamSync::getSelectTimeout()
+{
+    auto now = steady_clock::now();
+    int timeout = DEFAULT_SELECT_TIMEOUT_MSECS;
+
+    for (const auto &it : m_teamSelectables)
+    {
+        if (!it.second->isChangePending())
+        {
+            continue;
+        }
+
+        auto due = duration_cast<milliseconds>(it.second->getChangeTime() + m_debounce - now);
+        timeout = min(timeout, max(0, (int)due.count()));
+    }
+
+    return timeout;
+}
+
+void TeamSync::publishLagMembers(bool force)
+{
+    auto now = steady_clock::now();
+
+    for (const auto &it : m_teamSelectables)
+    {
+        if (it.second->isChangePending() &&
+            (force || now - it.second->getChangeTime() >= m_debounce))
+        {
+            it.second->publishMembers();
+        }
+    }
 }
 
 void TeamSync::doSelectableTask()
@@ -236,6 +278,21 @@ TeamSync::TeamPortSync::~TeamPortSync()
 }
 
 int TeamSync::TeamPortSync::onChange()
+{
+    /*
+     * teamd fires a burst of callbacks during LACP negotiation, the LAG
+     * members are read and published once the burst has settled.
+     */
+    if (!m_changePending)
+    {
+        m_changePending = true;
+        m_changeTime = steady_clock::now();
+    }
+
+    return 0;
+}
+
+void TeamSync::TeamPortSync::publishMembers()
 {
     struct team_port *port;
     map<string, bool> tmp_lag_members;
@@ -290,7 +347,7 @@ int TeamSync::TeamPortSync::onChange()
 
     /* Replace the old LAG members with the new ones */
     m_lagMembers = tmp_lag_members;
-    return 0;
+    m_changePending = false;
 }
 
 int TeamSync::TeamPortSync::teamdHandler(struct team_handle *team, void *arg,
@@ -14,6 +14,11 @@
 // seconds
 const uint32_t DEFAULT_WR_PENDING_TIMEOUT = 70;
 
+// milliseconds, LAG member changes are held this long before being published
+const uint32_t DEFAULT_MEMBER_DEBOUNCE_MSECS = 50;
+// milliseconds, longest wait between two periodic() calls
+const int DEFAULT_SELECT_TIMEOUT_MSECS = 1000;
+
 using namespace std::chrono;
 
 namespace swss {
@@ -21,10 +26,14 @@ namespace swss {
 class TeamSync : public NetMsg
 {
 public:
-    TeamSync(DBConnector *db, DBConnector *stateDb, Select *select);
+    TeamSync(DBConnector *db, DBConnector *stateDb, Select *select,
+             uint32_t debounceMsecs = DEFAULT_MEMBER_DEBOUNCE_MSECS);
 
     void periodic();
 
+    /* Milliseconds to wait in select before periodic() has work to do */
+    int getSelectTimeout();
+
     /* Listen to RTM_NEWLINK, RTM_DELLINK to track team devices */
     virtual void onMsg(int nlmsg_type, struct nl_object *obj);
 
@@ -39,7 +48,21 @@ public:
         int getFd() override;
         void readData() override;
 
-        /* member_name -> enabled|disabled */
+        /* Publish the member changes since the last published state */
+        void publishMembers();
+
+        bool isChangePending() const
+        {
+            return m_changePending;
+        }
+
+        /* Time of the first change not published yet */
+        steady_clock::time_point getChangeTime() const
+        {
+            return m_changeTime;
+        }
+
+        /* member_name -> enabled|disabled, as last published */
         std::map<std::string, bool> m_lagMembers;
     protected:
         int onChange();
@@ -51,6 +74,8 @@ public:
         struct team_handle *m_team;
         std::string m_lagName;
         int m_ifindex;
+        bool m_changePending = false;
+        steady_clock::time_point m_changeTime;
     };
 
 protected:
@@ -64,8 +89,13 @@ protected:
     /* Handle all selectables add/removal events */
     void doSelectableTask();
 
+    /* Publish the LAG member changes whose debounce window has expired, or all of them if 'force' */
+    void publishLagMembers(bool force = false);
+
 private:
     Select *m_select;
+    /* LAG and LAG member updates are written once per periodic() call */
+    RedisPipeline m_pipeline;
     ProducerStateTable m_lagTable;
     ProducerStateTable m_lagMemberTable;
     Table m_stateLagTable;
@@ -74,6 +104,7 @@ private:
     std::unordered_map<std::string, std::vector<FieldValueTuple>> m_stateLagTablePreserved;
     steady_clock::time_point m_start_time;
     uint32_t m_pending_timeout;
+    milliseconds m_debounce;
 
     /* Store selectables needed to be updated in doSelectableTask function */
     std::set<std::string> m_selectablesToAdd;
@@ -1,3 +1,4 @@
+#include <getopt.h>
 #include <iostream>
 #include <team.h>
 #include "logger.h"
@@ -9,13 +10,39 @@
 using namespace std;
 using namespace swss;
 
+void usage()
+{
+    cout << "Usage: teamsyncd [-d debounce_msecs]" << endl;
+    cout << "       -d debounce_msecs: time LAG member changes are held before being published" << endl;
+    cout << "                          (default " << DEFAULT_MEMBER_DEBOUNCE_MSECS << ")" << endl;
+}
+
 int main(int argc, char **argv)
 {
     swss::Logger::linkToDbNative("teamsyncd");
+    int opt;
+    uint32_t debounceMsecs = DEFAULT_MEMBER_DEBOUNCE_MSECS;
+
+    while ((opt = getopt(argc, argv, "d:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'd':
+            debounceMsecs = (uint32_t)stoul(optarg);
+            break;
+        case 'h':
+            usage();
+            return 1;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
     DBConnector db(APPL_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
     DBConnector stateDb(STATE_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
     Select s;
-    TeamSync sync(&db, &stateDb, &s);
+    TeamSync sync(&db, &stateDb, &s, debounceMsecs);
 
     NetDispatcher::getInstance().registerMessageHandler(RTM_NEWLINK, &sync);
     NetDispatcher::getInstance().registerMessageHandler(RTM_DELLINK, &sync);
@@ -34,7 +61,8 @@ int main(int argc, char **argv)
             while (true)
             {
                 Selectable *temps;
-                s.select(&temps, 1000); // block for a second
+                /* block for a second, or until pending LAG member changes are due */
+                s.select(&temps, sync.getSelectTimeout());
                 sync.periodic();
             }
         }
@@ -0,0 +1,150 @@
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <string.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "aclruleattr.h"
+
+using namespace std;
+
+namespace {
+
+bool parseMatch(const string &name, const string &value, sai_attribute_value_t &out)
+{
+    const AclRuleAttr *attr = findAclRuleAttr(name);
+
+    memset(&out, 0, sizeof(out));
+    return attr && attr->kind == ACL_RULE_ATTR_MATCH && attr->parse &&
+           attr->parse(attr->name, value, out);
+}
+
+}
+
+TEST(aclruleattr, lookup_is_case_insensitive)
+{
+    const AclRuleAttr *attr = findAclRuleAttr("l4_src_port_range");
+
+    ASSERT_NE(attr, nullptr);
+    EXPECT_STREQ(attr->name, MATCH_L4_SRC_PORT_RANGE);
+    EXPECT_EQ(attr->kind, ACL_RULE_ATTR_MATCH);
+    EXPECT_EQ(attr->attr, (sai_acl_entry_attr_t)SAI_ACL_RANGE_TYPE_L4_SRC_PORT_RANGE);
+
+    EXPECT_EQ(findAclRuleAttr("Priority"), findAclRuleAttr(RULE_PRIORITY));
+    EXPECT_EQ(findAclRuleAttr(RULE_PRIORITY)->kind, ACL_RULE_ATTR_PRIORITY);
+    EXPECT_EQ(findAclRuleAttr("packet_action")->kind, ACL_RULE_ATTR_ACTION);
+}
+
+TEST(aclruleattr, unknown_names_are_rejected)
+{
+    EXPECT_EQ(findAclRuleAttr(""), nullptr);
+    EXPECT_EQ(findAclRuleAttr("SRC"), nullptr);
+    EXPECT_EQ(findAclRuleAttr("SRC_IPV6X"), nullptr);
+    EXPECT_EQ(findAclRuleAttr("TCP_FLAG"), nullptr);
+    EXPECT_EQ(findAclRuleAttr("ZZZ"), nullptr);
+}
+
+TEST(aclruleattr, every_rule_attribute_is_found)
+{
+    const char *names[] =
+    {
+        RULE_PRIORITY, MATCH_IN_PORTS, MATCH_OUT_PORTS, MATCH_SRC_IP, MATCH_DST_IP,
+        MATCH_SRC_IPV6, MATCH_DST_IPV6, MATCH_L4_SRC_PORT, MATCH_L4_DST_PORT,
+        MATCH_ETHER_TYPE, MATCH_IP_PROTOCOL, MATCH_TCP_FLAGS, MATCH_IP_TYPE, MATCH_DSCP,
+        MATCH_L4_SRC_PORT_RANGE, MATCH_L4_DST_PORT_RANGE, MATCH_TC, MATCH_TUNNEL_VNI,
+        MATCH_INNER_ETHER_TYPE, MATCH_INNER_IP_PROTOCOL, MATCH_INNER_L4_SRC_PORT,
+        MATCH_INNER_L4_DST_PORT, ACTION_PACKET_ACTION, ACTION_MIRROR_ACTION,
+        ACTION_DTEL_FLOW_OP, ACTION_DTEL_INT_SESSION, ACTION_DTEL_DROP_REPORT_ENABLE,
+        ACTION_DTEL_TAIL_DROP_REPORT_ENABLE, ACTION_DTEL_FLOW_SAMPLE_PERCENT,
+        ACTION_DTEL_REPORT_ALL_PACKETS
+    };
+
+    for (const char *name : names)
+    {
+        const AclRuleAttr *attr = findAclRuleAttr(name);
+        ASSERT_NE(attr, nullptr) << name;
+        EXPECT_STREQ(attr->name, name);
+    }
+}
+
+TEST(aclruleattr, match_values)
+{
+    sai_attribute_value_t value;
+
+    ASSERT_TRUE(parseMatch(MATCH_SRC_IP, "10.1.0.0/16", value));
+    EXPECT_EQ(value.aclfield.data.ip4, htonl(0x0a010000));
+    EXPECT_EQ(value.aclfield.mask.ip4, htonl(0xffff0000));
+    EXPECT_FALSE(parseMatch(MATCH_SRC_IP, "2001:db8::/32", value));
+    EXPECT_FALSE(parseMatch(MATCH_DST_IPV6, "10.1.0.0/16", value));
+
+    ASSERT_TRUE(parseMatch(MATCH_TCP_FLAGS, "0x12 / 0x3f", value));
+    EXPECT_EQ(value.aclfield.data.u8, 0x12);
+    EXPECT_EQ(value.aclfield.mask.u8, 0x3f);
+    EXPECT_FALSE(parseMatch(MATCH_TCP_FLAGS, "0x12", value));
+
+    ASSERT_TRUE(parseMatch(MATCH_DSCP, "8/56", value));
+    EXPECT_EQ(value.aclfield.data.u8, 8);
+    EXPECT_EQ(value.aclfield.mask.u8, 56);
+
+    ASSERT_TRUE(parseMatch(MATCH_L4_DST_PORT_RANGE, "1000-2000", value));
+    EXPECT_EQ(value.u32range.min, 1000);
+    EXPECT_EQ(value.u32range.max, 2000);
+    EXPECT_FALSE(parseMatch(MATCH_L4_DST_PORT_RANGE, "2000-1000", value));
+
+    ASSERT_TRUE(parseMatch(MATCH_IP_TYPE, "non_ipv4", value));
+    EXPECT_EQ(value.aclfield.data.u32, (uint32_t)SAI_ACL_IP_TYPE_NON_IPV4);
+    EXPECT_FALSE(parseMatch(MATCH_IP_TYPE, "IPV5ANY", value));
+
+    /* Port lists are resolved by the rule */
+    EXPECT_FALSE(parseMatch(MATCH_IN_PORTS, "Ethernet0", value));
+}
+
+/*
+ * Attribute parse throughput over the fields of a typical data plane ACL
+ * rule, as read from the APPL_DB with the casing config_db leaves in place.
+ */
+TEST(aclruleattr, benchmark_rule_parse)
+{
+    const vector<pair<string, string>> rule =
+    {
+        { "PRIORITY",      "9999" },
+        { "SRC_IP",        "10.0.0.0/8" },
+        { "DST_IP",        "192.168.1.0/24" },
+        { "IP_PROTOCOL",   "6" },
+        { "L4_SRC_PORT",   "179" },
+        { "L4_DST_PORT_RANGE", "1024-65535" },
+        { "TCP_FLAGS",     "0x02/0x02" },
+        { "ether_type",    "0x0800" },
+        { "PACKET_ACTION", "DROP" }
+    };
+
+    const int rounds = 200000;
+    size_t parsed = 0;
+    sai_attribute_value_t value;
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+    {
+        for (const auto &fv : rule)
+        {
+            const AclRuleAttr *attr = findAclRuleAttr(fv.first);
+            if (!attr)
+            {
+                continue;
+            }
+
+            if (!attr->parse || attr->parse(attr->name, fv.second, value))
+            {
+                parsed++;
+            }
+        }
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(parsed, rule.size() * rounds);
+
+    cout << "ACL rule attribute parser: " << parsed << " attributes in " << elapsed.count()
+         << " s, " << (size_t)((double)parsed / elapsed.count()) << " attributes/s" << endl;
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "adaptivebatch.h"
+
+using namespace std;
+using namespace swss;
+
+namespace {
+
+const ConsumerBatchConfig config = { 16, 1024, chrono::milliseconds(50) };
+
+}
+
+TEST(adaptivebatch, grows_with_backlog)
+{
+    AdaptiveBatch batch(config);
+
+    EXPECT_EQ(batch.size(), 16);
+
+    /* Partial batches mean the backlog is gone */
+    batch.update(10, chrono::milliseconds(1));
+    EXPECT_EQ(batch.size(), 16);
+
+    for (size_t expected = 32; expected <= 1024; expected *= 2)
+    {
+        batch.update(batch.size(), chrono::milliseconds(1));
+        EXPECT_EQ(batch.size(), expected);
+    }
+
+    batch.update(batch.size(), chrono::milliseconds(1));
+    EXPECT_EQ(batch.size(), 1024);
+}
+
+TEST(adaptivebatch, shrinks_on_missed_latency_target)
+{
+    AdaptiveBatch batch(config);
+
+    for (int i = 0; i < 4; i++)
+    {
+        batch.update(batch.size(), chrono::milliseconds(1));
+    }
+    ASSERT_EQ(batch.size(), 256);
+
+    /* Even with a backlog */
+    batch.update(256, chrono::milliseconds(80));
+    EXPECT_EQ(batch.size(), 128);
+
+    for (int i = 0; i < 8; i++)
+    {
+        batch.update(batch.size(), chrono::milliseconds(80));
+    }
+    EXPECT_EQ(batch.size(), 16);
+
+    EXPECT_EQ(batch.takeMaxLatency(), chrono::milliseconds(80));
+    EXPECT_EQ(batch.takeMaxLatency(), chrono::microseconds(0));
+}
+
+TEST(adaptivebatch, parse_config)
+{
+    ConsumerBatchConfig parsed = config;
+
+    ASSERT_TRUE(parseConsumerBatchConfig({ { "min_batch_size", "4" },
+                                           { "max_batch_size", "8192" },
+                                           { "latency_target_ms", "20" } }, parsed));
+    EXPECT_EQ(parsed.minSize, 4);
+    EXPECT_EQ(parsed.maxSize, 8192);
+    EXPECT_EQ(parsed.latencyTarget, chrono::milliseconds(20));
+
+    /* Missing fields keep their value */
+    ASSERT_TRUE(parseConsumerBatchConfig({ { "max_batch_size", "64" } }, parsed));
+    EXPECT_EQ(parsed.minSize, 4);
+    EXPECT_EQ(parsed.maxSize, 64);
+
+    const vector<vector<FieldValueTuple>> invalid = {
+        { { "min_batch_size", "0" } },
+        { { "min_batch_size", "128" } },
+        { { "max_batch_size", "many" } },
+        { { "latency_target_ms", "0" } },
+        { { "min_batch_size", "-1" } }
+    };
+
+    for (const auto &fvs : invalid)
+    {
+        EXPECT_FALSE(parseConsumerBatchConfig(fvs, parsed)) << fvField(fvs[0]) << "=" << fvValue(fvs[0]);
+        EXPECT_EQ(parsed.minSize, 4);
+        EXPECT_EQ(parsed.maxSize, 64);
+    }
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include "flushpolicy.h"
+
+using namespace std;
+
+namespace {
+
+typedef chrono::steady_clock Clock;
+
+}
+
+TEST(flushpolicy, flushes_when_idle)
+{
+    FlushPolicy policy(1024, chrono::milliseconds(10));
+    auto now = Clock::now();
+
+    EXPECT_FALSE(policy.due(true, now));
+
+    policy.add(1, now);
+    EXPECT_FALSE(policy.due(false, now));
+    EXPECT_TRUE(policy.due(true, now));
+
+    policy.flushed(now);
+    EXPECT_EQ(policy.pending(), 0);
+    EXPECT_FALSE(policy.due(true, now));
+}
+
+TEST(flushpolicy, batches_while_busy)
+{
+    FlushPolicy policy(100, chrono::milliseconds(10));
+    auto start = Clock::now();
+
+    policy.add(60, start);
+    EXPECT_FALSE(policy.due(false, start));
+
+    /* Up to the pending operations limit */
+    policy.add(40, start + chrono::milliseconds(1));
+    EXPECT_TRUE(policy.due(false, start + chrono::milliseconds(1)));
+    policy.flushed(start + chrono::milliseconds(2));
+
+    /* Or the latency deadline of the oldest one */
+    policy.add(1, start + chrono::milliseconds(3));
+    policy.add(1, start + chrono::milliseconds(12));
+    EXPECT_FALSE(policy.due(false, start + chrono::milliseconds(12)));
+    EXPECT_TRUE(policy.due(false, start + chrono::milliseconds(13)));
+    policy.flushed(start + chrono::milliseconds(13));
+
+    FlushPolicy::Stats stats = policy.takeStats();
+    EXPECT_EQ(stats.flushes, 2);
+    EXPECT_EQ(stats.ops, 102);
+    EXPECT_EQ(stats.totalDelayUsec, 12000);
+    EXPECT_EQ(stats.maxDelayUsec, 10000);
+
+    stats = policy.takeStats();
+    EXPECT_EQ(stats.flushes, 0);
+    EXPECT_EQ(stats.ops, 0);
+}
+
+TEST(flushpolicy, limit_of_one_flushes_every_round)
+{
+    FlushPolicy policy(1, chrono::milliseconds(10));
+    auto now = Clock::now();
+
+    policy.add(0, now);
+    EXPECT_FALSE(policy.due(false, now));
+
+    policy.add(1, now);
+    EXPECT_TRUE(policy.due(false, now));
+}
+
+/* 100k single entry events back to back, each round seeing the next one ready */
+TEST(flushpolicy, busy_loop_flush_count)
+{
+    FlushPolicy policy(DEFAULT_FLUSH_MAX_OPS, chrono::milliseconds(DEFAULT_FLUSH_MAX_DELAY_MSECS));
+    auto now = Clock::now();
+    const int events = 100000;
+
+    for (int i = 0; i < events; i++)
+    {
+        /* 5 us per event */
+        now += chrono::microseconds(5);
+        policy.add(1, now);
+
+        if (policy.due(i == events - 1, now))
+        {
+            policy.flushed(now);
+        }
+    }
+
+    FlushPolicy::Stats stats = policy.takeStats();
+    EXPECT_EQ(stats.ops, events);
+    EXPECT_EQ(stats.flushes, (events + DEFAULT_FLUSH_MAX_OPS - 1) / DEFAULT_FLUSH_MAX_OPS);
+    EXPECT_LE(stats.maxDelayUsec, DEFAULT_FLUSH_MAX_DELAY_MSECS * 1000);
+}
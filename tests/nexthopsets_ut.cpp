@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <iostream>
+#include <map>
+#include <string>
+#include "ipprefix.h"
+#include "nexthopsets.h"
+
+using namespace std;
+using namespace swss;
+
+namespace {
+
+/* Resident set size of this process in bytes */
+size_t getRss()
+{
+    size_t pages = 0;
+    size_t resident = 0;
+
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (f)
+    {
+        if (fscanf(f, "%zu %zu", &pages, &resident) != 2)
+        {
+            resident = 0;
+        }
+        fclose(f);
+    }
+
+    return resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+IpPrefix routePrefix(int i)
+{
+    char dst[32];
+    snprintf(dst, sizeof(dst), "%d.%d.%d.0/24", 20 + (i >> 16), (i >> 8) & 0xff, i & 0xff);
+    return IpPrefix(dst);
+}
+
+/* One of 'sets' distinct 4-way ECMP sets */
+IpAddresses routeNextHops(int i, int sets)
+{
+    int base = (i % sets) * 4;
+    string nhs;
+
+    for (int j = 0; j < 4; j++)
+    {
+        nhs += (j ? "," : "") + string("10.") + to_string((base + j) >> 8) + "." + to_string((base + j) & 0xff) + ".1";
+    }
+
+    return IpAddresses(nhs);
+}
+
+}
+
+TEST(nexthopsets, equal_sets_share_a_handle)
+{
+    NextHopSetTable table;
+
+    NextHopSetId a = table.intern(IpAddresses("10.0.0.1,10.0.0.3"));
+    NextHopSetId b = table.intern(IpAddresses("10.0.0.3,10.0.0.1"));
+    NextHopSetId c = table.intern(IpAddresses("10.0.0.1"));
+
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_NE(a, EMPTY_NEXTHOP_SET);
+    EXPECT_EQ(table.size(), 3u);
+
+    EXPECT_EQ(table.getSize(a), 2u);
+    EXPECT_EQ(table.get(a), IpAddresses("10.0.0.1,10.0.0.3"));
+    EXPECT_EQ(table.getSize(c), 1u);
+    EXPECT_EQ(table.getNextHop(c), IpAddress("10.0.0.1"));
+}
+
+TEST(nexthopsets, empty_set_is_pinned)
+{
+    NextHopSetTable table;
+
+    EXPECT_EQ(table.intern(IpAddresses()), EMPTY_NEXTHOP_SET);
+    table.release(EMPTY_NEXTHOP_SET);
+    table.release(EMPTY_NEXTHOP_SET);
+
+    EXPECT_EQ(table.getSize(EMPTY_NEXTHOP_SET), 0u);
+    EXPECT_EQ(table.size(), 1u);
+}
+
+TEST(nexthopsets, released_sets_are_dropped_and_reused)
+{
+    NextHopSetTable table;
+    IpAddresses nhs("10.0.0.1,10.0.0.3");
+
+    NextHopSetId a = table.intern(nhs);
+    table.retain(a);
+
+    table.release(a);
+    NextHopSetId found;
+    EXPECT_TRUE(table.find(nhs, found));
+    EXPECT_EQ(found, a);
+
+    table.release(a);
+    EXPECT_FALSE(table.find(nhs, found));
+    EXPECT_EQ(table.size(), 1u);
+
+    NextHopSetId b = table.intern(IpAddresses("10.0.0.5"));
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(table.getNextHop(b), IpAddress("10.0.0.5"));
+}
+
+/*
+ * Memory used by a route table keeping an interned handle per route versus
+ * one keeping a copy of its next hops per route, for a full table sized
+ * number of routes over a few thousand distinct ECMP sets. Both tables are
+ * kept alive so the second one can't reuse memory freed by the first.
+ */
+TEST(nexthopsets, benchmark_route_table_rss)
+{
+    const int routes = 800000;
+    const int sets = 2000;
+
+    NextHopSetTable table;
+    map<IpPrefix, NextHopSetId> interned;
+    map<IpPrefix, IpAddresses> copies;
+
+    size_t base = getRss();
+    for (int i = 0; i < routes; i++)
+    {
+        interned.emplace(routePrefix(i), table.intern(routeNextHops(i, sets)));
+    }
+    size_t internedRss = getRss() - base;
+
+    base = getRss();
+    for (int i = 0; i < routes; i++)
+    {
+        copies.emplace(routePrefix(i), routeNextHops(i, sets));
+    }
+    size_t copiesRss = getRss() - base;
+
+    EXPECT_EQ(interned.size(), (size_t)routes);
+    EXPECT_EQ(copies.size(), (size_t)routes);
+    EXPECT_EQ(table.size(), (size_t)sets + 1);
+
+    cout << "Route table of " << routes << " routes over " << sets << " next hop sets: "
+         << copiesRss / 1024 << " KB RSS with per route copies, "
+         << internedRss / 1024 << " KB RSS with interned sets" << endl;
+}
@@ -0,0 +1,483 @@
+#include <gtest/gtest.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include "orchscheduler.h"
+
+using namespace std;
+using namespace swss;
+
+namespace {
+
+typedef chrono::steady_clock Clock;
+
+/* Selectable over an eventfd, kept ready by its executor while it has work */
+class EventSelectable : public Selectable
+{
+public:
+    EventSelectable(int pri, const bool &pending) :
+        Selectable(pri),
+        m_fd(eventfd(0, EFD_NONBLOCK)),
+        m_pending(pending)
+    {
+    }
+
+    ~EventSelectable() { close(m_fd); }
+
+    int getFd() override { return m_fd; }
+
+    void readData() override
+    {
+        uint64_t value;
+        if (read(m_fd, &value, sizeof(value)) != sizeof(value))
+        {
+            value = 0;
+        }
+    }
+
+    bool hasCachedData() override { return m_pending; }
+    bool initializedWithData() override { return m_pending; }
+
+    void notify()
+    {
+        uint64_t value = 1;
+        if (write(m_fd, &value, sizeof(value)) != sizeof(value))
+        {
+            value = 0;
+        }
+    }
+
+private:
+    int m_fd;
+    const bool &m_pending;
+};
+
+/* Table consumer popping up to a batch of entries costing 'cost' each */
+class BacklogExecutor : public Executor
+{
+public:
+    BacklogExecutor(const string &name, int pri, size_t batch, chrono::nanoseconds cost) :
+        Executor(new EventSelectable(pri, m_hasPending), nullptr, name),
+        m_batch(batch),
+        m_cost(cost)
+    {
+    }
+
+    void add(size_t entries)
+    {
+        m_pending += entries;
+        m_hasPending = m_pending > 0;
+        static_cast<EventSelectable *>(getSelectable())->notify();
+    }
+
+    /* Called on every execute(), before taking entries in */
+    void setHook(function<void()> hook) { m_hook = hook; }
+
+    void execute() override
+    {
+        if (m_hook)
+        {
+            m_hook();
+        }
+
+        m_executed = min(m_pending, min(m_batch, m_budget));
+        m_budget = SIZE_MAX;
+
+        auto end = Clock::now() + m_cost * m_executed;
+        while (Clock::now() < end)
+        {
+        }
+
+        m_pending -= m_executed;
+        m_hasPending = m_pending > 0;
+    }
+
+    void setBudget(size_t entries) override { m_budget = entries; }
+    size_t getExecuted() const override { return m_executed; }
+    bool hasBacklog() const override { return m_hasPending; }
+
+    size_t pending() const { return m_pending; }
+
+private:
+    size_t m_batch;
+    chrono::nanoseconds m_cost;
+    size_t m_pending = 0;
+    bool m_hasPending = false;
+    size_t m_budget = SIZE_MAX;
+    size_t m_executed = 0;
+    function<void()> m_hook;
+};
+
+/*
+ * Table consumer taking entries in by pop batches of 'chunk', like Consumer
+ * does: as many as fit in its budget, but always at least one.
+ */
+class ChunkExecutor : public Executor
+{
+public:
+    ChunkExecutor(const string &name, int pri, size_t chunk) :
+        Executor(new EventSelectable(pri, m_hasPending), nullptr, name),
+        m_chunk(chunk)
+    {
+    }
+
+    void add(size_t entries)
+    {
+        m_pending += entries;
+        m_hasPending = m_pending > 0;
+        static_cast<EventSelectable *>(getSelectable())->notify();
+    }
+
+    void execute() override
+    {
+        size_t limit = min(m_budget, m_pending);
+
+        m_executed = m_chunk;
+        while (m_executed + m_chunk <= limit)
+        {
+            m_executed += m_chunk;
+        }
+        m_executed = min(m_executed, m_pending);
+        m_budget = SIZE_MAX;
+
+        m_pending -= m_executed;
+        m_hasPending = m_pending > 0;
+        m_taken += m_executed;
+    }
+
+    void setBudget(size_t entries) override { m_budget = entries; }
+    size_t getExecuted() const override { return m_executed; }
+    bool hasBacklog() const override { return m_hasPending; }
+
+    size_t taken() const { return m_taken; }
+
+private:
+    size_t m_chunk;
+    size_t m_pending = 0;
+    bool m_hasPending = false;
+    size_t m_budget = SIZE_MAX;
+    size_t m_executed = 0;
+    size_t m_taken = 0;
+};
+
+/* Consumer of time stamped events, recording how long they waited */
+class EventExecutor : public Executor
+{
+public:
+    EventExecutor(const string &name, int pri) :
+        Executor(new EventSelectable(pri, m_hasPending), nullptr, name)
+    {
+    }
+
+    void post()
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_events.push_back(Clock::now());
+        static_cast<EventSelectable *>(getSelectable())->notify();
+    }
+
+    void execute() override
+    {
+        lock_guard<mutex> lock(m_mutex);
+        auto now = Clock::now();
+
+        for (auto posted : m_events)
+        {
+            m_maxLatency = max(m_maxLatency, now - posted);
+            m_handled++;
+        }
+        m_events.clear();
+    }
+
+    chrono::microseconds maxLatency() const
+    {
+        return chrono::duration_cast<chrono::microseconds>(m_maxLatency);
+    }
+
+    size_t handled() const { return m_handled; }
+
+private:
+    mutex m_mutex;
+    deque<Clock::time_point> m_events;
+    bool m_hasPending = false;
+    Clock::duration m_maxLatency = Clock::duration(0);
+    size_t m_handled = 0;
+};
+
+struct LoopResult
+{
+    chrono::microseconds portLatency;
+    chrono::microseconds lowPriorityLatency;
+    double elapsed;
+};
+
+enum LoopMode
+{
+    SELECT_LOOP_UNPRIORITIZED,  // before executors took their table priority
+    SELECT_LOOP,
+    SCHEDULER,
+};
+
+/*
+ * Inject 1M routes at once, while port and priority 0 table events keep
+ * coming every millisecond, and run the event loop until all are handled.
+ */
+LoopResult runRouteFlood(LoopMode mode)
+{
+    const size_t routes = 1000000;
+    const int events = 100;
+    bool prioritized = mode != SELECT_LOOP_UNPRIORITIZED;
+
+    /* Route turns of about 1 ms: 1024 entries of 1 us */
+    BacklogExecutor route("ROUTE_TABLE", prioritized ? 5 : 0, 1024, chrono::microseconds(1));
+    EventExecutor port("PORT_TABLE", prioritized ? 45 : 0);
+    EventExecutor low("SWITCH_TABLE", 0);
+    Select select;
+    OrchScheduler scheduler(&select);
+
+    if (mode == SCHEDULER)
+    {
+        scheduler.addSelectables({ &route, &port, &low });
+    }
+    else
+    {
+        select.addSelectables({ &route, &port, &low });
+    }
+
+    auto start = Clock::now();
+    route.add(routes);
+
+    atomic<bool> injecting(true);
+    thread injector([&]()
+    {
+        for (int i = 0; i < events; i++)
+        {
+            this_thread::sleep_for(chrono::milliseconds(1));
+            port.post();
+            low.post();
+        }
+        injecting = false;
+    });
+
+    while (injecting || route.pending() || port.handled() < events || low.handled() < events)
+    {
+        if (mode == SCHEDULER)
+        {
+            if (scheduler.wait(10) == Select::OBJECT)
+            {
+                scheduler.runRound();
+            }
+            continue;
+        }
+
+        Selectable *s;
+        if (select.select(&s, 10) == Select::OBJECT)
+        {
+            static_cast<Executor *>(s)->execute();
+        }
+    }
+    chrono::duration<double> elapsed = Clock::now() - start;
+
+    injector.join();
+
+    return { port.maxLatency(), low.maxLatency(), elapsed.count() };
+}
+
+void printRouteFlood(const string &loop, const LoopResult &result)
+{
+    cout << loop << ": port events " << result.portLatency.count() << " us, priority 0 events "
+         << result.lowPriorityLatency.count() << " us worst case, 1M routes in "
+         << result.elapsed << " s" << endl;
+}
+
+}
+
+TEST(orchscheduler, weights_follow_priorities)
+{
+    EXPECT_EQ(OrchScheduler::weight(0), 1);
+    EXPECT_EQ(OrchScheduler::weight(-1), 1);
+    EXPECT_EQ(OrchScheduler::weight(5), 2);
+    EXPECT_EQ(OrchScheduler::weight(45), 10);
+}
+
+TEST(orchscheduler, shares_rounds_by_weight)
+{
+    /* Free entries, so only the budgets matter */
+    BacklogExecutor high("high", 45, SIZE_MAX, chrono::nanoseconds(0));
+    BacklogExecutor low("low", 0, SIZE_MAX, chrono::nanoseconds(0));
+    Select select;
+    OrchScheduler scheduler(&select, chrono::milliseconds(1000), 10);
+
+    scheduler.addSelectables({ &high, &low });
+    high.add(100000);
+    low.add(100000);
+
+    ASSERT_EQ(scheduler.wait(1000), Select::OBJECT);
+    EXPECT_EQ(scheduler.queued(), 2);
+
+    for (int i = 0; i < 10; i++)
+    {
+        scheduler.runRound();
+    }
+
+    /* Both stay backlogged, served 10 to 1 */
+    EXPECT_EQ(100000 - high.pending(), 10 * 100);
+    EXPECT_EQ(100000 - low.pending(), 10 * 10);
+    EXPECT_EQ(scheduler.queued(), 2);
+}
+
+TEST(orchscheduler, caught_up_executors_go_back_to_select)
+{
+    BacklogExecutor table("table", 0, SIZE_MAX, chrono::nanoseconds(0));
+    Select select;
+    OrchScheduler scheduler(&select);
+
+    scheduler.addSelectables({ &table });
+    EXPECT_EQ(scheduler.wait(0), Select::TIMEOUT);
+
+    /* Alone, an executor isn't held to a budget */
+    table.add(100000);
+    ASSERT_EQ(scheduler.wait(1000), Select::OBJECT);
+    scheduler.runRound();
+    EXPECT_EQ(table.pending(), 0);
+    EXPECT_EQ(scheduler.queued(), 0);
+
+    EXPECT_EQ(scheduler.wait(0), Select::TIMEOUT);
+
+    table.add(1);
+    ASSERT_EQ(scheduler.wait(1000), Select::OBJECT);
+    scheduler.runRound();
+    EXPECT_EQ(table.pending(), 0);
+}
+
+TEST(orchscheduler, defers_executors_past_round_budget)
+{
+    /* Each turn outlasts the round budget */
+    BacklogExecutor high("high", 45, 10, chrono::milliseconds(1));
+    BacklogExecutor low("low", 0, 10, chrono::milliseconds(1));
+    Select select;
+    OrchScheduler scheduler(&select, chrono::milliseconds(5), 10);
+
+    scheduler.addSelectables({ &high, &low });
+    high.add(1000);
+    low.add(1000);
+    ASSERT_EQ(scheduler.wait(1000), Select::OBJECT);
+
+    /* The first round runs out of time before serving the low priority table */
+    scheduler.runRound();
+    EXPECT_EQ(high.pending(), 990);
+    EXPECT_EQ(low.pending(), 1000);
+
+    /* Which goes next time, whatever the time spent */
+    scheduler.runRound();
+    EXPECT_EQ(high.pending(), 980);
+    EXPECT_EQ(low.pending(), 990);
+}
+
+TEST(orchscheduler, weights_hold_with_pop_batches)
+{
+    /* Consumers pop by 128 entries, more than the budget of a weight 1 table */
+    ChunkExecutor port("PORT_TABLE", 45, 128);
+    ChunkExecutor route("ROUTE_TABLE", 5, 128);
+    ChunkExecutor low("SWITCH_TABLE", 0, 128);
+    Select select;
+    OrchScheduler scheduler(&select, chrono::milliseconds(1000), 64);
+
+    scheduler.addSelectables({ &port, &route, &low });
+    port.add(1000000);
+    route.add(1000000);
+    low.add(1000000);
+    ASSERT_EQ(scheduler.wait(1000), Select::OBJECT);
+
+    for (int i = 0; i < 20; i++)
+    {
+        scheduler.runRound();
+    }
+
+    /* 640, 128 and 64 entries per round, the last one as 128 every other round */
+    EXPECT_EQ(port.taken(), 20 * 640);
+    EXPECT_EQ(route.taken(), 20 * 128);
+    EXPECT_EQ(low.taken(), 10 * 128);
+}
+
+TEST(orchscheduler, overspend_is_paid_back)
+{
+    ChunkExecutor big("big", 0, 1000);
+    ChunkExecutor small("small", 0, 10);
+    Select select;
+    OrchScheduler scheduler(&select, chrono::milliseconds(1000), 100);
+
+    scheduler.addSelectables({ &big, &small });
+    big.add(1000000);
+    small.add(1000000);
+    ASSERT_EQ(scheduler.wait(1000), Select::OBJECT);
+
+    for (int i = 0; i < 100; i++)
+    {
+        scheduler.runRound();
+    }
+
+    /* Same weight, same share, whatever the pop batch */
+    EXPECT_EQ(small.taken(), 100 * 100);
+    EXPECT_EQ(big.taken(), 10 * 1000);
+}
+
+/*
+ * Order of the turns while routes flood in, with port and priority 0 table
+ * events arriving during every route turn.
+ */
+TEST(orchscheduler, bounds_wait_during_route_flood)
+{
+    BacklogExecutor route("ROUTE_TABLE", 5, 1024, chrono::nanoseconds(0));
+    BacklogExecutor port("PORT_TABLE", 45, SIZE_MAX, chrono::nanoseconds(0));
+    BacklogExecutor low("SWITCH_TABLE", 0, SIZE_MAX, chrono::nanoseconds(0));
+    Select select;
+    OrchScheduler scheduler(&select, chrono::milliseconds(1000));
+    string trace;
+
+    route.setHook([&]() { trace += 'R'; port.add(1); low.add(1); });
+    port.setHook([&]() { trace += 'P'; });
+    low.setHook([&]() { trace += 'L'; });
+
+    scheduler.addSelectables({ &route, &port, &low });
+    route.add(1000000);
+
+    for (int i = 0; i < 50; i++)
+    {
+        ASSERT_EQ(scheduler.wait(1000), Select::OBJECT);
+        scheduler.runRound();
+    }
+
+    /* A port event waits for the turn in progress only */
+    EXPECT_EQ(trace.find("RR"), string::npos);
+    EXPECT_EQ(trace.find("RLR"), string::npos);
+    /* A priority 0 event for one round */
+    EXPECT_EQ(trace.find("RPRPR"), string::npos);
+    EXPECT_GE(count(trace.begin(), trace.end(), 'R'), 50);
+}
+
+/*
+ * Worst case latency of port and priority 0 table events during a 1M route
+ * injection: with the Select loop as it was, all executors at priority 0,
+ * with the Select loop once executors take their table priority, and with
+ * the scheduler. Wall clock measurements, printed only.
+ */
+TEST(orchscheduler, benchmark_route_flood_latency)
+{
+    LoopResult unprioritized = runRouteFlood(SELECT_LOOP_UNPRIORITIZED);
+    LoopResult prioritized = runRouteFlood(SELECT_LOOP);
+    LoopResult scheduled = runRouteFlood(SCHEDULER);
+
+    printRouteFlood("Select loop, priority 0", unprioritized);
+    printRouteFlood("Select loop, priorities", prioritized);
+    printRouteFlood("Scheduler", scheduled);
+
+    EXPECT_GT(scheduled.elapsed, 0);
+}
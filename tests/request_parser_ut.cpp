@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
@@ -1297,3 +1299,174 @@ TEST(request_parser, wrong_key_ip_prefix)
         FAIL() << "Expected std::logic_error, not other exception";
     }
 }
+
+TEST(request_parser, attrs_cleared_between_requests)
+{
+    KeyOpFieldsValuesTuple t1 {"Ethernet1:10.1.1.1/24", "SET",
+                                 {
+                                     { "ip", "20.1.1.1" },
+                                 }
+                             };
+    KeyOpFieldsValuesTuple t2 {"Ethernet2:10.1.2.1/24", "SET",
+                                 {
+                                     { "empty", "empty" },
+                                 }
+                             };
+
+    TestRequest7 request;
+
+    EXPECT_NO_THROW(request.parse(t1));
+    EXPECT_EQ(request.getAttrIP("ip"), IpAddress("20.1.1.1"));
+    EXPECT_NO_THROW(request.clear());
+
+    EXPECT_NO_THROW(request.parse(t2));
+    EXPECT_STREQ(request.getKeyString(0).c_str(), "Ethernet2");
+    EXPECT_EQ(request.getAttrFieldNames(), std::unordered_set<std::string>());
+    EXPECT_THROW(request.getAttrIP("ip"), std::out_of_range);
+    EXPECT_THROW(request.getAttrString("ip"), std::out_of_range);
+    EXPECT_THROW(request.getAttrString("unknown"), std::out_of_range);
+    EXPECT_THROW(request.getKeyString(1), std::out_of_range);
+}
+
+TEST(request_parser, attr_fields)
+{
+    KeyOpFieldsValuesTuple t {"key1", "SET",
+                                 {
+                                     { "v6", "true" },
+                                     { "src_mac", "02:03:04:05:06:07" },
+                                     { "nlist", "name1,name2" },
+                                 }
+                             };
+
+    TestRequest1 request;
+
+    EXPECT_NO_THROW(request.parse(t));
+
+    std::vector<std::string> names;
+    std::vector<request_types_t> types;
+    for (const auto& field: request.getAttrFields())
+    {
+        names.push_back(field.name);
+        types.push_back(field.type);
+    }
+
+    /* In the order they were parsed */
+    EXPECT_EQ(names, (std::vector<std::string>{ "v6", "src_mac", "nlist" }));
+    EXPECT_EQ(types, (std::vector<request_types_t>{ REQ_T_BOOL, REQ_T_MAC_ADDRESS, REQ_T_SET }));
+    EXPECT_EQ(request.getAttrFields().size(), 3);
+
+    EXPECT_TRUE(request.hasAttr("v6"));
+    EXPECT_FALSE(request.hasAttr("v4"));
+    EXPECT_FALSE(request.hasAttr("unknown"));
+
+    request.clear();
+    KeyOpFieldsValuesTuple t2 {"key2", "DEL", { } };
+    EXPECT_NO_THROW(request.parse(t2));
+    EXPECT_EQ(request.getAttrFields().size(), 0);
+    EXPECT_FALSE(request.hasAttr("v6"));
+}
+
+namespace {
+
+/* Read every attribute of 'request' with its typed getter, like orchs do */
+size_t readAttrs(const Request& request)
+{
+    size_t read = 0;
+
+    for (const auto& field: request.getAttrFields())
+    {
+        switch (field.type)
+        {
+            case REQ_T_BOOL:
+                read += request.getAttrBool(field.name);
+                break;
+            case REQ_T_STRING:
+                read += request.getAttrString(field.name).size();
+                break;
+            case REQ_T_MAC_ADDRESS:
+                read += request.getAttrMacAddress(field.name).getMac()[0];
+                break;
+            case REQ_T_PACKET_ACTION:
+                read += request.getAttrPacketAction(field.name);
+                break;
+            case REQ_T_IP:
+                read += request.getAttrIP(field.name).isV4();
+                break;
+            case REQ_T_VLAN:
+                read += request.getAttrVlan(field.name);
+                break;
+            case REQ_T_UINT:
+                read += request.getAttrUint(field.name);
+                break;
+            case REQ_T_SET:
+                read += request.getAttrSet(field.name).size();
+                break;
+            default:
+                break;
+        }
+    }
+
+    return read;
+}
+
+/*
+ * Parse 'request' 'rounds' times, reading all its attributes before clearing
+ * it, returns the throughput in requests/s
+ */
+double parseThroughput(Request& request, const KeyOpFieldsValuesTuple& t, int rounds)
+{
+    size_t read = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+    {
+        request.parse(t);
+        read += readAttrs(request);
+        request.clear();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_GT(read, 0);
+    return (double)rounds / elapsed.count();
+}
+
+}
+
+/*
+ * Parse throughput of requests shaped like VRF and VNet route entries, the
+ * way Orch2::doTask parses them and the orchs read them: one long lived
+ * Request per orch, parsed, walked through getAttrFields() and cleared per
+ * entry.
+ */
+TEST(request_parser, benchmark_parse)
+{
+    const int rounds = 200000;
+
+    KeyOpFieldsValuesTuple vrf {"Vrf_blue", "SET",
+                                   {
+                                       { "v4", "true" },
+                                       { "v6", "false" },
+                                       { "src_mac", "02:03:04:05:06:07" },
+                                       { "ttl_action", "copy" },
+                                       { "ip_opt_action", "drop" },
+                                       { "l3_mc_action", "log" },
+                                   }
+                               };
+    KeyOpFieldsValuesTuple route {"Ethernet1:10.1.1.1/24", "SET",
+                                     {
+                                         { "ip", "20.1.1.1" },
+                                     }
+                                 };
+
+    TestRequest1 vrf_request;
+    TestRequest7 route_request;
+
+    double vrf_rate = parseThroughput(vrf_request, vrf, rounds);
+    double route_rate = parseThroughput(route_request, route, rounds);
+
+    EXPECT_GT(vrf_rate, 0);
+    EXPECT_GT(route_rate, 0);
+
+    std::cout << "Request parser: " << (size_t)vrf_rate << " VRF requests/s, "
+              << (size_t)route_rate << " route requests/s" << std::endl;
+}
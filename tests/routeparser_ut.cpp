@@ -0,0 +1,262 @@
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "fpmsyncd/fpm/fpm.h"
+#include "fpmsyncd/routeparser.h"
+
+using namespace std;
+using namespace swss;
+
+namespace {
+
+/* Minimal rtnetlink route message builder */
+class RouteMsgBuilder
+{
+public:
+    RouteMsgBuilder(uint16_t type, uint8_t family, uint8_t dstLen)
+        : m_buf(NLMSG_SPACE(sizeof(struct rtmsg)), 0)
+    {
+        nlmsghdr *hdr = header();
+        hdr->nlmsg_type = type;
+
+        struct rtmsg *rtm = (struct rtmsg *)NLMSG_DATA(hdr);
+        rtm->rtm_family = family;
+        rtm->rtm_dst_len = dstLen;
+        rtm->rtm_table = RT_TABLE_UNSPEC;
+        rtm->rtm_type = RTN_UNICAST;
+
+        m_family = family;
+    }
+
+    RouteMsgBuilder &addr(uint16_t attr, const char *ip)
+    {
+        unsigned char bin[16];
+        inet_pton(m_family, ip, bin);
+        append(attr, bin, m_family == AF_INET ? 4 : 16);
+        return *this;
+    }
+
+    RouteMsgBuilder &oif(uint32_t ifindex)
+    {
+        append(RTA_OIF, &ifindex, sizeof(ifindex));
+        return *this;
+    }
+
+    /* RTA_MULTIPATH made of (gateway, ifindex) pairs */
+    RouteMsgBuilder &multipath(const vector<pair<string, int>> &nhs)
+    {
+        vector<char> payload;
+        size_t addrLen = (m_family == AF_INET) ? 4 : 16;
+
+        for (const auto &nh : nhs)
+        {
+            size_t off = payload.size();
+            size_t len = RTNH_LENGTH(RTA_LENGTH(addrLen));
+            payload.resize(off + RTNH_ALIGN(len), 0);
+
+            struct rtnexthop *rtnh = (struct rtnexthop *)&payload[off];
+            rtnh->rtnh_len = (unsigned short)len;
+            rtnh->rtnh_ifindex = nh.second;
+
+            struct rtattr *rta = RTNH_DATA(rtnh);
+            rta->rta_type = RTA_GATEWAY;
+            rta->rta_len = (unsigned short)RTA_LENGTH(addrLen);
+            inet_pton(m_family, nh.first.c_str(), RTA_DATA(rta));
+        }
+
+        append(RTA_MULTIPATH, payload.data(), payload.size());
+        return *this;
+    }
+
+    /* Wrap the netlink message into an FPM frame appended to 'stream' */
+    void appendFpm(vector<char> &stream)
+    {
+        header();
+
+        size_t off = stream.size();
+        size_t len = FPM_MSG_HDR_LEN + m_buf.size();
+        stream.resize(off + len, 0);
+
+        fpm_msg_hdr_t *hdr = (fpm_msg_hdr_t *)&stream[off];
+        hdr->version = FPM_PROTO_VERSION;
+        hdr->msg_type = FPM_MSG_TYPE_NETLINK;
+        hdr->msg_len = htons((uint16_t)len);
+        memcpy(&stream[off + FPM_MSG_HDR_LEN], m_buf.data(), m_buf.size());
+    }
+
+    const nlmsghdr *get()
+    {
+        return header();
+    }
+
+private:
+    nlmsghdr *header()
+    {
+        nlmsghdr *hdr = (nlmsghdr *)m_buf.data();
+        hdr->nlmsg_len = (uint32_t)m_buf.size();
+        return hdr;
+    }
+
+    void append(uint16_t type, const void *data, size_t len)
+    {
+        size_t off = m_buf.size();
+        m_buf.resize(off + RTA_SPACE(len), 0);
+
+        struct rtattr *rta = (struct rtattr *)&m_buf[off];
+        rta->rta_type = type;
+        rta->rta_len = (unsigned short)RTA_LENGTH(len);
+        memcpy(RTA_DATA(rta), data, len);
+    }
+
+    vector<char> m_buf;
+    uint8_t m_family;
+};
+
+/* Parse every netlink message of an FPM stream, returns the number of routes */
+size_t parseFpmStream(const vector<char> &stream, RouteRecord &route)
+{
+    size_t parsed = 0;
+    size_t pos = 0;
+
+    while (stream.size() - pos >= FPM_MSG_HDR_LEN)
+    {
+        const fpm_msg_hdr_t *hdr = (const fpm_msg_hdr_t *)&stream[pos];
+        size_t len = fpm_msg_len(hdr);
+
+        if (len < FPM_MSG_HDR_LEN || stream.size() - pos < len)
+        {
+            break;
+        }
+
+        if (hdr->msg_type == FPM_MSG_TYPE_NETLINK &&
+            parseRouteMsg((const nlmsghdr *)((const char *)hdr + FPM_MSG_HDR_LEN), route))
+        {
+            parsed++;
+        }
+
+        pos += len;
+    }
+
+    return parsed;
+}
+
+}
+
+TEST(routeparser, v4_single_nexthop)
+{
+    RouteMsgBuilder msg(RTM_NEWROUTE, AF_INET, 24);
+    msg.addr(RTA_DST, "10.1.2.0").addr(RTA_GATEWAY, "10.0.0.1").oif(5);
+
+    RouteRecord route;
+    ASSERT_TRUE(parseRouteMsg(msg.get(), route));
+
+    EXPECT_EQ(route.msgType, RTM_NEWROUTE);
+    EXPECT_EQ(route.family, AF_INET);
+    EXPECT_EQ(route.type, RTN_UNICAST);
+    EXPECT_EQ(route.table, (uint32_t)RT_TABLE_UNSPEC);
+    EXPECT_STREQ(route.dst, "10.1.2.0/24");
+    ASSERT_EQ(route.nexthops.size(), 1u);
+    EXPECT_STREQ(route.nexthops[0].gateway, "10.0.0.1");
+    EXPECT_EQ(route.nexthops[0].ifindex, 5u);
+}
+
+TEST(routeparser, v4_host_route_has_no_prefix_length)
+{
+    RouteMsgBuilder msg(RTM_DELROUTE, AF_INET, 32);
+    msg.addr(RTA_DST, "10.1.2.3");
+
+    RouteRecord route;
+    ASSERT_TRUE(parseRouteMsg(msg.get(), route));
+
+    EXPECT_EQ(route.msgType, RTM_DELROUTE);
+    EXPECT_STREQ(route.dst, "10.1.2.3");
+    EXPECT_TRUE(route.nexthops.empty());
+}
+
+TEST(routeparser, v6_multipath)
+{
+    RouteMsgBuilder msg(RTM_NEWROUTE, AF_INET6, 64);
+    msg.addr(RTA_DST, "2001:db8:1::").multipath({ { "fc00::1", 7 }, { "fc00::2", 8 } });
+
+    RouteRecord route;
+    ASSERT_TRUE(parseRouteMsg(msg.get(), route));
+
+    EXPECT_STREQ(route.dst, "2001:db8:1::/64");
+    ASSERT_EQ(route.nexthops.size(), 2u);
+    EXPECT_STREQ(route.nexthops[0].gateway, "fc00::1");
+    EXPECT_EQ(route.nexthops[0].ifindex, 7u);
+    EXPECT_STREQ(route.nexthops[1].gateway, "fc00::2");
+    EXPECT_EQ(route.nexthops[1].ifindex, 8u);
+}
+
+TEST(routeparser, default_route_falls_back)
+{
+    RouteMsgBuilder msg(RTM_NEWROUTE, AF_INET, 0);
+    msg.addr(RTA_GATEWAY, "10.0.0.1").oif(5);
+
+    RouteRecord route;
+    EXPECT_FALSE(parseRouteMsg(msg.get(), route));
+}
+
+TEST(routeparser, non_route_message_falls_back)
+{
+    RouteMsgBuilder msg(RTM_NEWLINK, AF_INET, 24);
+
+    RouteRecord route;
+    EXPECT_FALSE(parseRouteMsg(msg.get(), route));
+}
+
+/*
+ * Parse throughput over an FPM stream. Set FPM_STREAM_CAPTURE to the path of
+ * a raw capture of the fpmsyncd TCP stream to benchmark real traffic instead
+ * of the synthetic stream.
+ */
+TEST(routeparser, benchmark_fpm_stream)
+{
+    vector<char> stream;
+    const char *capture = getenv("FPM_STREAM_CAPTURE");
+
+    if (capture)
+    {
+        ifstream ifs(capture, ios::binary);
+        ASSERT_TRUE(ifs.good());
+        stream.assign(istreambuf_iterator<char>(ifs), istreambuf_iterator<char>());
+    }
+    else
+    {
+        const int routes = 100000;
+        char dst[INET_ADDRSTRLEN];
+
+        for (int i = 0; i < routes; i++)
+        {
+            snprintf(dst, sizeof(dst), "%d.%d.%d.0", 20 + (i >> 16), (i >> 8) & 0xff, i & 0xff);
+
+            RouteMsgBuilder msg(RTM_NEWROUTE, AF_INET, 24);
+            msg.addr(RTA_DST, dst).multipath({ { "10.0.0.1", 1 }, { "10.0.0.3", 2 },
+                                               { "10.0.0.5", 3 }, { "10.0.0.7", 4 } });
+            msg.appendFpm(stream);
+        }
+    }
+
+    RouteRecord route;
+    const int rounds = 10;
+    size_t parsed = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+    {
+        parsed += parseFpmStream(stream, route);
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    EXPECT_GT(parsed, 0u);
+
+    cout << "FPM route parser: " << parsed << " messages in " << elapsed.count()
+         << " s, " << (size_t)((double)parsed / elapsed.count()) << " messages/s" << endl;
+}
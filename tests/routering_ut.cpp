@@ -0,0 +1,345 @@
+#include <gtest/gtest.h>
+#include <signal.h>
+#include <unistd.h>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dbconnector.h"
+#include "consumerstatetable.h"
+#include "producerstatetable.h"
+#include "select.h"
+#include "fpmsyncd/routering.h"
+#include "fpmsyncd/routepersist.h"
+
+using namespace std;
+using namespace swss;
+
+namespace {
+
+const string testRingPath = "/tmp/routering_ut_" + to_string(getpid());
+
+string routeKey(size_t i)
+{
+    return "10." + to_string((i >> 16) & 0xff) + "." + to_string((i >> 8) & 0xff) + "." +
+           to_string(i & 0xff) + "/32";
+}
+
+vector<FieldValueTuple> routeFields(size_t i)
+{
+    return { { "nexthop", "10.0.0." + to_string(i % 64) + ",10.0.1." + to_string(i % 64) },
+             { "ifname", "Ethernet" + to_string((i % 32) * 4) + ",PortChannel0001" } };
+}
+
+}
+
+TEST(routering, encode_decode)
+{
+    vector<FieldValueTuple> fvs = { { "nexthop", "10.0.0.1,10.0.0.3" },
+                                    { "ifname", "Ethernet0,Ethernet4" } };
+    uint8_t buf[256];
+
+    size_t len = RouteRing::encode(buf, sizeof(buf), "192.168.0.0/24", SET_COMMAND, fvs);
+    ASSERT_EQ(len, RouteRing::encodedSize("192.168.0.0/24", SET_COMMAND, fvs));
+
+    KeyOpFieldsValuesTuple kco;
+    ASSERT_TRUE(RouteRing::decode(buf, len, kco));
+    EXPECT_EQ(kfvKey(kco), "192.168.0.0/24");
+    EXPECT_EQ(kfvOp(kco), SET_COMMAND);
+    EXPECT_EQ(kfvFieldsValues(kco), fvs);
+
+    /* Truncated records are rejected */
+    EXPECT_FALSE(RouteRing::decode(buf, len - 1, kco));
+    EXPECT_EQ(RouteRing::encode(buf, len - 1, "192.168.0.0/24", SET_COMMAND, fvs), 0);
+
+    len = RouteRing::encode(buf, sizeof(buf), "2001:db8::/64", DEL_COMMAND, {});
+    ASSERT_TRUE(RouteRing::decode(buf, len, kco));
+    EXPECT_EQ(kfvKey(kco), "2001:db8::/64");
+    EXPECT_EQ(kfvOp(kco), DEL_COMMAND);
+    EXPECT_TRUE(kfvFieldsValues(kco).empty());
+}
+
+TEST(routering, attach_needs_a_reader)
+{
+    RouteRingWriter writer(testRingPath);
+
+    EXPECT_FALSE(writer.attach());
+    EXPECT_FALSE(writer.push("10.0.0.0/8", DEL_COMMAND, {}));
+
+    RouteRingReader reader(testRingPath, 4096);
+    EXPECT_TRUE(writer.attach());
+    EXPECT_FALSE(writer.isStale());
+}
+
+TEST(routering, updates_are_delivered_in_order_across_wraps)
+{
+    RouteRingReader reader(testRingPath, 4096);
+    RouteRingWriter writer(testRingPath);
+    deque<KeyOpFieldsValuesTuple> entries;
+    size_t next = 0;
+
+    ASSERT_TRUE(writer.attach());
+
+    /* Records of varying length, so that the end of the ring gets skipped */
+    for (size_t i = 0; i < 2000; i++)
+    {
+        ASSERT_TRUE(writer.push(routeKey(i), i % 3 ? SET_COMMAND : DEL_COMMAND,
+                                i % 3 ? routeFields(i) : vector<FieldValueTuple>()));
+
+        if (i % 7 == 6)
+        {
+            writer.notify();
+            reader.readData();
+            EXPECT_TRUE(reader.hasCachedData());
+
+            reader.pops(entries);
+            EXPECT_TRUE(reader.empty());
+        }
+    }
+    reader.pops(entries);
+
+    ASSERT_EQ(entries.size(), 2000);
+    for (const auto &kco : entries)
+    {
+        EXPECT_EQ(kfvKey(kco), routeKey(next));
+        EXPECT_EQ(kfvOp(kco), next % 3 ? SET_COMMAND : DEL_COMMAND);
+        if (next % 3)
+        {
+            EXPECT_EQ(kfvFieldsValues(kco), routeFields(next));
+        }
+        next++;
+    }
+}
+
+TEST(routering, pops_honor_count)
+{
+    RouteRingReader reader(testRingPath, 4096);
+    RouteRingWriter writer(testRingPath);
+    deque<KeyOpFieldsValuesTuple> entries;
+
+    ASSERT_TRUE(writer.attach());
+    for (size_t i = 0; i < 10; i++)
+    {
+        ASSERT_TRUE(writer.push(routeKey(i), DEL_COMMAND, {}));
+    }
+
+    EXPECT_EQ(reader.pops(entries, 4), 4);
+    EXPECT_FALSE(reader.empty());
+    EXPECT_EQ(reader.pops(entries), 6);
+    EXPECT_TRUE(reader.empty());
+}
+
+TEST(routering, writer_notices_restarted_reader)
+{
+    signal(SIGPIPE, SIG_IGN);
+
+    RouteRingWriter writer(testRingPath);
+    {
+        RouteRingReader reader(testRingPath, 4096);
+        ASSERT_TRUE(writer.attach());
+        EXPECT_TRUE(writer.push("10.0.0.0/8", DEL_COMMAND, {}));
+    }
+
+    /* The reader is gone, and so is the ring it created */
+    EXPECT_TRUE(writer.isStale());
+    writer.notify();
+    EXPECT_FALSE(writer.push("10.0.0.0/8", DEL_COMMAND, {}));
+
+    RouteRingReader reader(testRingPath, 4096);
+    EXPECT_TRUE(writer.isStale());
+
+    writer.detach();
+    EXPECT_TRUE(writer.attach());
+    EXPECT_FALSE(writer.isStale());
+    EXPECT_TRUE(writer.push("10.0.0.0/8", DEL_COMMAND, {}));
+}
+
+namespace {
+
+/*
+ * Routes/s from fpmsyncd to orchagent over the route ring, in their own
+ * threads. With 'persister', routes are also persisted the way RouteSync
+ * does, and the figure covers them until written to APP_DB.
+ */
+double ringRate(size_t routes, size_t batch, RoutePersister *persister)
+{
+    RouteRingReader reader(testRingPath);
+    RouteRingWriter writer(testRingPath);
+    size_t received = 0;
+
+    EXPECT_TRUE(writer.attach());
+
+    auto start = chrono::steady_clock::now();
+    thread producer([&]()
+    {
+        for (size_t i = 0; i < routes; i++)
+        {
+            auto fvs = routeFields(i);
+
+            writer.push(routeKey(i), SET_COMMAND, fvs);
+            if (persister)
+            {
+                persister->set(routeKey(i), fvs);
+            }
+            if (i % batch == batch - 1)
+            {
+                writer.notify();
+            }
+        }
+        writer.notify();
+    });
+
+    Select s;
+    s.addSelectable(&reader);
+
+    while (received < routes)
+    {
+        Selectable *sel;
+        deque<KeyOpFieldsValuesTuple> entries;
+
+        if (s.select(&sel, 1000) != Select::OBJECT)
+        {
+            break;
+        }
+        received += reader.pops(entries, batch);
+    }
+    producer.join();
+    if (persister)
+    {
+        persister->flush();
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(received, routes);
+    return (double)received / elapsed.count();
+}
+
+}
+
+TEST(routering, persister_coalesces_updates)
+{
+    const string table = "ROUTE_PERSIST_UT_TABLE";
+
+    try
+    {
+        DBConnector db(APPL_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
+        Table check(&db, table);
+        vector<FieldValueTuple> fvs;
+
+        {
+            RoutePersister persister(&db, table);
+
+            persister.set("10.0.0.0/8", { { "nexthop", "1.1.1.1" } });
+            persister.set("10.0.0.0/8", { { "nexthop", "2.2.2.2" } });
+            persister.set("20.0.0.0/8", { { "nexthop", "3.3.3.3" } });
+            persister.del("20.0.0.0/8");
+            persister.flush();
+
+            ASSERT_TRUE(check.get("10.0.0.0/8", fvs));
+            EXPECT_EQ(fvs, (vector<FieldValueTuple>{ { "nexthop", "2.2.2.2" } }));
+            EXPECT_FALSE(check.get("20.0.0.0/8", fvs));
+
+            /* Written out on destruction too */
+            persister.del("10.0.0.0/8");
+        }
+
+        EXPECT_FALSE(check.get("10.0.0.0/8", fvs));
+    }
+    catch (const exception &e)
+    {
+        cout << "Route persister not tested: " << e.what() << endl;
+    }
+}
+
+/*
+ * End to end routes/s from producer to consumer, over the route ring and over
+ * ProducerStateTable/ConsumerStateTable, with the producer and the consumer
+ * in their own threads as fpmsyncd and orchagent would be. In ring mode,
+ * fpmsyncd still persists every route to APP_DB, so the ring is measured
+ * with those writes when a redis server is reachable, as is APP_DB.
+ */
+TEST(routering, benchmark_transports)
+{
+    const size_t routes = 200000;
+    const size_t batch = 128;
+
+    signal(SIGPIPE, SIG_IGN);
+
+    try
+    {
+        const string table = "ROUTE_RING_BENCH_TABLE";
+        DBConnector producerDb(APPL_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
+        DBConnector consumerDb(APPL_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
+        RedisPipeline pipeline(&producerDb);
+        Table cleanup(&pipeline, table, true);
+
+        double rate;
+        {
+            RoutePersister persister(&producerDb, table);
+            rate = ringRate(routes, batch, &persister);
+        }
+        cout << "Route ring, persisted to APP_DB: " << (size_t)rate << " routes/s" << endl;
+
+        for (size_t i = 0; i < routes; i++)
+        {
+            cleanup.del(routeKey(i));
+        }
+        pipeline.flush();
+
+        ProducerStateTable producerTable(&pipeline, table, true);
+        ConsumerStateTable consumerTable(&consumerDb, table, (int)batch);
+        size_t received = 0;
+
+        auto start = chrono::steady_clock::now();
+        thread producer([&]()
+        {
+            for (size_t i = 0; i < routes; i++)
+            {
+                producerTable.set(routeKey(i), routeFields(i));
+                if (i % batch == batch - 1)
+                {
+                    pipeline.flush();
+                }
+            }
+            pipeline.flush();
+        });
+
+        Select s;
+        s.addSelectable(&consumerTable);
+
+        while (received < routes)
+        {
+            Selectable *sel;
+            deque<KeyOpFieldsValuesTuple> entries;
+
+            if (s.select(&sel, 1000) != Select::OBJECT)
+            {
+                break;
+            }
+            consumerTable.pops(entries);
+            received += entries.size();
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        producer.join();
+
+        for (size_t i = 0; i < routes; i++)
+        {
+            cleanup.del(routeKey(i));
+        }
+        pipeline.flush();
+
+        EXPECT_EQ(received, routes);
+        cout << "APP_DB: " << received << " routes in " << elapsed.count() << " s, "
+             << (size_t)((double)received / elapsed.count()) << " routes/s" << endl;
+    }
+    catch (const exception &e)
+    {
+        /* Only the transport then, which leaves persistence out */
+        double rate = ringRate(routes, batch, nullptr);
+
+        cout << "APP_DB not measured: " << e.what() << endl;
+        cout << "Route ring, not persisted: " << (size_t)rate << " routes/s" << endl;
+    }
+}
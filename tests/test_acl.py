@@ -244,6 +244,53 @@ class TestAcl(object):
         (status, fvs) = atbl.get(acl_entry[0])
         assert status == False
 
+    def test_AclRuleUpdateInPlace(self, dvs, testlog):
+        """
+        hmset ACL_RULE|test|acl_test_rule priority 55 PACKET_ACTION FORWARD L4_SRC_PORT 65000
+        hmset ACL_RULE|test|acl_test_rule priority 66 PACKET_ACTION DROP L4_SRC_PORT 65001
+        """
+
+        db = swsscommon.DBConnector(4, dvs.redis_sock, 0)
+        adb = swsscommon.DBConnector(1, dvs.redis_sock, 0)
+
+        # create acl rule
+        tbl = swsscommon.Table(db, "ACL_RULE")
+        fvs = swsscommon.FieldValuePairs([("priority", "55"), ("PACKET_ACTION", "FORWARD"), ("L4_SRC_PORT", "65000")])
+        tbl.set("test|acl_test_rule", fvs)
+
+        time.sleep(1)
+
+        atbl = swsscommon.Table(adb, "ASIC_STATE:SAI_OBJECT_TYPE_ACL_ENTRY")
+        keys = atbl.getKeys()
+
+        acl_entry = [k for k in keys if k not in dvs.asicdb.default_acl_entries]
+        assert len(acl_entry) == 1
+
+        # update acl rule
+        fvs = swsscommon.FieldValuePairs([("priority", "66"), ("PACKET_ACTION", "DROP"), ("L4_SRC_PORT", "65001")])
+        tbl.set("test|acl_test_rule", fvs)
+
+        time.sleep(1)
+
+        # the same acl entry is updated rather than recreated
+        keys = atbl.getKeys()
+        assert [k for k in keys if k not in dvs.asicdb.default_acl_entries] == acl_entry
+
+        (status, fvs) = atbl.get(acl_entry[0])
+        assert status == True
+        fvs = dict(fvs)
+        assert fvs["SAI_ACL_ENTRY_ATTR_PRIORITY"] == "66"
+        assert fvs["SAI_ACL_ENTRY_ATTR_FIELD_L4_SRC_PORT"] == "65001&mask:0xffff"
+        assert fvs["SAI_ACL_ENTRY_ATTR_ACTION_PACKET_ACTION"] == "SAI_PACKET_ACTION_DROP"
+
+        # remove acl rule
+        tbl._del("test|acl_test_rule")
+
+        time.sleep(1)
+
+        (status, fvs) = atbl.get(acl_entry[0])
+        assert status == False
+
     def test_AclTableDeletion(self, dvs, testlog):
 
         db = swsscommon.DBConnector(4, dvs.redis_sock, 0)
@@ -102,6 +102,19 @@ def test_route_nhg(dvs, testlog):
 
         assert len(keys) == 2 - i
 
+        # next hop pruning for the port is reported in STATE_DB
+        sdb = swsscommon.DBConnector(6, dvs.redis_sock, 0)
+        stbl = swsscommon.Table(sdb, "PORT_NEXTHOP_TABLE")
+        (status, fvs) = stbl.get("Ethernet%d" % (i * 4))
+
+        assert status == True
+
+        fvs = dict(fvs)
+
+        assert fvs["oper_status"] == "down"
+        assert fvs["pruned_members"] == "1"
+        assert "latency_usec" in fvs
+
     # bring links up one-by-one
     for i in [0, 1, 2]:
         dvs.servers[i].runcmd("ip link set up dev eth0") == 0
@@ -132,3 +145,24 @@ def test_route_nhg(dvs, testlog):
             for v in fvs:
                 if v[0] == "SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID":
                     assert v[1] == nhgid
+
+    # change the ECMP set by one member at a time, the group is updated in place
+    for nexthops, ifnames in [("10.0.0.1,10.0.0.3", "Ethernet0,Ethernet4"),
+                              ("10.0.0.1,10.0.0.3,10.0.0.5", "Ethernet0,Ethernet4,Ethernet8")]:
+        fvs = swsscommon.FieldValuePairs([("nexthop", nexthops), ("ifname", ifnames)])
+        ps.set("2.2.2.0/24", fvs)
+
+        time.sleep(1)
+
+        assert nhgtbl.getKeys() == [nhgid]
+
+        keys = nhg_member_tbl.getKeys()
+
+        assert len(keys) == len(nexthops.split(","))
+
+        for k in keys:
+            (status, fvs) = nhg_member_tbl.get(k)
+
+            for v in fvs:
+                if v[0] == "SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID":
+                    assert v[1] == nhgid
@@ -40,3 +40,55 @@ def test_RouteAdd(dvs, testlog):
     rt_key = json.loads(addobjs[0]['key'])
 
     assert rt_key['dest'] == "2.2.2.0/24"
+
+def test_RouteResync(dvs, testlog):
+
+    config_db = swsscommon.DBConnector(swsscommon.CONFIG_DB, dvs.redis_sock, 0)
+    intf_tbl = swsscommon.Table(config_db, "INTERFACE")
+    fvs = swsscommon.FieldValuePairs([("NULL","NULL")])
+    intf_tbl.set("Ethernet0|10.0.0.0/31", fvs)
+    dvs.runcmd("ifconfig Ethernet0 up")
+
+    dvs.servers[0].runcmd("ifconfig eth0 10.0.0.1/31")
+    dvs.servers[0].runcmd("ping -c 1 10.0.0.0")
+
+    db = swsscommon.DBConnector(0, dvs.redis_sock, 0)
+    ps = swsscommon.ProducerStateTable(db, "ROUTE_TABLE")
+    fvs = swsscommon.FieldValuePairs([("nexthop","10.0.0.1"), ("ifname", "Ethernet0")])
+
+    ps.set("3.3.3.0/24", fvs)
+    ps.set("4.4.4.0/24", fvs)
+    time.sleep(1)
+
+    adb = swsscommon.DBConnector(1, dvs.redis_sock, 0)
+    tbl = swsscommon.Table(adb, "ASIC_STATE:SAI_OBJECT_TYPE_ROUTE_ENTRY")
+
+    def asic_routes():
+        return [json.loads(k)['dest'] for k in tbl.getKeys()]
+
+    assert "3.3.3.0/24" in asic_routes()
+    assert "4.4.4.0/24" in asic_routes()
+
+    # only 3.3.3.0/24 is refreshed during the resync
+    dvs.runcmd("routeresync start")
+    time.sleep(1)
+    ps.set("3.3.3.0/24", fvs)
+    ps.set("5.5.5.0/24", fvs)
+    time.sleep(1)
+
+    # route updates are not held back by the resync
+    assert "5.5.5.0/24" in asic_routes()
+    assert "4.4.4.0/24" in asic_routes()
+
+    dvs.runcmd("routeresync stop")
+    time.sleep(1)
+
+    routes = asic_routes()
+    assert "3.3.3.0/24" in routes
+    assert "5.5.5.0/24" in routes
+    assert "4.4.4.0/24" not in routes
+
+    ps._del("3.3.3.0/24")
+    ps._del("5.5.5.0/24")
+    intf_tbl._del("Ethernet0|10.0.0.0/31")
+    time.sleep(1)
@@ -496,6 +496,15 @@ def test_swss_neighbor_syncup(dvs, testlog):
     # check restore Count
     swss_app_check_RestoreCount_single(state_db, restore_count, "neighsyncd")
 
+    # check all neighbor entries were streamed into the restoration cache
+    warmtbl = swsscommon.Table(state_db, swsscommon.STATE_WARM_RESTART_TABLE_NAME)
+    (status, fvs) = warmtbl.get("neighsyncd")
+    assert status == True
+    stats = dict(fvs)
+    assert int(stats["restored_entries"]) >= len(ips) + len(v6ips)
+    assert "restore_time_ms" in stats
+    assert int(stats["restore_cache_bytes"]) > 0
+
     #
     # Testcase 3:
     # stop neighsyncd, delete even nummber ipv4/ipv6 neighbor entries from each interface, warm start neighsyncd.
@@ -3,6 +3,7 @@
 #include "schema.h"
 #include "warm_restart.h"
 #include "warmRestartAssist.h"
+#include "warmRestartLoader.h"
 
 using namespace std;
 using namespace swss;
@@ -19,6 +20,7 @@ const AppRestartAssist::cache_state_map AppRestartAssist::cacheStateMap =
 AppRestartAssist::AppRestartAssist(RedisPipeline *pipeline,
     const std::string &appName, const std::string &dockerName,
     ProducerStateTable *psTable, const uint32_t defaultWarmStartTimerValue):
+    m_pipeline(pipeline),
     m_appTable(pipeline, APP_NEIGH_TABLE_NAME, false),
     m_appName(appName),
     m_dockerName(dockerName),
@@ -87,70 +89,42 @@ string AppRestartAssist::joinVectorString(const vector<FieldValueTuple> &fv)
     return s;
 }
 
-// Set the cache entry state
-void AppRestartAssist::setCacheEntryState(std::vector<FieldValueTuple> &fvVector,
-    cache_state_t state)
-{
-    fvVector.back().second = cacheStateMap.at(state);
-}
-
-// Get the cache entry state
-AppRestartAssist::cache_state_t AppRestartAssist::getCacheEntryState(const std::vector<FieldValueTuple> &fvVector)
-{
-    for (auto &iter : cacheStateMap)
-    {
-        if (fvVector.back().second == iter.second)
-        {
-            return iter.first;
-        }
-    }
-    throw std::logic_error("cache entry state is invalid");
-}
-
-// Read table from APPDB and append stale flag then insert to cachemap
+// Read table from APPDB and insert it to the restored cache marked as stale
 void AppRestartAssist::readTableToMap()
 {
-    vector<string> keys;
+    // loader talks to redis directly, so nothing can be left in the pipeline
+    m_pipeline->flush();
 
-    m_appTable.getKeys(keys);
-    FieldValueTuple state(CACHE_STATE_FIELD, "");
+    AppTableLoader loader(m_pipeline->getDBConnector(),
+            m_appTableName, m_appTable.getTableNameSeparator());
 
-    for (const auto &key: keys)
+    loader.load([this](const string &key, const vector<FieldValueTuple> &fv)
     {
-        vector<FieldValueTuple> fv;
-
-	    // if the fieldvalue is empty, skip
-        if (!m_appTable.get(key, fv))
-        {
-            continue;
-        }
+        SWSS_LOG_INFO("write to cachemap: %s, key: %s, "
+               "%s", m_appTableName.c_str(), key.c_str(), joinVectorString(fv).c_str());
 
-        fv.push_back(state);
-        setCacheEntryState(fv, STALE);
+        m_restoredCache.insert(key, fv, STALE);
+    });
 
-        string s = joinVectorString(fv);
+    AppTableLoader::publishRestoreStats(m_appName, m_restoredCache.size(),
+            loader.getLoadTime(), m_restoredCache.memoryUsage());
 
-        SWSS_LOG_INFO("write to cachemap: %s, key: %s, "
-               "%s", m_appTableName.c_str(), key.c_str(), s.c_str());
-
-        // insert to the cache map
-        appTableCacheMap[key] = fv;
-    }
     WarmStart::setWarmStartState(m_appName, WarmStart::RESTORED);
-    SWSS_LOG_NOTICE("Restored appDB table to internal cache map");
+    SWSS_LOG_NOTICE("Restored appDB table to internal cache map, %zu entries in %lu ms",
+            m_restoredCache.size(), loader.getLoadTime());
     return;
 }
 
 /*
  * Check and insert to CacheMap Logic:
  * if delete_key:
- *  mark the entry as "DELETE";
+ *  mark the restored entry as "DELETE" and drop any pending new value;
  * else:
- *  if key exist {
- *    if it has different value: update with "NEW" flag.
- *    if same value:  mark it as "SAME";
+ *  if key was restored {
+ *    if it has different value: queue the value with "NEW" flag.
+ *    if same value:  mark it as "SAME" and drop any pending new value;
  *  } else {
- *    insert with "NEW" flag.
+ *    queue the value with "NEW" flag.
  *   }
  */
 void AppRestartAssist::insertToMap(string key, vector<FieldValueTuple> fvVector, bool delete_key)
@@ -158,48 +132,37 @@ void AppRestartAssist::insertToMap(string key, vector<FieldValueTuple> fvVector,
     SWSS_LOG_INFO("Received message %s, key: %s, "
             "%s, delete = %d", m_appTableName.c_str(), key.c_str(), joinVectorString(fvVector).c_str(), delete_key);
 
-
-    auto found = appTableCacheMap.find(key);
+    bool restored = m_restoredCache.contains(key);
 
     if (delete_key)
     {
         SWSS_LOG_NOTICE("%s, delete key: %s, ", m_appTableName.c_str(), key.c_str());
-        /* mark it as DELETE if exist, otherwise, no-op */
-        if (found != appTableCacheMap.end())
+        /* mark it as DELETE if exist in appDB, otherwise, no-op */
+        if (restored)
         {
-            setCacheEntryState(found->second, DELETE);
+            m_restoredCache.setState(key, DELETE);
         }
+        appTableCacheMap.erase(key);
     }
-    else if (found != appTableCacheMap.end())
+    else if (restored && !m_restoredCache.differs(key, fvVector))
     {
-        // check only the original vector range (exclude cache-state field/value)
-        if(!equal(fvVector.begin(), fvVector.end(), found->second.begin()))
-        {
-            SWSS_LOG_NOTICE("%s, found key: %s, new value ", m_appTableName.c_str(), key.c_str());
+        SWSS_LOG_INFO("%s, found key: %s, same value", m_appTableName.c_str(), key.c_str());
 
-            FieldValueTuple state(CACHE_STATE_FIELD, "");
-            fvVector.push_back(state);
-
-            // mark as NEW flag
-            setCacheEntryState(fvVector, NEW);
-            appTableCacheMap[key] = fvVector;
-        }
-        else
-        {
-            SWSS_LOG_INFO("%s, found key: %s, same value", m_appTableName.c_str(), key.c_str());
-
-            // mark as SAME flag
-            setCacheEntryState(found->second, SAME);
-        }
+        // mark as SAME flag
+        m_restoredCache.setState(key, SAME);
+        appTableCacheMap.erase(key);
     }
     else
     {
-        // not found, mark the entry as NEW and insert to map
-        SWSS_LOG_NOTICE("%s, not found key: %s, new", m_appTableName.c_str(), key.c_str());
-        FieldValueTuple state(CACHE_STATE_FIELD, "");
-        fvVector.push_back(state);
-        setCacheEntryState(fvVector, NEW);
-        appTableCacheMap[key] = fvVector;
+        SWSS_LOG_NOTICE("%s, %s key: %s, new value", m_appTableName.c_str(),
+                restored ? "found" : "not found", key.c_str());
+
+        // mark as NEW flag
+        if (restored)
+        {
+            m_restoredCache.setState(key, NEW);
+        }
+        appTableCacheMap[key] = std::move(fvVector);
     }
 
     return;
@@ -207,50 +170,42 @@ void AppRestartAssist::insertToMap(string key, vector<FieldValueTuple> fvVector,
 
 /*
  * Reconcile logic:
- *  iterate throught the cache map
+ *  iterate throught the restored cache
  *  if the entry has "SAME" flag, do nothing
  *  if has "STALE/DELETE" flag, delete it from appDB.
- *  else if "NEW" flag,  add it to appDB
- *  else, throw (should never happen)
+ *  then add every "NEW" entry to appDB
  */
 void AppRestartAssist::reconcile()
 {
 
     SWSS_LOG_ENTER();
-    for (auto iter = appTableCacheMap.begin(); iter != appTableCacheMap.end(); ++iter )
+    m_restoredCache.forEach([this](const string &key, uint8_t state)
     {
-        string s = joinVectorString(iter->second);
-        auto state = getCacheEntryState(iter->second);
-
-        if (state == SAME)
+        if (state == STALE || state == DELETE)
         {
-            SWSS_LOG_INFO("%s SAME, key: %s, %s",
-                    m_appTableName.c_str(), iter->first.c_str(), s.c_str());
-            continue;
-        }
-        else if (state == STALE || state == DELETE)
-        {
-            SWSS_LOG_NOTICE("%s STALE/DELETE, key: %s, %s",
-                    m_appTableName.c_str(), iter->first.c_str(), s.c_str());
+            SWSS_LOG_NOTICE("%s %s, key: %s", m_appTableName.c_str(),
+                    cacheStateMap.at(static_cast<cache_state_t>(state)).c_str(), key.c_str());
 
             //delete from appDB
-            m_psTable->del(iter->first);
-        }
-        else if (state == NEW)
-        {
-            SWSS_LOG_NOTICE("%s NEW, key: %s, %s",
-                    m_appTableName.c_str(), iter->first.c_str(), s.c_str());
-
-            //add to appDB, exclude the state
-            iter->second.pop_back();
-            m_psTable->set(iter->first, iter->second);
+            m_psTable->del(key);
         }
-        else
+        else if (state != SAME && state != NEW)
         {
             throw std::logic_error("cache entry state is invalid");
         }
+    });
+
+    for (const auto &iter : appTableCacheMap)
+    {
+        SWSS_LOG_NOTICE("%s NEW, key: %s, %s",
+                m_appTableName.c_str(), iter.first.c_str(), joinVectorString(iter.second).c_str());
+
+        //add to appDB
+        m_psTable->set(iter.first, iter.second);
     }
-    // reconcile finished, clear the map, mark the warmstart state
+
+    // reconcile finished, clear the caches, mark the warmstart state
+    m_restoredCache.clear();
     appTableCacheMap.clear();
     WarmStart::setWarmStartState(m_appName, WarmStart::RECONCILED);
     m_warmStartInProgress = false;
@@ -8,6 +8,7 @@
 #include "producerstatetable.h"
 #include "selectabletimer.h"
 #include "select.h"
+#include "warmRestartCache.h"
 
 namespace swss {
 
@@ -88,7 +89,6 @@ private:
     typedef std::map<cache_state_t, std::string> cache_state_map;
     // Enum to string translation map
     static const cache_state_map cacheStateMap;
-    const std::string CACHE_STATE_FIELD = "cache-state";
 
     /*
      * Default timer to be 5 seconds
@@ -98,9 +98,13 @@ private:
     static const uint32_t DEFAULT_INTERNAL_TIMER_VALUE = 5;
     typedef std::unordered_map<std::string, std::vector<swss::FieldValueTuple>> AppTableMap;
 
-    // cache map to store temperary application table
+    // compact cache of the restored application table, tracks per-entry state
+    WarmStartCache m_restoredCache;
+
+    // cache map to store new/changed entries to be pushed at reconcile time
     AppTableMap appTableCacheMap;
 
+    RedisPipeline *m_pipeline;        // pipeline shared with producer state table
     Table m_appTable;                 // table handler
     std::string m_dockerName;         // docker name of the application
     std::string m_appName;            // application name
@@ -111,10 +115,7 @@ private:
     uint32_t m_reconcileTimer;        // reconcile timer value
     SelectableTimer m_warmStartTimer; // reconcile timer
 
-    // Set or get cache entry state
     std::string joinVectorString(const std::vector<FieldValueTuple> &fv);
-    void setCacheEntryState(std::vector<FieldValueTuple> &fvVector, cache_state_t state);
-    cache_state_t getCacheEntryState(const std::vector<FieldValueTuple> &fvVector);
 };
 
 }
@@ -0,0 +1,240 @@
+#include <stdexcept>
+
+#include "logger.h"
+#include "warmRestartCache.h"
+
+
+using namespace std;
+using namespace swss;
+
+
+namespace {
+
+const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+const uint64_t FNV_PRIME        = 0x100000001b3ULL;
+
+uint64_t fnv1a(const char *data, size_t len)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/* Finalizer from splitmix64, used to spread token hashes before summing them */
+uint64_t mix(uint64_t h)
+{
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+
+    return h;
+}
+
+}
+
+
+WarmStartCache::WarmStartCache(bool unorderedLists) :
+    m_unorderedLists(unorderedLists)
+{
+}
+
+
+void WarmStartCache::insert(const std::string                  &key,
+                            const std::vector<FieldValueTuple> &fvs,
+                            uint8_t                             state)
+{
+    Entry &entry = m_entries[key];
+
+    entry.state = state;
+    entry.fields.clear();
+    entry.fields.reserve(fvs.size());
+
+    for (const auto &fv : fvs)
+    {
+        entry.fields.emplace_back(internField(fvField(fv)), fingerprint(fvValue(fv)));
+    }
+
+    entry.fields.shrink_to_fit();
+}
+
+
+bool WarmStartCache::differs(const std::string                  &key,
+                             const std::vector<FieldValueTuple> &fvs) const
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+    {
+        return true;
+    }
+
+    const auto &fields = it->second.fields;
+
+    if (fields.size() != fvs.size())
+    {
+        return true;
+    }
+
+    for (const auto &fv : fvs)
+    {
+        FieldId id;
+
+        if (!lookupField(fvField(fv), id))
+        {
+            return true;
+        }
+
+        bool matched = false;
+
+        /* Entries only hold a handful of fields, linear search is the cheapest option */
+        for (const auto &field : fields)
+        {
+            if (field.first == id)
+            {
+                matched = (field.second == fingerprint(fvValue(fv)));
+                break;
+            }
+        }
+
+        if (!matched)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+bool WarmStartCache::setState(const std::string &key, uint8_t state)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+    {
+        return false;
+    }
+
+    it->second.state = state;
+
+    return true;
+}
+
+
+size_t WarmStartCache::memoryUsage(void) const
+{
+    /* Per-node overhead of std::unordered_map: next pointer plus cached hash */
+    const size_t nodeOverhead = 2 * sizeof(void *);
+
+    size_t bytes = m_entries.bucket_count() * sizeof(void *);
+
+    for (const auto &entry : m_entries)
+    {
+        bytes += nodeOverhead + sizeof(entry);
+
+        if (entry.first.capacity() >= sizeof(std::string))
+        {
+            bytes += entry.first.capacity() + 1;
+        }
+
+        bytes += entry.second.fields.capacity() * sizeof(entry.second.fields[0]);
+    }
+
+    for (const auto &name : m_fieldNames)
+    {
+        bytes += sizeof(name) + name.capacity() + 1;
+    }
+
+    return bytes;
+}
+
+
+void WarmStartCache::clear(void)
+{
+    /* Swap with empty containers so that bucket arrays are actually released */
+    unordered_map<string, Entry>().swap(m_entries);
+    unordered_map<string, FieldId>().swap(m_fieldIds);
+    vector<string>().swap(m_fieldNames);
+}
+
+
+WarmStartCache::FieldId WarmStartCache::internField(const std::string &field)
+{
+    auto it = m_fieldIds.find(field);
+    if (it != m_fieldIds.end())
+    {
+        return it->second;
+    }
+
+    if (m_fieldNames.size() > UINT16_MAX)
+    {
+        throw runtime_error("Too many distinct fields in warm-restart cache");
+    }
+
+    FieldId id = static_cast<FieldId>(m_fieldNames.size());
+
+    m_fieldNames.push_back(field);
+    m_fieldIds.emplace(field, id);
+
+    return id;
+}
+
+
+bool WarmStartCache::lookupField(const std::string &field, FieldId &id) const
+{
+    auto it = m_fieldIds.find(field);
+    if (it == m_fieldIds.end())
+    {
+        return false;
+    }
+
+    id = it->second;
+
+    return true;
+}
+
+
+/*
+ * Compute the fingerprint of a single value.
+ *
+ * For unordered lists every comma-separated element is hashed on its own and
+ * the (mixed) element hashes are summed up, which makes the result independent
+ * of the elements' order while still distinguishing repeated elements:
+ *
+ *    fingerprint("10.1.1.1,10.1.1.2") == fingerprint("10.1.1.2,10.1.1.1")
+ */
+uint64_t WarmStartCache::fingerprint(const std::string &value) const
+{
+    if (!m_unorderedLists)
+    {
+        return fnv1a(value.data(), value.size());
+    }
+
+    uint64_t sum = 0;
+    uint64_t elements = 0;
+    size_t pos = 0;
+
+    while (true)
+    {
+        size_t comma = value.find(',', pos);
+        size_t len = (comma == string::npos ? value.size() : comma) - pos;
+
+        sum += mix(fnv1a(value.data() + pos, len));
+        elements++;
+
+        if (comma == string::npos)
+        {
+            break;
+        }
+
+        pos = comma + 1;
+    }
+
+    return sum ^ mix(elements);
+}
@@ -0,0 +1,92 @@
+#ifndef __WARMRESTART_CACHE__
+#define __WARMRESTART_CACHE__
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "table.h"
+
+
+namespace swss {
+
+/*
+ * Compact cache holding the state restored from AppDB during warm-restart.
+ *
+ * Restored entries are only ever used to figure out whether the state
+ * regenerated by the restarting application differs from the old one, so
+ * there's no need to keep full copies of every field-value. Field names are
+ * interned into small integer ids (the same handful of fields repeat across
+ * all entries of a table) and values are reduced to 64-bit fingerprints.
+ *
+ * When 'unorderedLists' is set, values are treated as comma-separated lists
+ * whose element order is irrelevant (e.g. "10.1.1.1,10.1.1.2" matches
+ * "10.1.1.2,10.1.1.1"), which is the comparison semantic fpmsyncd relies on.
+ *
+ * Every entry also carries a small application-defined state (e.g. STALE,
+ * SAME, DELETE) so that callers don't need a parallel map to track refreshes.
+ */
+class WarmStartCache
+{
+public:
+    explicit WarmStartCache(bool unorderedLists = false);
+
+    void insert(const std::string                  &key,
+                const std::vector<FieldValueTuple> &fvs,
+                uint8_t                             state = 0);
+
+    bool contains(const std::string &key) const
+    {
+        return m_entries.find(key) != m_entries.end();
+    }
+
+    /*
+     * Returns 'true' if 'fvs' doesn't fully match the cached entry (or the
+     * entry is not cached at all).
+     */
+    bool differs(const std::string &key, const std::vector<FieldValueTuple> &fvs) const;
+
+    /* Returns 'false' if the entry is not cached */
+    bool setState(const std::string &key, uint8_t state);
+
+    template <typename F>
+    void forEach(F func) const
+    {
+        for (const auto &entry : m_entries)
+        {
+            func(entry.first, entry.second.state);
+        }
+    }
+
+    size_t size(void) const
+    {
+        return m_entries.size();
+    }
+
+    /* Approximate heap footprint of the cache (in bytes) */
+    size_t memoryUsage(void) const;
+
+    void clear(void);
+
+private:
+    using FieldId = uint16_t;
+
+    struct Entry
+    {
+        std::vector<std::pair<FieldId, uint64_t>> fields; // interned field-id, value fingerprint
+        uint8_t                                   state;
+    };
+
+    FieldId internField(const std::string &field);
+    bool lookupField(const std::string &field, FieldId &id) const;
+    uint64_t fingerprint(const std::string &value) const;
+
+    bool                                     m_unorderedLists;
+    std::unordered_map<std::string, Entry>   m_entries;
+    std::unordered_map<std::string, FieldId> m_fieldIds;
+    std::vector<std::string>                 m_fieldNames;
+};
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include <sstream>
 
 #include "warmRestartHelper.h"
+#include "warmRestartLoader.h"
 
 
 using namespace swss;
@@ -12,8 +13,10 @@ WarmStartHelper::WarmStartHelper(RedisPipeline      *pipeline,
                                  const std::string  &syncTableName,
                                  const std::string  &dockerName,
                                  const std::string  &appName) :
-    m_restorationTable(pipeline, syncTableName, false),
+    m_pipeline(pipeline),
     m_syncTable(syncTable),
+    m_restorationTable(pipeline, syncTableName, false),
+    m_restorationCache(true),
     m_syncTableName(syncTableName),
     m_dockName(dockerName),
     m_appName(appName)
@@ -65,7 +68,7 @@ bool WarmStartHelper::checkAndStart(void)
     }
 
     /* Cleaning state from previous (unsuccessful) warm-restart attempts */
-    m_restorationVector.clear();
+    m_restorationCache.clear();
     m_refreshMap.clear();
 
     /* Keeping track of warm-reboot active/inactive state */
@@ -98,19 +101,38 @@ uint32_t WarmStartHelper::getRestartTimer(void) const
  * are expected to call this method to upload their associated redisDB state into
  * a temporary buffer, which will eventually serve to resolve any conflict between
  * 'old' and 'new' state.
+ *
+ * AppDB state is streamed through a SCAN-based loader straight into a compact
+ * cache (interned fields, fingerprinted values), so neither a full copy of the
+ * table nor a round trip per entry is needed.
  */
 bool WarmStartHelper::runRestoration()
 {
     SWSS_LOG_NOTICE("Warm-Restart: Initiating AppDB restoration process for %s "
                     "application.", m_appName.c_str());
 
-    m_restorationTable.getContent(m_restorationVector);
+    /* Loader talks to redis directly, so nothing can be left in the pipeline */
+    m_pipeline->flush();
+
+    AppTableLoader loader(m_pipeline->getDBConnector(),
+                          m_restorationTable.getTableName(),
+                          m_restorationTable.getTableNameSeparator());
+
+    loader.load([this](const std::string &key, const std::vector<FieldValueTuple> &fvs)
+    {
+        m_restorationCache.insert(key, fvs);
+    });
+
+    AppTableLoader::publishRestoreStats(m_appName,
+                                        m_restorationCache.size(),
+                                        loader.getLoadTime(),
+                                        m_restorationCache.memoryUsage());
 
     /*
      * If there's no AppDB state to restore, then alert callee right away to avoid
      * iterating through the 'reconciliation' process.
      */
-    if (!m_restorationVector.size())
+    if (!m_restorationCache.size())
     {
         SWSS_LOG_NOTICE("Warm-Restart: No records received from AppDB for %s "
                         "application.", m_appName.c_str());
@@ -121,9 +143,11 @@ bool WarmStartHelper::runRestoration()
     }
 
     SWSS_LOG_NOTICE("Warm-Restart: Received %zu records from AppDB for %s "
-                    "application.",
-                    m_restorationVector.size(),
-                    m_appName.c_str());
+                    "application in %lu ms (%zu bytes cached).",
+                    m_restorationCache.size(),
+                    m_appName.c_str(),
+                    loader.getLoadTime(),
+                    m_restorationCache.memoryUsage());
 
     setState(WarmStart::RESTORED);
 
@@ -156,11 +180,8 @@ void WarmStartHelper::reconcile(void)
 
     assert(getState() == WarmStart::RESTORED);
 
-    for (auto &restoredElem : m_restorationVector)
+    m_restorationCache.forEach([this](const std::string &restoredKey, uint8_t)
     {
-        std::string restoredKey  = kfvKey(restoredElem);
-        auto restoredFV          = kfvFieldsValues(restoredElem);
-
         auto iter = m_refreshMap.find(restoredKey);
 
         /*
@@ -170,10 +191,10 @@ void WarmStartHelper::reconcile(void)
         if (iter == m_refreshMap.end())
         {
             SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting stale entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
+                            restoredKey.c_str());
 
             m_syncTable->del(restoredKey);
-            continue;
+            return;
         }
 
         /*
@@ -183,7 +204,7 @@ void WarmStartHelper::reconcile(void)
         else if (kfvOp(iter->second) == DEL_COMMAND)
         {
             SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
+                            restoredKey.c_str());
 
             m_syncTable->del(restoredKey);
         }
@@ -197,7 +218,7 @@ void WarmStartHelper::reconcile(void)
             auto refreshedKey = kfvKey(iter->second);
             auto refreshedFV  = kfvFieldsValues(iter->second);
 
-            if (compareAllFV(restoredFV, refreshedFV))
+            if (m_restorationCache.differs(restoredKey, refreshedFV))
             {
                 SWSS_LOG_NOTICE("Warm-Restart reconciliation: updating entry %s",
                                 printKFV(refreshedKey, refreshedFV).c_str());
@@ -213,8 +234,8 @@ void WarmStartHelper::reconcile(void)
         }
 
         /* Deleting the just-processed restored entry from the refreshMap */
-        m_refreshMap.erase(restoredKey);
-    }
+        m_refreshMap.erase(iter);
+    });
 
     /*
      * Iterate through all the entries left in the refreshMap, which correspond
@@ -250,8 +271,8 @@ void WarmStartHelper::reconcile(void)
     /* Clearing pending kfv's from refreshMap */
     m_refreshMap.clear();
 
-    /* Clearing restoration vector */
-    m_restorationVector.clear();
+    /* Releasing restoration cache */
+    m_restorationCache.clear();
 
     setState(WarmStart::RECONCILED);
 
@@ -260,94 +281,6 @@ void WarmStartHelper::reconcile(void)
 }
 
 
-/*
- * Compare all field-value-tuples within two vectors.
- *
- * Example: v1 {nexthop: 10.1.1.1, ifname: eth1}
- *          v2 {nexthop: 10.1.1.2, ifname: eth2}
- *
- * Returns:
- *
- *    'false' : If the content of both 'fields' and 'values' fully match
- *    'true'  : No full-match is found
- */
-bool WarmStartHelper::compareAllFV(const std::vector<FieldValueTuple> &v1,
-                                   const std::vector<FieldValueTuple> &v2)
-{
-    std::unordered_map<std::string, std::string> v1Map((v1.begin()), v1.end());
-
-     /* Iterate though all v2 tuples to check if their content match v1 ones */
-    for (auto &v2fv : v2)
-    {
-        auto v1Iter = v1Map.find(v2fv.first);
-        /*
-         * The sizes of both tuple-vectors should always match within any
-         * given application. In other words, all fields within v1 should be
-         * also present in v2.
-         *
-         * To make this possible, every application should continue relying on a
-         * uniform schema to create/generate information. For example, fpmsyncd
-         * will be always expected to push FieldValueTuples with "nexthop" and
-         * "ifname" fields; neighsyncd is expected to make use of "family" and
-         * "neigh" fields, etc. The existing reconciliation logic will rely on
-         * this assumption.
-         */
-        assert(v1Iter != v1Map.end());
-
-        if (compareOneFV(v1Map[fvField(*v1Iter)], fvValue(v2fv)))
-        {
-            return true;
-        }
-    }
-
-    return false;
-}
-
-
-/*
- * Compare the values of a single field-value within two different KFVs.
- *
- * Example: s1 {nexthop: 10.1.1.1, 10.1.1.2}
- *          s2 {nexthop: 10.1.1.2, 10.1.1.1}
- *
- * Example: s1 {Ethernet1, Ethernet2}
- *          s2 {Ethernet2, Ethernet1}
- *
- * Returns:
- *
- *    'false' : If the content of both strings fully matches
- *    'true'  : No full-match is found
- */
-bool WarmStartHelper::compareOneFV(const std::string &s1, const std::string &s2)
-{
-    if (s1.size() != s2.size())
-    {
-        return true;
-    }
-
-    std::vector<std::string> splitValuesS1 = tokenize(s1, ',');
-    std::vector<std::string> splitValuesS2 = tokenize(s2, ',');
-
-    if (splitValuesS1.size() != splitValuesS2.size())
-    {
-        return true;
-    }
-
-    std::sort(splitValuesS1.begin(), splitValuesS1.end());
-    std::sort(splitValuesS2.begin(), splitValuesS2.end());
-
-    for (size_t i = 0; i < splitValuesS1.size(); i++)
-    {
-        if (splitValuesS1[i] != splitValuesS2[i])
-        {
-            return true;
-        }
-    }
-
-    return false;
-}
-
-
 /*
  * Helper method to print KFVs in a friendly fashion.
  *
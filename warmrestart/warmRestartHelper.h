@@ -13,6 +13,7 @@
 #include "table.h"
 #include "tokenize.h"
 #include "warm_restart.h"
+#include "warmRestartCache.h"
 
 
 namespace swss {
@@ -29,9 +30,6 @@ class WarmStartHelper {
 
     ~WarmStartHelper();
 
-    /* fvVector type to be used to host AppDB restored elements */
-    using kfvVector = std::vector<KeyOpFieldsValuesTuple>;
-
     /*
      * kfvMap type to be utilized to store all the new/refresh state coming
      * from the restarting applications.
@@ -61,14 +59,10 @@ class WarmStartHelper {
 
   private:
 
-    bool compareAllFV(const std::vector<FieldValueTuple> &left,
-                      const std::vector<FieldValueTuple> &right);
-
-    bool compareOneFV(const std::string &v1, const std::string &v2);
-
+    RedisPipeline            *m_pipeline;          // pipeline shared with producer-table
     ProducerStateTable       *m_syncTable;         // producer-table to sync/push state to
     Table                     m_restorationTable;  // redis table to import current-state from
-    kfvVector                 m_restorationVector; // buffer struct to hold old state
+    WarmStartCache            m_restorationCache;  // compact cache to hold old state
     kfvMap                    m_refreshMap;        // buffer struct to hold new state
     WarmStart::WarmStartState m_state;             // cached value of warmStart's FSM state
     bool                      m_enabled;           // warm-reboot enabled/disabled status
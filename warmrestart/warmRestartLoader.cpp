@@ -0,0 +1,145 @@
+#include <chrono>
+#include <stdexcept>
+#include <hiredis/hiredis.h>
+
+#include "logger.h"
+#include "schema.h"
+#include "redisreply.h"
+#include "rediscommand.h"
+#include "warmRestartLoader.h"
+
+
+using namespace std;
+using namespace swss;
+
+
+AppTableLoader::AppTableLoader(DBConnector       *db,
+                               const std::string &tableName,
+                               const std::string &tableSeparator,
+                               size_t             batchSize) :
+    m_db(db),
+    m_keyPrefix(tableName + tableSeparator),
+    m_batchSize(batchSize),
+    m_loadTime(0)
+{
+}
+
+
+size_t AppTableLoader::load(const EntryHandler &handler)
+{
+    SWSS_LOG_ENTER();
+
+    auto start = chrono::steady_clock::now();
+
+    string cursor = "0";
+    string pattern = m_keyPrefix + "*";
+    size_t count = 0;
+
+    do
+    {
+        RedisCommand scan;
+        scan.format("SCAN %s MATCH %s COUNT %d",
+                    cursor.c_str(), pattern.c_str(), (int)m_batchSize);
+
+        RedisReply r(m_db, scan, REDIS_REPLY_ARRAY);
+        redisReply *reply = r.getContext();
+
+        if (reply->elements != 2)
+        {
+            throw runtime_error("Unexpected SCAN reply while loading " + m_keyPrefix);
+        }
+
+        cursor = reply->element[0]->str;
+
+        redisReply *keysReply = reply->element[1];
+        vector<string> keys;
+        keys.reserve(keysReply->elements);
+
+        for (size_t i = 0; i < keysReply->elements; i++)
+        {
+            keys.emplace_back(keysReply->element[i]->str, keysReply->element[i]->len);
+        }
+
+        count += loadBatch(keys, handler);
+    }
+    while (cursor != "0");
+
+    m_loadTime = chrono::duration_cast<chrono::milliseconds>(
+            chrono::steady_clock::now() - start).count();
+
+    SWSS_LOG_NOTICE("Loaded %zu entries from %s* in %lu ms",
+                    count, m_keyPrefix.c_str(), m_loadTime);
+
+    return count;
+}
+
+
+/*
+ * Pipelines one HGETALL per key and then drains all the replies, so a whole
+ * SCAN batch costs a single round trip.
+ */
+size_t AppTableLoader::loadBatch(const vector<string> &keys,
+                                 const EntryHandler   &handler)
+{
+    redisContext *ctx = m_db->getContext();
+
+    for (const auto &key : keys)
+    {
+        if (redisAppendCommand(ctx, "HGETALL %b", key.c_str(), key.size()) != REDIS_OK)
+        {
+            throw runtime_error("Failed to queue HGETALL for " + key);
+        }
+    }
+
+    size_t count = 0;
+    vector<FieldValueTuple> fvs;
+
+    for (const auto &key : keys)
+    {
+        redisReply *raw = nullptr;
+
+        if (redisGetReply(ctx, reinterpret_cast<void **>(&raw)) != REDIS_OK)
+        {
+            throw runtime_error("Failed to read HGETALL reply for " + key);
+        }
+
+        RedisReply r(raw);
+        r.checkReplyType(REDIS_REPLY_ARRAY);
+
+        /* Key vanished between SCAN and HGETALL */
+        if (raw->elements == 0)
+        {
+            continue;
+        }
+
+        fvs.clear();
+        for (size_t i = 0; i + 1 < raw->elements; i += 2)
+        {
+            fvs.emplace_back(string(raw->element[i]->str, raw->element[i]->len),
+                             string(raw->element[i + 1]->str, raw->element[i + 1]->len));
+        }
+
+        handler(key.substr(m_keyPrefix.size()), fvs);
+        count++;
+    }
+
+    return count;
+}
+
+
+void AppTableLoader::publishRestoreStats(const std::string &appName,
+                                         size_t             entries,
+                                         uint64_t           loadTime,
+                                         size_t             memoryUsage)
+{
+    DBConnector stateDb(STATE_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
+    Table warmRestartTable(&stateDb, STATE_WARM_RESTART_TABLE_NAME);
+
+    vector<FieldValueTuple> fvs = {
+        { "restored_entries",    to_string(entries) },
+        { "restore_time_ms",     to_string(loadTime) },
+        { "restore_cache_bytes", to_string(memoryUsage) }
+    };
+
+    warmRestartTable.set(appName, fvs);
+}
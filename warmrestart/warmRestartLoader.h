@@ -0,0 +1,73 @@
+#ifndef __WARMRESTART_LOADER__
+#define __WARMRESTART_LOADER__
+
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "dbconnector.h"
+#include "table.h"
+
+
+namespace swss {
+
+/*
+ * Streaming loader for redis-backed application tables.
+ *
+ * Instead of fetching the whole table in one shot (KEYS + one HGETALL round
+ * trip per key), the loader walks the table with SCAN and fetches every SCAN
+ * batch with a single pipelined burst of HGETALL commands. Entries are handed
+ * to the caller one at a time, so at any given point only one batch worth of
+ * field-value tuples is held in memory by the loader itself.
+ *
+ * Notice that SCAN may return the same key more than once, so handlers are
+ * expected to be idempotent (i.e. overwrite rather than append).
+ *
+ * The loader issues raw commands over the DBConnector's redis context, so any
+ * RedisPipeline sharing that connector must be flushed before load() is
+ * invoked.
+ */
+class AppTableLoader
+{
+public:
+    using EntryHandler = std::function<void(const std::string &key,
+                                            const std::vector<FieldValueTuple> &fvs)>;
+
+    static const size_t DEFAULT_BATCH_SIZE = 1000;
+
+    AppTableLoader(DBConnector       *db,
+                   const std::string &tableName,
+                   const std::string &tableSeparator,
+                   size_t             batchSize = DEFAULT_BATCH_SIZE);
+
+    /* Streams all table entries into 'handler'. Returns the number of entries */
+    size_t load(const EntryHandler &handler);
+
+    /* Milliseconds spent in the last load() call */
+    uint64_t getLoadTime(void) const
+    {
+        return m_loadTime;
+    }
+
+    /*
+     * Publishes the outcome of a restoration cycle into the application's
+     * STATE_DB WARM_RESTART_TABLE entry.
+     */
+    static void publishRestoreStats(const std::string &appName,
+                                    size_t             entries,
+                                    uint64_t           loadTime,
+                                    size_t             memoryUsage);
+
+private:
+    size_t loadBatch(const std::vector<std::string> &keys,
+                     const EntryHandler             &handler);
+
+    DBConnector *m_db;
+    std::string  m_keyPrefix;   // "<table-name><separator>"
+    size_t       m_batchSize;
+    uint64_t     m_loadTime;
+};
+
+}
+
+#endif